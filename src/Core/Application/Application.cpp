@@ -48,6 +48,7 @@
 #include "Utilities/FileSystem/FileManager.h"
 #include "Utilities/Json/Json.h"
 #include "Utilities/Format/Format.h"
+#include "Utilities/Memory/SmallObjectAllocator.h"
 
 // components
 #include "Core/Components/Components.h"
@@ -59,7 +60,8 @@ namespace MxEngine
 {
 	Application::Application()
 		: manager(this), window(MakeUnique<Window>(1600, 900, "MxEngine Application")), 
-		  dispatcher(Alloc<EventDispatcherImpl<EventBase>>()), editor(Alloc<RuntimeEditor>())
+		  dispatcher(Alloc<EventDispatcherImpl<EventBase>>()), editor(Alloc<RuntimeEditor>()),
+		  jobSystem(Alloc<JobSystemImpl>()), assetLoader(Alloc<AsyncAssetLoaderImpl>())
 	{
 		this->CreateContext();
 	}
@@ -125,6 +127,21 @@ namespace MxEngine
 		return *this->dispatcher;
 	}
 
+	JobSystemImpl& Application::GetJobSystem()
+	{
+		return *this->jobSystem;
+	}
+
+	AsyncAssetLoaderImpl& Application::GetAssetLoader()
+	{
+		return *this->assetLoader;
+	}
+
+	TransformHierarchy& Application::GetTransformHierarchy()
+	{
+		return this->hierarchy;
+	}
+
 	RenderAdaptor& Application::GetRenderAdaptor()
 	{
 		return this->renderAdaptor;
@@ -156,6 +173,7 @@ namespace MxEngine
 	void Application::DrawObjects()
 	{
 		MAKE_SCOPE_PROFILER("Application::DrawObjects");
+		MemoryTagScope memoryTag(MemoryTag::RENDER);
 		this->GetRenderAdaptor().SetWindowSize({ this->GetWindow().GetWidth(), this->GetWindow().GetHeight() });
 		this->GetRenderAdaptor().RenderFrame();
 
@@ -191,17 +209,15 @@ namespace MxEngine
 		// update runtime editor
 		this->GetRuntimeEditor().OnUpdate();
 
+		// propagate transforms of parents to attached objects before components read world transforms.
+		// Editor can move objects even if application is paused
+		this->hierarchy.Update(this->GetJobSystem());
+
 		// do not update components or call update callbacks if application is paused
 		if (!IsPaused)
 		{
 			// invoke all components waiting for updates
-			{
-				MAKE_SCOPE_PROFILER("Application::UpdateComponents");
-				for (const auto& callback : this->updateCallbacks)
-				{
-					callback(this->timeDelta);
-				}
-			}
+			this->UpdateComponents();
 
 			// invoke update event
 			UpdateEvent updateEvent(this->timeDelta);
@@ -215,8 +231,88 @@ namespace MxEngine
 		}
 	}
 
+	void Application::UpdateComponents()
+	{
+		MAKE_SCOPE_PROFILER("Application::UpdateComponents");
+		if (this->isUpdateScheduleDirty) this->ScheduleComponentUpdates();
+
+		// components with default policy are updated on main thread in order of their registration. They may move objects
+		// and run user scripts, so independent updates start only after them and see final transforms of the frame
+		for (const auto& entry : this->updateCallbacks)
+		{
+			if (!entry.IsIndependent) entry.Update(this->timeDelta);
+		}
+
+		auto& jobSystem = this->GetJobSystem();
+		for (size_t wave = 0; wave < this->updateWaveCount; wave++)
+		{
+			// independent component types are updated by worker threads
+			JobCounter counter;
+			for (const auto& entry : this->updateCallbacks)
+			{
+				if (entry.IsIndependent && entry.Wave == wave)
+				{
+					jobSystem.Execute([update = entry.Update, dt = this->timeDelta]() { update(dt); }, &counter);
+				}
+			}
+			jobSystem.Wait(counter);
+		}
+	}
+
+	void Application::AddComponentUpdate(ComponentUpdateEntry entry)
+	{
+		this->updateCallbacks.push_back(std::move(entry));
+		this->isUpdateScheduleDirty = true;
+	}
+
+	void Application::ScheduleComponentUpdates()
+	{
+		// wave of independent update is the first one after all its dependencies are finished. Main thread updates are finished before wave 0
+		constexpr size_t NotVisited = std::numeric_limits<size_t>::max();
+		constexpr size_t InProgress = NotVisited - 1;
+		for (auto& entry : this->updateCallbacks)
+			entry.Wave = entry.IsIndependent ? NotVisited : 0;
+
+		auto computeWave = [this](size_t index, auto& self) -> size_t
+		{
+			auto& entry = this->updateCallbacks[index];
+			if (!entry.IsIndependent || entry.Wave != NotVisited)
+			{
+				if (entry.Wave == InProgress)
+				{
+					MXLOG_ERROR("MxEngine::Application", "cyclic dependency detected in component update policies");
+					return 0;
+				}
+				return entry.Wave;
+			}
+
+			entry.Wave = InProgress;
+			size_t wave = 0;
+			for (const auto& dependency : entry.Dependencies)
+			{
+				for (size_t i = 0; i < this->updateCallbacks.size(); i++)
+				{
+					const auto& other = this->updateCallbacks[i];
+					// main thread updates are already finished when any wave starts
+					if (other.ComponentId != dependency || !other.IsIndependent) continue;
+					wave = Max(wave, self(i, self) + 1);
+				}
+			}
+			entry.Wave = wave;
+			return wave;
+		};
+
+		this->updateWaveCount = 1;
+		for (size_t i = 0; i < this->updateCallbacks.size(); i++)
+		{
+			this->updateWaveCount = Max(this->updateWaveCount, computeWave(i, computeWave) + 1);
+		}
+		this->isUpdateScheduleDirty = false;
+	}
+
 	void Application::InvokePhysics()
 	{
+		MemoryTagScope memoryTag(MemoryTag::PHYSICS);
 		PhysicsModule::OnUpdate(this->timeDelta);
 
 		// TODO: refactor, move collision logic to separate function
@@ -269,6 +365,17 @@ namespace MxEngine
 		currentCollisions.clear();
 	}
 
+	void Application::ReleaseResources()
+	{
+		MAKE_SCOPE_PROFILER("Application::ReleaseResources()");
+		// objects are released first, as they own handles to other resources
+		MxObject::Factory::FlushReleased();
+		ResourceFactory::FlushReleased();
+		GraphicFactory::FlushReleased();
+		AudioFactory::FlushReleased();
+		PhysicsFactory::FlushReleased();
+	}
+
 	void Application::InvokeCreate()
 	{
 		MAKE_SCOPE_PROFILER("Application::OnCreate");
@@ -311,6 +418,8 @@ namespace MxEngine
 		MAKE_SCOPE_PROFILER("Application::CreateContext");
 
 		this->InitializeConfig(this->config);
+		this->GetJobSystem().Init(this->config.WorkerThreadCount);
+		this->GetAssetLoader().Init(this->config.AssetLoaderThreadCount);
 
 		this->GetWindow()
 			.UseEventDispatcher(this->dispatcher)
@@ -368,7 +477,9 @@ namespace MxEngine
 				MAKE_SCOPE_PROFILER("Application::Frame()");
 				this->UpdateTimeDelta(frameEnd, secondEnd, frameCount);
 				this->InvokeUpdate();
+				this->GetAssetLoader().Update(this->config.AssetUploadBudget);
 				this->DrawObjects();
+				this->ReleaseResources();
 				this->GetWindow().PullEvents();
 				if (this->shouldClose) break;
 			}
@@ -380,6 +491,8 @@ namespace MxEngine
 				AppDestroyEvent appDestroyEvent;
 				Event::Invoke(appDestroyEvent);
 				this->OnDestroy();
+				this->GetAssetLoader().Destroy();
+				this->ReleaseResources();
 				this->GetWindow().Close();
 				this->isRunning = false;
 			}
@@ -393,6 +506,8 @@ namespace MxEngine
 
 	Application::~Application()
 	{
+		Free(this->assetLoader);
+		Free(this->jobSystem);
 		MXLOG_INFO("MxEngine::Application", "application destroyed");
 	}
 
@@ -36,6 +36,9 @@
 #include "Core/Config/Config.h"
 #include "Utilities/Profiler/Profiler.h"
 #include "Platform/Window/Window.h"
+#include "Utilities/JobSystem/JobSystem.h"
+#include "Core/Resources/AsyncAssetLoader.h"
+#include "Core/Components/TransformHierarchy.h"
 
 GENERATE_METHOD_CHECK(OnUpdate, OnUpdate(float()));
 
@@ -51,7 +54,18 @@ namespace MxEngine
 			~ModuleManager();
 		} manager;
 
-		using UpdateCallbackList = MxVector<void(*)(TimeStep)>;
+		struct ComponentUpdateEntry
+		{
+			using UpdateFunction = void(*)(TimeStep);
+
+			UpdateFunction Update;
+			StringId ComponentId;
+			MxVector<StringId> Dependencies;
+			bool IsIndependent;
+			size_t Wave = 0;
+		};
+
+		using UpdateCallbackList = MxVector<ComponentUpdateEntry>;
 		using CollisionList = MxVector<std::pair<MxObject::Handle, MxObject::Handle>>;
 		using CollisionSwapPair = std::pair<CollisionList, CollisionList>;
 	private:
@@ -60,7 +74,12 @@ namespace MxEngine
 		RenderAdaptor renderAdaptor;
 		EventDispatcherImpl<EventBase>* dispatcher;
 		RuntimeEditor* editor;
+		JobSystemImpl* jobSystem;
+		AsyncAssetLoaderImpl* assetLoader;
+		TransformHierarchy hierarchy;
 		UpdateCallbackList updateCallbacks;
+		size_t updateWaveCount = 1;
+		bool isUpdateScheduleDirty = false;
 		CollisionSwapPair collisions;
 		Config config;
 		TimeStep timeDelta = 0.0f;
@@ -76,7 +95,11 @@ namespace MxEngine
 		void UpdateTimeDelta(TimeStep& lastFrameEnd, TimeStep& lastSecondEnd, size_t& framesPerSecond);
 		void DrawObjects();
 		void InvokeUpdate();
+		void UpdateComponents();
+		void ScheduleComponentUpdates();
+		void AddComponentUpdate(ComponentUpdateEntry entry);
 		void InvokePhysics();
+		void ReleaseResources();
 		void InvokeCreate();
 		void CreateContext();
 		bool VerifyApplicationState();
@@ -101,6 +124,9 @@ namespace MxEngine
 
 		void AddCollisionEntry(const MxObject::Handle& object1, const MxObject::Handle& object2);
 		EventDispatcherImpl<EventBase>& GetEventDispatcher();
+		JobSystemImpl& GetJobSystem();
+		AsyncAssetLoaderImpl& GetAssetLoader();
+		TransformHierarchy& GetTransformHierarchy();
 		RenderAdaptor& GetRenderAdaptor();
 		RuntimeEditor& GetRuntimeEditor();
 		Config& GetConfig();
@@ -120,20 +146,53 @@ namespace MxEngine
 		static void Clone(Application* application);
 	};
 	
+	template<typename... Components>
+	inline void CollectComponentIds(ComponentUpdateDependencies<Components...>, MxVector<StringId>& result)
+	{
+		(result.push_back(ComponentFactory::GetComponentId<Components>()), ...);
+	}
+
 	template<typename T>
 	inline void Application::RegisterComponentUpdate()
 	{
 		if constexpr (has_method_OnUpdate<T>::value)
 		{
-			this->updateCallbacks.push_back([](TimeStep dt)
+			using Policy = ComponentUpdatePolicy<T>;
+
+			ComponentUpdateEntry entry;
+			entry.ComponentId = ComponentFactory::GetComponentId<T>();
+			entry.IsIndependent = Policy::IsIndependent;
+			CollectComponentIds(typename Policy::Dependencies{ }, entry.Dependencies);
+
+			if constexpr (Policy::IsThreadSafe)
+			{
+				entry.Update = [](TimeStep dt)
+				{
+					MAKE_SCOPE_PROFILER(typeid(T).name());
+					auto& pool = ComponentFactory::Get<T>();
+					Application::GetImpl()->GetJobSystem().ParallelForRange(pool.Capacity(), Policy::ChunkSize, 
+						[&pool, dt](size_t begin, size_t end)
+						{
+							for (size_t i = pool.NextAllocated(begin); i < end; i = pool.NextAllocated(i + 1))
+							{
+								pool[i].value.OnUpdate(dt);
+							}
+						});
+				};
+			}
+			else
 			{
-				MAKE_SCOPE_PROFILER(typeid(T).name());
-				auto view = ComponentFactory::GetView<T>();
-				for (auto& component : view)
+				entry.Update = [](TimeStep dt)
 				{
-					component.OnUpdate(dt);
-				}
-			});
+					MAKE_SCOPE_PROFILER(typeid(T).name());
+					auto view = ComponentFactory::GetView<T>();
+					for (auto& component : view)
+					{
+						component.OnUpdate(dt);
+					}
+				};
+			}
+			this->AddComponentUpdate(std::move(entry));
 		}
 	}
 
@@ -41,11 +41,12 @@ namespace MxEngine
 		Note that multiple listeners may have same name. If so, deleting by name will result in removing all of them
 		\param name name of listener (used for deleting listener)
 		\param func listener callback functor
+		\returns unique id of listener
 		*/
 		template<typename EventType>
-		static void AddEventListener(const MxString& name, std::function<void(EventType&)> func)
+		static EventListenerId AddEventListener(const MxString& name, std::function<void(EventType&)> func)
 		{
-			Application::GetImpl()->GetEventDispatcher().AddEventListener(name, std::move(func));
+			return Application::GetImpl()->GetEventDispatcher().AddEventListener(name, std::move(func));
 		}
 
 		/*!
@@ -53,11 +54,21 @@ namespace MxEngine
 		Note that multiple listeners may have same name. If so, deleting by name will result in removing all of them
 		\param name name of listener (used for deleting listener)
 		\param func listener callback functor (should be with signature `void callback(EventType& e)`
+		\returns unique id of listener
 		*/
 		template<typename T, typename FunctionType>
-		static void AddEventListener(const MxString& name, FunctionType&& func)
+		static EventListenerId AddEventListener(const MxString& name, FunctionType&& func)
 		{
-			Application::GetImpl()->GetEventDispatcher().AddEventListener<T>(name, std::forward<FunctionType>(func));
+			return Application::GetImpl()->GetEventDispatcher().AddEventListener<T>(name, std::forward<FunctionType>(func));
+		}
+
+		/*!
+		removes event listener by its id (action is placed in waiting queue until next frame)
+		\param id id returned when listener was added
+		*/
+		static void RemoveEventListener(EventListenerId id)
+		{
+			Application::GetImpl()->GetEventDispatcher().RemoveEventListener(id);
 		}
 
 		/*!
@@ -80,7 +91,7 @@ namespace MxEngine
 		}
 
 		/*!
-		Adds event to event queue. All such events will be dispatched in next frames in the order they were added
+		Adds event to event queue. All such events will be dispatched in next frames in the order they were added. Can be called from any thread
 		\param event event to shedule dispatch
 		*/
 		static void AddEvent(UniqueRef<EventBase> event)
@@ -88,6 +99,16 @@ namespace MxEngine
 			Application::GetImpl()->GetEventDispatcher().AddEvent(std::move(event));
 		}
 
+		/*!
+		Constructs event and adds it to event queue. Event is stored inside dispatcher queue instead of heap. Can be called from any thread
+		\param args arguments for event constructor
+		*/
+		template<typename EventType, typename... Args>
+		static void AddEvent(Args&&... args)
+		{
+			Application::GetImpl()->GetEventDispatcher().template AddEvent<EventType>(std::forward<Args>(args)...);
+		}
+
 		/*!
 		Invokes all shedules events in the order they were added. Note that invoke also forces queues to be invalidated
 		*/
@@ -0,0 +1,91 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/Application/Application.h"
+#include "Core/Components/TransformHierarchy.h"
+
+namespace MxEngine
+{
+    class Hierarchy
+    {
+    public:
+        /*!
+        attaches object to parent, so it follows parent movement without any scripts. Local transform of child becomes relative to parent
+        \param child object to attach
+        \param parent new parent of object
+        \returns true if object was attached, false if parent is child itself or one of its descendants
+        */
+        static bool SetParent(const MxObject::Handle& child, const MxObject::Handle& parent)
+        {
+            return Application::GetImpl()->GetTransformHierarchy().SetParent(child, parent);
+        }
+
+        /*!
+        detaches object from its parent
+        \param child object to detach
+        */
+        static void RemoveParent(const MxObject::Handle& child)
+        {
+            Application::GetImpl()->GetTransformHierarchy().RemoveParent(child);
+        }
+
+        /*!
+        getter for object parent
+        \param child object which parent is requested
+        \returns parent handle or invalid handle if object is not attached
+        */
+        static MxObject::Handle GetParent(const MxObject& child)
+        {
+            return Application::GetImpl()->GetTransformHierarchy().GetParent(child);
+        }
+
+        /*!
+        collects direct children of object
+        \param parent object which children are requested
+        \returns vector of child handles
+        */
+        static MxVector<MxObject::Handle> GetChildren(const MxObject& parent)
+        {
+            MxVector<MxObject::Handle> children;
+            Application::GetImpl()->GetTransformHierarchy().GetChildren(parent, children);
+            return children;
+        }
+
+        /*!
+        getter for world matrix of object, including transforms of all its parents
+        \param object object which matrix is requested
+        \returns world matrix, computed at the end of last update
+        */
+        static const Matrix4x4& GetWorldMatrix(const MxObject& object)
+        {
+            return Application::GetImpl()->GetTransformHierarchy().GetWorldMatrix(object);
+        }
+    };
+}
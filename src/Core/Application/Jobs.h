@@ -0,0 +1,92 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/Application/Application.h"
+#include "Utilities/JobSystem/JobSystem.h"
+
+namespace MxEngine
+{
+    class Jobs
+    {
+    public:
+        /*!
+        schedules job for execution on any of worker threads
+        \param func functor to invoke
+        \param counter optional counter which can be used to wait for job completion
+        */
+        template<typename F>
+        static void Execute(F&& func, JobCounter* counter = nullptr)
+        {
+            Application::GetImpl()->GetJobSystem().Execute(std::forward<F>(func), counter);
+        }
+
+        /*!
+        blocks until all jobs attached to counter are finished. Calling thread helps to execute pending jobs
+        \param counter counter to wait on
+        */
+        static void Wait(const JobCounter& counter)
+        {
+            Application::GetImpl()->GetJobSystem().Wait(counter);
+        }
+
+        /*!
+        invokes functor for each index in range [0, count) in parallel and waits for completion
+        \param count number of elements in range
+        \param grainSize minimal number of elements processed by one job
+        \param func functor with signature `void(size_t index)`
+        */
+        template<typename F>
+        static void ParallelFor(size_t count, size_t grainSize, F&& func)
+        {
+            Application::GetImpl()->GetJobSystem().ParallelFor(count, grainSize, std::forward<F>(func));
+        }
+
+        /*!
+        splits range [0, count) into chunks and invokes functor for each chunk in parallel, waiting for completion
+        \param count number of elements in range
+        \param grainSize minimal number of elements processed by one job
+        \param func functor with signature `void(size_t begin, size_t end)`
+        */
+        template<typename F>
+        static void ParallelForRange(size_t count, size_t grainSize, F&& func)
+        {
+            Application::GetImpl()->GetJobSystem().ParallelForRange(count, grainSize, std::forward<F>(func));
+        }
+
+        /*!
+        getter for number of threads which execute jobs (including main thread)
+        \returns worker count
+        */
+        static size_t GetWorkerCount()
+        {
+            return Application::GetImpl()->GetJobSystem().GetWorkerCount();
+        }
+    };
+}
@@ -154,4 +154,32 @@ namespace MxEngine
     {
         DRW.Submit(circle, color);
     }
+
+    MxVector<MxObject::Handle> Rendering::QueryObjects(const AABB& box)
+    {
+        MxVector<MxObject::Handle> result;
+        Rendering::GetController().GetRenderScene().QueryObjects(box, result);
+        return result;
+    }
+
+    MxVector<MxObject::Handle> Rendering::QueryObjects(const BoundingSphere& sphere)
+    {
+        MxVector<MxObject::Handle> result;
+        Rendering::GetController().GetRenderScene().QueryObjects(sphere, result);
+        return result;
+    }
+
+    MxVector<MxObject::Handle> Rendering::QueryObjects(const FrustrumCuller& culler)
+    {
+        MxVector<MxObject::Handle> result;
+        Rendering::GetController().GetRenderScene().QueryObjects(culler, result);
+        return result;
+    }
+
+    MxVector<MxObject::Handle> Rendering::RayCast(const Vector3& from, const Vector3& to)
+    {
+        MxVector<MxObject::Handle> result;
+        Rendering::GetController().GetRenderScene().RayCast(from, to, result);
+        return result;
+    }
 }
\ No newline at end of file
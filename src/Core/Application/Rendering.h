@@ -63,5 +63,9 @@ namespace MxEngine
         static void Draw(const Cylinder& cylinder, const Vector4& color);
         static void Draw(const Rectangle& rectangle, const Vector4& color);
         static void Draw(const Circle& circle, const Vector4& color);
+        static MxVector<MxObject::Handle> QueryObjects(const AABB& box);
+        static MxVector<MxObject::Handle> QueryObjects(const BoundingSphere& sphere);
+        static MxVector<MxObject::Handle> QueryObjects(const FrustrumCuller& culler);
+        static MxVector<MxObject::Handle> RayCast(const Vector3& from, const Vector3& to);
 	};
 }
\ No newline at end of file
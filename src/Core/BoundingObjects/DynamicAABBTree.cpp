@@ -0,0 +1,306 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "DynamicAABBTree.h"
+
+namespace MxEngine
+{
+    AABB Union(const AABB& box1, const AABB& box2)
+    {
+        return AABB{ VectorMin(box1.Min, box2.Min), VectorMax(box1.Max, box2.Max) };
+    }
+
+    float SurfaceArea(const AABB& box)
+    {
+        Vector3 size = box.Length();
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    bool Contains(const AABB& outer, const AABB& inner)
+    {
+        return outer.Min.x <= inner.Min.x && outer.Min.y <= inner.Min.y && outer.Min.z <= inner.Min.z &&
+               outer.Max.x >= inner.Max.x && outer.Max.y >= inner.Max.y && outer.Max.z >= inner.Max.z;
+    }
+
+    DynamicAABBTree::DynamicAABBTree(float margin)
+        : margin(margin)
+    {
+
+    }
+
+    size_t DynamicAABBTree::AllocateNode()
+    {
+        if (this->freeList == InvalidProxy)
+        {
+            this->nodes.emplace_back();
+            return this->nodes.size() - 1;
+        }
+
+        size_t index = this->freeList;
+        this->freeList = this->nodes[index].Parent;
+        this->nodes[index] = Node{ };
+        return index;
+    }
+
+    void DynamicAABBTree::FreeNode(size_t index)
+    {
+        auto& node = this->nodes[index];
+        node.Parent = this->freeList;
+        node.Height = -1;
+        this->freeList = index;
+    }
+
+    size_t DynamicAABBTree::Insert(const AABB& box, size_t userData)
+    {
+        size_t leaf = this->AllocateNode();
+        auto& node = this->nodes[leaf];
+        node.Box = AABB{ box.Min - MakeVector3(this->margin), box.Max + MakeVector3(this->margin) };
+        node.UserData = userData;
+        node.Height = 0;
+
+        this->InsertLeaf(leaf);
+        this->proxyCount++;
+        return leaf;
+    }
+
+    void DynamicAABBTree::Remove(size_t proxy)
+    {
+        MX_ASSERT(proxy < this->nodes.size() && this->nodes[proxy].IsLeaf() && this->nodes[proxy].Height == 0);
+        this->RemoveLeaf(proxy);
+        this->FreeNode(proxy);
+        this->proxyCount--;
+    }
+
+    bool DynamicAABBTree::Move(size_t proxy, const AABB& box)
+    {
+        MX_ASSERT(proxy < this->nodes.size() && this->nodes[proxy].IsLeaf() && this->nodes[proxy].Height == 0);
+        if (Contains(this->nodes[proxy].Box, box)) return false;
+
+        this->RemoveLeaf(proxy);
+        this->nodes[proxy].Box = AABB{ box.Min - MakeVector3(this->margin), box.Max + MakeVector3(this->margin) };
+        this->InsertLeaf(proxy);
+        return true;
+    }
+
+    void DynamicAABBTree::Clear()
+    {
+        this->nodes.clear();
+        this->root = InvalidProxy;
+        this->freeList = InvalidProxy;
+        this->proxyCount = 0;
+    }
+
+    const AABB& DynamicAABBTree::GetEnlargedAABB(size_t proxy) const
+    {
+        return this->nodes[proxy].Box;
+    }
+
+    size_t DynamicAABBTree::GetUserData(size_t proxy) const
+    {
+        return this->nodes[proxy].UserData;
+    }
+
+    size_t DynamicAABBTree::GetProxyCount() const
+    {
+        return this->proxyCount;
+    }
+
+    size_t DynamicAABBTree::GetHeight() const
+    {
+        return this->root == InvalidProxy ? 0 : size_t(this->nodes[this->root].Height + 1);
+    }
+
+    void DynamicAABBTree::InsertLeaf(size_t leaf)
+    {
+        if (this->root == InvalidProxy)
+        {
+            this->root = leaf;
+            this->nodes[leaf].Parent = InvalidProxy;
+            return;
+        }
+
+        // find best sibling: descend while creating new parent here costs more than pushing leaf further into children
+        AABB leafBox = this->nodes[leaf].Box;
+        size_t index = this->root;
+        while (!this->nodes[index].IsLeaf())
+        {
+            const auto& node = this->nodes[index];
+            float area = SurfaceArea(node.Box);
+            float combinedArea = SurfaceArea(Union(node.Box, leafBox));
+
+            float cost = 2.0f * combinedArea;
+            float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto ChildCost = [this, &leafBox, inheritanceCost](size_t child)
+            {
+                const auto& childNode = this->nodes[child];
+                float newArea = SurfaceArea(Union(childNode.Box, leafBox));
+                if (childNode.IsLeaf()) return newArea + inheritanceCost;
+                return newArea - SurfaceArea(childNode.Box) + inheritanceCost;
+            };
+
+            float leftCost = ChildCost(node.Left);
+            float rightCost = ChildCost(node.Right);
+
+            if (cost < leftCost && cost < rightCost) break;
+            index = leftCost < rightCost ? node.Left : node.Right;
+        }
+
+        size_t sibling = index;
+        size_t oldParent = this->nodes[sibling].Parent;
+        size_t newParent = this->AllocateNode();
+
+        auto& parentNode = this->nodes[newParent];
+        parentNode.Parent = oldParent;
+        parentNode.Box = Union(leafBox, this->nodes[sibling].Box);
+        parentNode.Height = this->nodes[sibling].Height + 1;
+        parentNode.Left = sibling;
+        parentNode.Right = leaf;
+
+        if (oldParent != InvalidProxy)
+        {
+            auto& oldParentNode = this->nodes[oldParent];
+            if (oldParentNode.Left == sibling) oldParentNode.Left = newParent;
+            else oldParentNode.Right = newParent;
+        }
+        else
+        {
+            this->root = newParent;
+        }
+        this->nodes[sibling].Parent = newParent;
+        this->nodes[leaf].Parent = newParent;
+
+        this->RefitAncestors(this->nodes[leaf].Parent);
+    }
+
+    void DynamicAABBTree::RemoveLeaf(size_t leaf)
+    {
+        if (leaf == this->root)
+        {
+            this->root = InvalidProxy;
+            return;
+        }
+
+        size_t parent = this->nodes[leaf].Parent;
+        size_t grandParent = this->nodes[parent].Parent;
+        size_t sibling = this->nodes[parent].Left == leaf ? this->nodes[parent].Right : this->nodes[parent].Left;
+
+        if (grandParent != InvalidProxy)
+        {
+            // replace parent with sibling and update boxes up to the root
+            auto& grandParentNode = this->nodes[grandParent];
+            if (grandParentNode.Left == parent) grandParentNode.Left = sibling;
+            else grandParentNode.Right = sibling;
+            this->nodes[sibling].Parent = grandParent;
+            this->FreeNode(parent);
+
+            this->RefitAncestors(grandParent);
+        }
+        else
+        {
+            this->root = sibling;
+            this->nodes[sibling].Parent = InvalidProxy;
+            this->FreeNode(parent);
+        }
+        this->nodes[leaf].Parent = InvalidProxy;
+    }
+
+    void DynamicAABBTree::RefitAncestors(size_t index)
+    {
+        while (index != InvalidProxy)
+        {
+            index = this->Balance(index);
+
+            auto& node = this->nodes[index];
+            const auto& left = this->nodes[node.Left];
+            const auto& right = this->nodes[node.Right];
+            node.Height = 1 + Max(left.Height, right.Height);
+            node.Box = Union(left.Box, right.Box);
+
+            index = node.Parent;
+        }
+    }
+
+    size_t DynamicAABBTree::Balance(size_t a)
+    {
+        // rotates subtree if one child is deeper than other by two levels or more. Returns index of new subtree root
+        auto& A = this->nodes[a];
+        if (A.IsLeaf() || A.Height < 2) return a;
+
+        size_t b = A.Left;
+        size_t c = A.Right;
+        int balance = this->nodes[c].Height - this->nodes[b].Height;
+
+        auto Rotate = [this, a](size_t up)
+        {
+            // deeper child `up` becomes parent of `a`
+            auto& A = this->nodes[a];
+            auto& U = this->nodes[up];
+            size_t f = U.Left;
+            size_t g = U.Right;
+
+            U.Left = a;
+            U.Parent = A.Parent;
+            A.Parent = up;
+
+            if (U.Parent != InvalidProxy)
+            {
+                auto& parent = this->nodes[U.Parent];
+                if (parent.Left == a) parent.Left = up;
+                else parent.Right = up;
+            }
+            else
+            {
+                this->root = up;
+            }
+
+            // deeper grandchild stays under `up`, other one replaces `up` as child of `a`
+            size_t keep = this->nodes[f].Height > this->nodes[g].Height ? f : g;
+            size_t move = keep == f ? g : f;
+
+            U.Right = keep;
+            if (A.Left == up) A.Left = move;
+            else A.Right = move;
+            this->nodes[move].Parent = a;
+
+            const auto& aLeft = this->nodes[A.Left];
+            const auto& aRight = this->nodes[A.Right];
+            A.Box = Union(aLeft.Box, aRight.Box);
+            A.Height = 1 + Max(aLeft.Height, aRight.Height);
+
+            const auto& uRight = this->nodes[U.Right];
+            U.Box = Union(A.Box, uRight.Box);
+            U.Height = 1 + Max(A.Height, uRight.Height);
+            return up;
+        };
+
+        if (balance > 1) return Rotate(c);
+        if (balance < -1) return Rotate(b);
+        return a;
+    }
+}
@@ -0,0 +1,343 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <limits>
+
+#include "Core/BoundingObjects/AABB.h"
+#include "Core/BoundingObjects/BoundingSphere.h"
+#include "Core/BoundingObjects/FrustrumCuller.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+    /*!
+    dynamic bounding volume hierarchy over axis-aligned boxes. Each leaf (proxy) stores box enlarged by margin, so small movements
+    do not change tree structure. Leaves are inserted near the sibling which increases total surface area the least and
+    tree is kept balanced by rotations, so queries visit O(log N) nodes plus nodes which are actually hit
+    */
+    class DynamicAABBTree
+    {
+    public:
+        static constexpr size_t InvalidProxy = std::numeric_limits<size_t>::max();
+    private:
+        struct Node
+        {
+            AABB Box;
+            size_t Parent = InvalidProxy; // next free node if node is not used
+            size_t Left = InvalidProxy;
+            size_t Right = InvalidProxy;
+            size_t UserData = 0;
+            int Height = -1; // zero for leaves, -1 for free nodes
+
+            bool IsLeaf() const { return this->Left == InvalidProxy; }
+        };
+
+        MxVector<Node> nodes;
+        size_t root = InvalidProxy;
+        size_t freeList = InvalidProxy;
+        size_t proxyCount = 0;
+        float margin = 0.0f;
+
+        size_t AllocateNode();
+        void FreeNode(size_t index);
+        void InsertLeaf(size_t leaf);
+        void RemoveLeaf(size_t leaf);
+        size_t Balance(size_t index);
+        void RefitAncestors(size_t index);
+
+        template<typename Func>
+        void ForEachLeaf(size_t index, Func&& func) const;
+    public:
+        /*!
+        creates empty tree
+        \param margin distance by which proxy boxes are enlarged in each direction
+        */
+        explicit DynamicAABBTree(float margin = 0.1f);
+
+        /*!
+        adds new proxy to the tree
+        \param box bounding box of proxy
+        \param userData value returned to user by queries
+        \returns proxy id, valid until Remove() call
+        */
+        size_t Insert(const AABB& box, size_t userData);
+        /*!
+        removes proxy from the tree
+        \param proxy proxy id returned by Insert()
+        */
+        void Remove(size_t proxy);
+        /*!
+        updates bounding box of proxy. Tree is changed only if new box is not inside enlarged box of proxy
+        \param proxy proxy id returned by Insert()
+        \param box new bounding box of proxy
+        \returns true if proxy was reinserted, false if its enlarged box still contains new one
+        */
+        bool Move(size_t proxy, const AABB& box);
+        /*!
+        removes all proxies from the tree
+        */
+        void Clear();
+
+        /*!
+        getter for enlarged bounding box of proxy
+        \param proxy proxy id returned by Insert()
+        \returns box which contains proxy box passed to Insert() or Move()
+        */
+        const AABB& GetEnlargedAABB(size_t proxy) const;
+        /*!
+        getter for user data of proxy
+        \param proxy proxy id returned by Insert()
+        \returns value passed to Insert()
+        */
+        size_t GetUserData(size_t proxy) const;
+        /*!
+        getter for number of proxies in the tree
+        \returns proxy count
+        */
+        size_t GetProxyCount() const;
+        /*!
+        getter for height of the tree
+        \returns number of levels from root to deepest leaf, zero for empty tree
+        */
+        size_t GetHeight() const;
+
+        /*!
+        invokes callback for each proxy which box overlaps given box
+        \param box box to test against
+        \param callback functor with signature `void(size_t userData)`
+        */
+        template<typename Func>
+        void QueryAABB(const AABB& box, Func&& callback) const;
+        /*!
+        invokes callback for each proxy which box overlaps given sphere
+        \param sphere sphere to test against
+        \param callback functor with signature `void(size_t userData)`
+        */
+        template<typename Func>
+        void QuerySphere(const BoundingSphere& sphere, Func&& callback) const;
+        /*!
+        invokes callback for each proxy which box is visible from frustrum. Subtrees which are fully inside frustrum are not tested further
+        \param culler frustrum to test against
+        \param callback functor with signature `void(size_t userData, bool fullyInside)`
+        */
+        template<typename Func>
+        void QueryFrustrum(const FrustrumCuller& culler, Func&& callback) const;
+        /*!
+        invokes callback for each proxy which box is intersected by ray. Order in which proxies are reported is not specified
+        \param origin ray origin
+        \param direction normalized ray direction
+        \param maxDistance length of ray
+        \param callback functor with signature `float(size_t userData, float distance)`, where distance is ray distance to proxy box.
+        Functor returns new ray length, so returning zero stops query and returning smaller value clips the ray
+        */
+        template<typename Func>
+        void RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, Func&& callback) const;
+    };
+
+    /*!
+    checks if two boxes overlap
+    \param box1 first box
+    \param box2 second box
+    \returns true if boxes have common points, false otherwise
+    */
+    inline bool IsOverlapping(const AABB& box1, const AABB& box2)
+    {
+        return box1.Min.x <= box2.Max.x && box1.Max.x >= box2.Min.x &&
+               box1.Min.y <= box2.Max.y && box1.Max.y >= box2.Min.y &&
+               box1.Min.z <= box2.Max.z && box1.Max.z >= box2.Min.z;
+    }
+
+    /*!
+    checks if sphere overlaps box
+    \param box box to test
+    \param sphere sphere to test
+    \returns true if sphere and box have common points, false otherwise
+    */
+    inline bool IsOverlapping(const AABB& box, const BoundingSphere& sphere)
+    {
+        Vector3 closest = VectorMax(box.Min, VectorMin(sphere.Center, box.Max));
+        Vector3 relative = closest - sphere.Center;
+        return Dot(relative, relative) <= sphere.Radius * sphere.Radius;
+    }
+
+    /*!
+    computes distance from ray origin to box using slab test
+    \param box box to test
+    \param origin ray origin
+    \param inverseDirection component-wise inverse of ray direction
+    \param maxDistance length of ray
+    \param distance distance along ray to the first point inside box (zero if origin is inside box)
+    \returns true if ray hits box, false otherwise
+    */
+    inline bool RayIntersects(const AABB& box, const Vector3& origin, const Vector3& inverseDirection, float maxDistance, float& distance)
+    {
+        Vector3 t1 = (box.Min - origin) * inverseDirection;
+        Vector3 t2 = (box.Max - origin) * inverseDirection;
+        Vector3 tmin = VectorMin(t1, t2);
+        Vector3 tmax = VectorMax(t1, t2);
+        float enter = Max(tmin.x, tmin.y, tmin.z);
+        float exit = Min(tmax.x, tmax.y, tmax.z);
+        distance = Max(enter, 0.0f);
+        return exit >= distance && distance <= maxDistance;
+    }
+
+    template<typename Func>
+    void DynamicAABBTree::ForEachLeaf(size_t index, Func&& func) const
+    {
+        MxVector<size_t> stack;
+        stack.push_back(index);
+        while (!stack.empty())
+        {
+            const Node& node = this->nodes[stack.back()];
+            stack.pop_back();
+            if (node.IsLeaf())
+            {
+                func(node.UserData);
+            }
+            else
+            {
+                stack.push_back(node.Left);
+                stack.push_back(node.Right);
+            }
+        }
+    }
+
+    template<typename Func>
+    void DynamicAABBTree::QueryAABB(const AABB& box, Func&& callback) const
+    {
+        if (this->root == InvalidProxy) return;
+
+        MxVector<size_t> stack;
+        stack.push_back(this->root);
+        while (!stack.empty())
+        {
+            const Node& node = this->nodes[stack.back()];
+            stack.pop_back();
+            if (!IsOverlapping(node.Box, box)) continue;
+
+            if (node.IsLeaf())
+            {
+                callback(node.UserData);
+            }
+            else
+            {
+                stack.push_back(node.Left);
+                stack.push_back(node.Right);
+            }
+        }
+    }
+
+    template<typename Func>
+    void DynamicAABBTree::QuerySphere(const BoundingSphere& sphere, Func&& callback) const
+    {
+        if (this->root == InvalidProxy) return;
+
+        MxVector<size_t> stack;
+        stack.push_back(this->root);
+        while (!stack.empty())
+        {
+            const Node& node = this->nodes[stack.back()];
+            stack.pop_back();
+            if (!IsOverlapping(node.Box, sphere)) continue;
+
+            if (node.IsLeaf())
+            {
+                callback(node.UserData);
+            }
+            else
+            {
+                stack.push_back(node.Left);
+                stack.push_back(node.Right);
+            }
+        }
+    }
+
+    template<typename Func>
+    void DynamicAABBTree::QueryFrustrum(const FrustrumCuller& culler, Func&& callback) const
+    {
+        if (this->root == InvalidProxy) return;
+
+        MxVector<size_t> stack;
+        stack.push_back(this->root);
+        while (!stack.empty())
+        {
+            size_t index = stack.back();
+            const Node& node = this->nodes[index];
+            stack.pop_back();
+
+            auto containment = culler.ClassifyAABB(node.Box.Min, node.Box.Max);
+            if (containment == FrustrumCuller::Containment::OUTSIDE) continue;
+
+            if (containment == FrustrumCuller::Containment::INSIDE)
+            {
+                this->ForEachLeaf(index, [&callback](size_t userData) { callback(userData, true); });
+            }
+            else if (node.IsLeaf())
+            {
+                callback(node.UserData, false);
+            }
+            else
+            {
+                stack.push_back(node.Left);
+                stack.push_back(node.Right);
+            }
+        }
+    }
+
+    template<typename Func>
+    void DynamicAABBTree::RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, Func&& callback) const
+    {
+        if (this->root == InvalidProxy) return;
+
+        // division by zero produces infinity, which is correctly handled by slab test
+        Vector3 inverseDirection = 1.0f / direction;
+
+        MxVector<size_t> stack;
+        stack.push_back(this->root);
+        while (!stack.empty() && maxDistance > 0.0f)
+        {
+            const Node& node = this->nodes[stack.back()];
+            stack.pop_back();
+
+            float distance = 0.0f;
+            if (!RayIntersects(node.Box, origin, inverseDirection, maxDistance, distance)) continue;
+
+            if (node.IsLeaf())
+            {
+                maxDistance = Min(maxDistance, callback(node.UserData, distance));
+            }
+            else
+            {
+                stack.push_back(node.Left);
+                stack.push_back(node.Right);
+            }
+        }
+    }
+}
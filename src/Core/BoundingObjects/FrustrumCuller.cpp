@@ -0,0 +1,106 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "FrustrumCuller.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MXENGINE_FRUSTRUM_CULLER_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace MxEngine
+{
+	void FrustrumCuller::CullAABBs(const AABBArrayView& boxes, size_t begin, size_t end, uint64_t* visibilityMask) const
+	{
+		// box is outside of plane if its farthest corner in plane direction is behind plane. This is exactly
+		// the same test as checking all 8 corners in IsAABBVisible(), but needs only two dot products
+		std::array<Vector4, Planes::COUNT> absolutePlanes;
+		for (size_t p = 0; p < this->planes.size(); p++)
+		{
+			const auto& plane = this->planes[p];
+			absolutePlanes[p] = Vector4(std::abs(plane.x), std::abs(plane.y), std::abs(plane.z), 0.0f);
+		}
+
+		auto IsBoxVisible = [this, &absolutePlanes, &boxes](size_t i)
+		{
+			for (size_t p = 0; p < this->planes.size(); p++)
+			{
+				const auto& plane = this->planes[p];
+				const auto& absolutePlane = absolutePlanes[p];
+				float distance = plane.x * boxes.CenterX[i] + plane.y * boxes.CenterY[i] + plane.z * boxes.CenterZ[i] + plane.w;
+				float radius = absolutePlane.x * boxes.ExtentX[i] + absolutePlane.y * boxes.ExtentY[i] + absolutePlane.z * boxes.ExtentZ[i];
+				if (distance + radius < 0.0f) return false;
+			}
+			return true;
+		};
+
+		auto SetVisible = [visibilityMask](size_t i)
+		{
+			visibilityMask[i / 64] |= uint64_t(1) << (i % 64);
+		};
+
+		size_t i = begin;
+		#if defined(MXENGINE_FRUSTRUM_CULLER_SSE)
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 centerX = _mm_loadu_ps(boxes.CenterX + i);
+			__m128 centerY = _mm_loadu_ps(boxes.CenterY + i);
+			__m128 centerZ = _mm_loadu_ps(boxes.CenterZ + i);
+			__m128 extentX = _mm_loadu_ps(boxes.ExtentX + i);
+			__m128 extentY = _mm_loadu_ps(boxes.ExtentY + i);
+			__m128 extentZ = _mm_loadu_ps(boxes.ExtentZ + i);
+			__m128 outside = _mm_setzero_ps();
+
+			for (size_t p = 0; p < this->planes.size(); p++)
+			{
+				const auto& plane = this->planes[p];
+				const auto& absolutePlane = absolutePlanes[p];
+
+				__m128 distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), centerX), _mm_mul_ps(_mm_set1_ps(plane.y), centerY)),
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), centerZ), _mm_set1_ps(plane.w)));
+				__m128 radius = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(absolutePlane.x), extentX), _mm_mul_ps(_mm_set1_ps(absolutePlane.y), extentY)),
+					_mm_mul_ps(_mm_set1_ps(absolutePlane.z), extentZ));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+			}
+
+			int visible = ~_mm_movemask_ps(outside) & 0xF;
+			for (size_t k = 0; k < 4; k++)
+			{
+				if (visible & (1 << k)) SetVisible(i + k);
+			}
+		}
+		#endif
+
+		for (; i < end; i++)
+		{
+			if (IsBoxVisible(i)) SetVisible(i);
+		}
+	}
+}
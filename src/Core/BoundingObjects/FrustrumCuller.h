@@ -33,10 +33,30 @@
 
 namespace MxEngine
 {
+	/*!
+	structure of arrays view over axis-aligned bounding boxes, stored as centers and half-sizes
+	*/
+	struct AABBArrayView
+	{
+		const float* CenterX;
+		const float* CenterY;
+		const float* CenterZ;
+		const float* ExtentX;
+		const float* ExtentY;
+		const float* ExtentZ;
+	};
+
 	// thanks to https://gist.github.com/podgorskiy/e698d18879588ada9014768e3e82a644
 	class FrustrumCuller
 	{
 	public:
+		enum class Containment
+		{
+			OUTSIDE,
+			INTERSECTS,
+			INSIDE,
+		};
+
 		FrustrumCuller() = default;
 
 		// m = ProjectionMatrix * ViewMatrix 
@@ -45,6 +65,24 @@ namespace MxEngine
 		// http://iquilezles.org/www/articles/frustumcorrect/frustumcorrect.htm
 		bool IsAABBVisible(const Vector3& minp, const Vector3& maxp) const;
 
+		/*!
+		classifies bounding box against frustrum. Box is considered outside in the same cases as IsAABBVisible() returns false
+		\param minp minimal corner of box
+		\param maxp maximal corner of box
+		\returns OUTSIDE if box is not visible, INSIDE if box is completely inside frustrum, INTERSECTS otherwise
+		*/
+		Containment ClassifyAABB(const Vector3& minp, const Vector3& maxp) const;
+
+		/*!
+		tests range of bounding boxes against frustrum, processing four boxes at once if SSE is available.
+		Result is same as calling IsAABBVisible() for each box
+		\param boxes bounding boxes to test
+		\param begin index of first box to test
+		\param end index after last box to test
+		\param visibilityMask bitmask with one bit per box. Bits of visible boxes are set, other bits are not changed
+		*/
+		void CullAABBs(const AABBArrayView& boxes, size_t begin, size_t end, uint64_t* visibilityMask) const;
+
 	private:
 		enum Planes
 		{
@@ -147,4 +185,21 @@ namespace MxEngine
 
 		return true;
  	}
+
+	inline FrustrumCuller::Containment FrustrumCuller::ClassifyAABB(const Vector3& minp, const Vector3& maxp) const
+	{
+		Vector3 center = 0.5f * (maxp + minp);
+		Vector3 extent = 0.5f * (maxp - minp);
+
+		// distance to plane of nearest and farthest box corners is center distance -/+ projected extent
+		bool isInside = true;
+		for (const auto& plane : this->planes)
+		{
+			float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+			float radius = std::abs(plane.x) * extent.x + std::abs(plane.y) * extent.y + std::abs(plane.z) * extent.z;
+			if (distance + radius < 0.0f) return Containment::OUTSIDE;
+			if (distance - radius < 0.0f) isInside = false;
+		}
+		return isInside ? Containment::INSIDE : Containment::INTERSECTS;
+	}
 }
\ No newline at end of file
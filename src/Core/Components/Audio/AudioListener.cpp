@@ -15,7 +15,7 @@ namespace MxEngine
         {
             this->SetOrientation(camera->GetDirection(), camera->GetUpVector());
         }
-        this->SetPosition(object.Transform.GetPosition());
+        this->SetPosition(object.Transform.GetWorldPosition());
     }
 
     void AudioListener::SetPosition(const Vector3& position)
@@ -93,4 +93,7 @@ namespace MxEngine
 		float GetRollofFactor() const;
 		float GetReferenceDistance() const;
 	};
-}
\ No newline at end of file
+}
+
+// audio source only reads position of its object and forwards it to OpenAL, which is thread safe
+MXENGINE_COMPONENT_UPDATE_POLICY(AudioSource, true)
\ No newline at end of file
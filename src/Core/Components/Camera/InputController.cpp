@@ -73,9 +73,9 @@ namespace MxEngine
 				}
 				else
 				{
-					vecForward = object->Transform.GetRotation() * vecForward; //-V807
-					vecRight = object->Transform.GetRotation() * vecRight;
-					vecUp = object->Transform.GetRotation() * vecUp;
+					vecForward = object->Transform.GetRotationQuaternion() * vecForward; //-V807
+					vecRight = object->Transform.GetRotationQuaternion() * vecRight;
+					vecUp = object->Transform.GetRotationQuaternion() * vecUp;
 				}
 
 				auto dt = Application::GetImpl()->GetUnscaledTimeDelta();
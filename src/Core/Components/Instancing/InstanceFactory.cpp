@@ -1,8 +1,12 @@
 #include "InstanceFactory.h"
 #include "Core/Components/Rendering/MeshSource.h"
+#include "Core/Components/Rendering/MeshLOD.h"
 #include "Utilities/Profiler/Profiler.h"
 #include "Core/Runtime/Reflection.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace MxEngine
 {
     void InstanceFactory::InitMesh()
@@ -12,10 +16,12 @@ namespace MxEngine
         if (meshSource.IsValid())
         {
             auto& mesh = *meshSource->Mesh;
-            auto modelBufferIndex = this->AddInstancedBuffer(mesh, this->GetModelData());
-            (void)this->AddInstancedBuffer(mesh, this->GetNormalData());
-            (void)this->AddInstancedBuffer(mesh, this->GetColorData());
+            this->RebuildInstanceData(mesh.MeshAABB);
+            auto modelBufferIndex = this->AddInstancedBuffer(mesh, this->models);
+            (void)this->AddInstancedBuffer(mesh, this->normals);
+            (void)this->AddInstancedBuffer(mesh, this->colors);
             this->bufferIndex = modelBufferIndex; // others will be `bufferIndex + 1`, `bufferIndex + 2`
+            this->uploadedInstances.clear(); // new buffers contain all instances, not the compacted ones
         }
     }
 
@@ -25,6 +31,39 @@ namespace MxEngine
         mesh.PopInstancedBuffer();
     }
 
+    void InstanceFactory::AttachLODMesh(LODInstances& lod, const MeshHandle& mesh)
+    {
+        this->DetachLODMesh(lod);
+        lod.Mesh = mesh;
+        if (!mesh.IsValid()) return;
+
+        // buffers are filled on first upload, only their layout matters here
+        lod.Index = this->AddInstancedBuffer(*lod.Mesh, ModelData(1, Matrix4x4(0.0f)));
+        (void)this->AddInstancedBuffer(*lod.Mesh, NormalData(1, Matrix3x3(0.0f)));
+        (void)this->AddInstancedBuffer(*lod.Mesh, ColorData(1, MakeVector3(0.0f)));
+    }
+
+    void InstanceFactory::DetachLODMesh(LODInstances& lod)
+    {
+        if (lod.Mesh.IsValid() && lod.Index != std::numeric_limits<BufferIndex>::max())
+        {
+            auto& mesh = *lod.Mesh;
+            this->RemoveInstancedBuffer(mesh, (size_t)lod.Index + 2);
+            this->RemoveInstancedBuffer(mesh, (size_t)lod.Index + 1);
+            this->RemoveInstancedBuffer(mesh, (size_t)lod.Index + 0);
+        }
+        lod = LODInstances{ };
+    }
+
+    void InstanceFactory::ReleaseLODs()
+    {
+        for (auto& lod : this->lods)
+            this->DetachLODMesh(lod);
+        this->lods.clear();
+        this->instanceLODs.clear();
+        this->lodInstanceCounts.clear();
+    }
+
     void InstanceFactory::RemoveDanglingHandles()
     {
         for (auto& object : this->pool)
@@ -40,6 +79,7 @@ namespace MxEngine
         auto meshSource = object.GetComponent<MeshSource>();
 
         this->DestroyInstances();
+        this->ReleaseLODs();
 
         if (meshSource.IsValid() && meshSource->Mesh.IsValid())
         {
@@ -58,13 +98,13 @@ namespace MxEngine
     void InstanceFactory::OnUpdate(float timeDelta)
     {
         this->RemoveDanglingHandles();
-        if (!this->IsStatic) this->SendInstancesToGPU();
+        if (!this->IsStatic) this->UpdateInstanceData();
     }
 
     void InstanceFactory::SubmitInstances()
     {
         this->RemoveDanglingHandles();
-        this->SendInstancesToGPU();
+        this->UpdateInstanceData();
     }
 
     // see SceneSerializer.cpp
@@ -88,6 +128,119 @@ namespace MxEngine
             MxObject::Destroy(object);
         }
         this->pool.Clear();
+        this->ClearRecords();
+    }
+
+    size_t InstanceFactory::AddInstance(const Vector3& position, const Quaternion& rotation, const Vector3& scale, const Vector3& color)
+    {
+        auto& records = this->records;
+        records.Positions.push_back(position);
+        records.Rotations.push_back(rotation);
+        records.Scales.push_back(scale);
+        records.Colors.push_back(Clamp(color, MakeVector3(0.0f), MakeVector3(1.0f)));
+        this->isLayoutChanged = true;
+        return records.Positions.size() - 1;
+    }
+
+    void InstanceFactory::RemoveInstance(size_t index)
+    {
+        auto& records = this->records;
+        MX_ASSERT(index < records.Positions.size());
+
+        // last record is moved to the removed one, so arrays stay dense
+        records.Positions[index] = records.Positions.back();
+        records.Rotations[index] = records.Rotations.back();
+        records.Scales[index] = records.Scales.back();
+        records.Colors[index] = records.Colors.back();
+
+        records.Positions.pop_back();
+        records.Rotations.pop_back();
+        records.Scales.pop_back();
+        records.Colors.pop_back();
+        this->isLayoutChanged = true;
+    }
+
+    MxObject::Handle InstanceFactory::PromoteInstance(size_t index)
+    {
+        MX_ASSERT(index < this->records.Positions.size());
+        auto instance = this->Instanciate();
+
+        instance->Transform.SetPosition(this->records.Positions[index]);
+        instance->Transform.SetRotation(this->records.Rotations[index]);
+        instance->Transform.SetScale(this->records.Scales[index]);
+        instance->GetComponent<Instance>()->SetColor(this->records.Colors[index]);
+
+        this->RemoveInstance(index);
+        return instance;
+    }
+
+    void InstanceFactory::ReserveInstances(size_t count)
+    {
+        auto& records = this->records;
+        records.Positions.reserve(count);
+        records.Rotations.reserve(count);
+        records.Scales.reserve(count);
+        records.Colors.reserve(count);
+    }
+
+    void InstanceFactory::ClearRecords()
+    {
+        auto& records = this->records;
+        records.Positions.clear();
+        records.Rotations.clear();
+        records.Scales.clear();
+        records.Colors.clear();
+        this->isLayoutChanged = true;
+    }
+
+    void InstanceFactory::SetInstanceTransform(size_t index, const Vector3& position, const Quaternion& rotation, const Vector3& scale)
+    {
+        auto& records = this->records;
+        MX_ASSERT(index < records.Positions.size());
+
+        records.Positions[index] = position;
+        records.Rotations[index] = rotation;
+        records.Scales[index] = scale;
+
+        this->changedRecords.resize((records.Positions.size() + 63) / 64, 0);
+        this->changedRecords[index / 64] |= uint64_t(1) << (index % 64);
+    }
+
+    void InstanceFactory::SetInstanceColor(size_t index, const Vector3& color)
+    {
+        auto& records = this->records;
+        MX_ASSERT(index < records.Colors.size());
+
+        records.Colors[index] = Clamp(color, MakeVector3(0.0f), MakeVector3(1.0f));
+
+        this->changedRecords.resize((records.Positions.size() + 63) / 64, 0);
+        this->changedRecords[index / 64] |= uint64_t(1) << (index % 64);
+    }
+
+    size_t InstanceFactory::GetObjectCount() const
+    {
+        return this->GetInstancePool().Allocated();
+    }
+
+    size_t InstanceFactory::GetRecordCount() const
+    {
+        return this->records.Positions.size();
+    }
+
+    size_t InstanceFactory::GetCount() const
+    {
+        return this->GetObjectCount() + this->GetRecordCount();
+    }
+
+    const InstanceFactory::InstanceRecords& InstanceFactory::GetRecords() const
+    {
+        return this->records;
+    }
+
+    InstanceFactory::InstanceRecords& InstanceFactory::GetRecords()
+    {
+        this->isLayoutChanged = true;
+        return this->records;
     }
 
     InstanceFactory::ModelData& InstanceFactory::GetModelData()
@@ -95,13 +248,18 @@ namespace MxEngine
         MAKE_SCOPE_PROFILER("Instancing::BufferModelData");
 
         this->models.resize(this->GetCount());
+        this->transformVersions.resize(this->GetObjectCount());
         auto model = this->models.begin();
+        auto version = this->transformVersions.begin();
         auto instance = this->GetInstancePool().begin();
 
-        for (; model != this->models.end(); model++, instance++)
+        for (size_t i = 0; i < this->GetObjectCount(); i++, model++, version++, instance++)
         {
-            instance->GetUnchecked()->Transform.GetMatrix(*model);
+            auto& transform = instance->GetUnchecked()->Transform;
+            transform.GetMatrix(*model);
+            *version = transform.GetVersion();
         }
+
         if (this->models.empty()) this->models.emplace_back(0.0f);
 
         return this->models;
@@ -115,10 +273,11 @@ namespace MxEngine
         auto normal = this->normals.begin();
         auto model = this->models.begin();
         auto instance = this->GetInstancePool().begin();
-        for (; normal != this->normals.end(); model++, normal++, instance++)
+        for (size_t i = 0; i < this->GetObjectCount(); i++, model++, normal++, instance++)
         {
             instance->GetUnchecked()->Transform.GetNormalMatrix(*model, *normal);
         }
+
         if (this->normals.empty()) this->normals.emplace_back(0.0f);
 
         return this->normals;
@@ -129,11 +288,13 @@ namespace MxEngine
         MAKE_SCOPE_PROFILER("Instancing::BufferColorData");
 
         this->colors.resize(this->GetCount());
+        auto color = this->colors.begin();
         auto instance = this->GetInstancePool().begin();
-        for (auto it = this->colors.begin(); it != this->colors.end(); it++, instance++)
+        for (size_t i = 0; i < this->GetObjectCount(); i++, color++, instance++)
         {
-            *it = instance->GetUnchecked()->GetComponent<Instance>()->GetColor();
+            *color = instance->GetUnchecked()->GetComponent<Instance>()->GetColor();
         }
+        std::copy(this->records.Colors.begin(), this->records.Colors.end(), color);
         if (this->colors.empty()) this->colors.emplace_back(0.0f);
 
         return this->colors;
@@ -144,7 +305,137 @@ namespace MxEngine
         this->Destroy();
     }
 
-    void InstanceFactory::SendInstancesToGPU()
+    void InstanceFactory::UpdateInstanceBounds(const AABB& meshAABB)
+    {
+        MAKE_SCOPE_PROFILER("Instancing::ComputeBounds");
+
+        size_t count = this->GetCount();
+        auto& bounds = this->bounds;
+        bounds.CenterX.resize(count);
+        bounds.CenterY.resize(count);
+        bounds.CenterZ.resize(count);
+        bounds.ExtentX.resize(count);
+        bounds.ExtentY.resize(count);
+        bounds.ExtentZ.resize(count);
+
+        Vector3 localCenter = 0.5f * (meshAABB.Max + meshAABB.Min);
+        Vector3 localExtent = 0.5f * (meshAABB.Max - meshAABB.Min);
+        for (size_t i = 0; i < count; i++)
+        {
+            this->UpdateInstanceBounds(i, localCenter, localExtent);
+        }
+        this->boundsAABB = meshAABB;
+    }
+
+    void InstanceFactory::UpdateInstanceBounds(size_t index, const Vector3& localCenter, const Vector3& localExtent)
+    {
+        // box is transformed by its center and half-sizes, which is cheaper than transforming all 8 corners
+        auto& bounds = this->bounds;
+        const auto& model = this->models[index];
+        Vector4 center = model * MakeVector4(localCenter.x, localCenter.y, localCenter.z, 1.0f);
+        bounds.CenterX[index] = center.x;
+        bounds.CenterY[index] = center.y;
+        bounds.CenterZ[index] = center.z;
+        bounds.ExtentX[index] = std::abs(model[0].x) * localExtent.x + std::abs(model[1].x) * localExtent.y + std::abs(model[2].x) * localExtent.z;
+        bounds.ExtentY[index] = std::abs(model[0].y) * localExtent.x + std::abs(model[1].y) * localExtent.y + std::abs(model[2].y) * localExtent.z;
+        bounds.ExtentZ[index] = std::abs(model[0].z) * localExtent.x + std::abs(model[1].z) * localExtent.y + std::abs(model[2].z) * localExtent.z;
+    }
+
+    void InstanceFactory::ComposeRecordMatrices(size_t firstRecord, size_t recordCount)
+    {
+        // records are stored densely, so matrices are composed in batches without touching any objects
+        const auto& records = this->records;
+        size_t index = this->GetObjectCount() + firstRecord;
+        TransformComponent::ComposeMatrices(
+            records.Positions.data() + firstRecord, records.Rotations.data() + firstRecord, records.Scales.data() + firstRecord,
+            recordCount, this->models.data() + index, this->normals.data() + index
+        );
+    }
+
+    void InstanceFactory::MarkInstanceChanged(size_t index)
+    {
+        uint64_t bit = uint64_t(1) << (index % 64);
+        auto& word = this->changedInstances[index / 64];
+        if ((word & bit) == 0) this->changedInstanceCount++;
+        word |= bit;
+        this->dataVersion++;
+    }
+
+    void InstanceFactory::RebuildInstanceData(const AABB& meshAABB)
+    {
+        this->GetModelData();
+        this->GetNormalData();
+        this->GetColorData();
+        this->ComposeRecordMatrices(0, this->GetRecordCount());
+        this->UpdateInstanceBounds(meshAABB);
+
+        // instances may be shifted after additions and removals, so everything is treated as changed
+        size_t count = this->GetCount();
+        this->changedInstances.assign((count + 63) / 64, ~uint64_t(0));
+        this->changedInstanceCount = count;
+        this->dataVersion++;
+        this->changedRecords.assign((this->GetRecordCount() + 63) / 64, 0);
+        this->isLayoutChanged = false;
+    }
+
+    void InstanceFactory::UpdateChangedInstances(const AABB& meshAABB)
+    {
+        MAKE_SCOPE_PROFILER("Instancing::UpdateChangedInstances");
+
+        size_t objectCount = this->GetObjectCount();
+        bool isRebuildRequired = this->isLayoutChanged || !(this->boundsAABB == meshAABB) ||
+            this->transformVersions.size() != objectCount || this->GetBufferedCount() != this->GetCount();
+
+        if (isRebuildRequired)
+        {
+            this->RebuildInstanceData(meshAABB);
+            return;
+        }
+
+        Vector3 localCenter = 0.5f * (meshAABB.Max + meshAABB.Min);
+        Vector3 localExtent = 0.5f * (meshAABB.Max - meshAABB.Min);
+
+        // transform versions are unique, so matrices (and especially normal matrices) are recomputed only for moved instances
+        auto instance = this->GetInstancePool().begin();
+        for (size_t i = 0; i < objectCount; i++, instance++)
+        {
+            auto& object = *instance->GetUnchecked();
+            uint64_t version = object.Transform.GetVersion();
+            if (version != this->transformVersions[i])
+            {
+                this->transformVersions[i] = version;
+                object.Transform.GetMatrix(this->models[i]);
+                object.Transform.GetNormalMatrix(this->models[i], this->normals[i]);
+                this->UpdateInstanceBounds(i, localCenter, localExtent);
+                this->MarkInstanceChanged(i);
+            }
+
+            const auto& color = object.GetComponent<Instance>()->GetColor();
+            if (color != this->colors[i])
+            {
+                this->colors[i] = color;
+                this->MarkInstanceChanged(i);
+            }
+        }
+
+        for (size_t word = 0; word < this->changedRecords.size(); word++)
+        {
+            uint64_t bits = this->changedRecords[word];
+            while (bits != 0)
+            {
+                size_t record = word * 64 + CountTrailingZeros(bits);
+                size_t index = objectCount + record;
+                this->ComposeRecordMatrices(record, 1);
+                this->colors[index] = this->records.Colors[record];
+                this->UpdateInstanceBounds(index, localCenter, localExtent);
+                this->MarkInstanceChanged(index);
+                bits &= bits - 1;
+            }
+            this->changedRecords[word] = 0;
+        }
+    }
+
+    void InstanceFactory::UpdateInstanceData()
     {
         auto& object = MxObject::GetByComponent(*this);
         auto meshSource = object.GetComponent<MeshSource>();
@@ -158,11 +449,213 @@ namespace MxEngine
             }
             else
             {
-                this->BufferDataByIndex(mesh, (size_t)this->bufferIndex + 0, this->GetModelData());
-                this->BufferDataByIndex(mesh, (size_t)this->bufferIndex + 1, this->GetNormalData());
-                this->BufferDataByIndex(mesh, (size_t)this->bufferIndex + 2, this->GetColorData());
+                // data is sent to GPU by render pipeline, which packs only instances visible from current camera or light
+                this->UpdateChangedInstances(mesh.MeshAABB);
+            }
+        }
+    }
+
+    size_t InstanceFactory::GetBufferedCount() const
+    {
+        return this->bounds.CenterX.size();
+    }
+
+    AABBArrayView InstanceFactory::GetInstanceBounds() const
+    {
+        return AABBArrayView{
+            this->bounds.CenterX.data(), this->bounds.CenterY.data(), this->bounds.CenterZ.data(),
+            this->bounds.ExtentX.data(), this->bounds.ExtentY.data(), this->bounds.ExtentZ.data(),
+        };
+    }
+
+    size_t InstanceFactory::SendVisibleInstancesToGPU(const MxVector<uint64_t>& visibility, size_t lodLevel)
+    {
+        MAKE_SCOPE_PROFILER("Instancing::SendVisibleInstances");
+
+        size_t count = this->GetBufferedCount();
+        MX_ASSERT(visibility.size() * 64 >= count);
+        MX_ASSERT(lodLevel <= this->lods.size());
+
+        this->visibleInstances.clear();
+        // instances without selected LOD (e.g. added after last UpdateInstanceLODs() call) are drawn with MeshSource mesh
+        bool hasInstanceLODs = this->instanceLODs.size() == count;
+        for (size_t word = 0; word * 64 < count; word++)
+        {
+            uint64_t bits = visibility[word];
+            while (bits != 0)
+            {
+                uint32_t index = uint32_t(word * 64 + CountTrailingZeros(bits));
+                size_t level = hasInstanceLODs ? (size_t)this->instanceLODs[index] : 0;
+                if (level == lodLevel) this->visibleInstances.push_back(index);
+                bits &= bits - 1;
             }
         }
+
+        size_t visibleCount = this->visibleInstances.size();
+        if (visibleCount == 0) return 0;
+
+        if (lodLevel > 0)
+        {
+            // LOD buffers are always uploaded completely, as per-instance changes are tracked only for MeshSource buffers
+            auto& lod = this->lods[lodLevel - 1];
+            bool isSameSet = lod.UploadedInstances.size() == visibleCount &&
+                std::equal(this->visibleInstances.begin(), this->visibleInstances.end(), lod.UploadedInstances.begin());
+            if (isSameSet && lod.UploadedVersion == this->dataVersion) return visibleCount;
+
+            if (!lod.Mesh.IsValid() || (uint16_t)lod.Mesh->GetInstancedBufferCount() < lod.Index + 3) return 0;
+
+            this->UploadVisibleInstances(*lod.Mesh, lod.Index, lod.Models, lod.Normals, lod.Colors);
+            std::swap(lod.UploadedInstances, this->visibleInstances);
+            lod.UploadedVersion = this->dataVersion;
+            return visibleCount;
+        }
+
+        // static scenes and views which share same visible set do not need new upload
+        bool isSameSet = this->uploadedInstances.size() == visibleCount &&
+            std::equal(this->visibleInstances.begin(), this->visibleInstances.end(), this->uploadedInstances.begin());
+        if (isSameSet && this->changedInstanceCount == 0) return visibleCount;
+
+        auto& object = MxObject::GetByComponent(*this);
+        auto meshSource = object.GetComponent<MeshSource>();
+        if (!meshSource.IsValid() || !meshSource->Mesh.IsValid()) return 0;
+        auto& mesh = *meshSource->Mesh;
+        if ((uint16_t)mesh.GetInstancedBufferCount() < this->bufferIndex + 2) return 0;
+
+        if (isSameSet)
+        {
+            this->UploadChangedInstances(mesh);
+            return visibleCount;
+        }
+
+        this->UploadVisibleInstances(mesh, this->bufferIndex, this->visibleModels, this->visibleNormals, this->visibleColors);
+
+        std::swap(this->uploadedInstances, this->visibleInstances);
+        // GPU now holds actual data of all uploaded instances. Others will be sent with next full upload, as visible set changes
+        std::fill(this->changedInstances.begin(), this->changedInstances.end(), 0);
+        this->changedInstanceCount = 0;
+        return visibleCount;
+    }
+
+    void InstanceFactory::UploadVisibleInstances(const Mesh& mesh, size_t bufferIndex, ModelData& visibleModels, NormalData& visibleNormals, ColorData& visibleColors)
+    {
+        size_t visibleCount = this->visibleInstances.size();
+        visibleModels.resize(visibleCount);
+        visibleNormals.resize(visibleCount);
+        visibleColors.resize(visibleCount);
+        for (size_t i = 0; i < visibleCount; i++)
+        {
+            size_t index = this->visibleInstances[i];
+            visibleModels[i] = this->models[index];
+            visibleNormals[i] = this->normals[index];
+            visibleColors[i] = this->colors[index];
+        }
+
+        this->BufferDataByIndex(mesh, bufferIndex + 0, visibleModels);
+        this->BufferDataByIndex(mesh, bufferIndex + 1, visibleNormals);
+        this->BufferDataByIndex(mesh, bufferIndex + 2, visibleColors);
+    }
+
+    void InstanceFactory::UpdateInstanceLODs(const MeshLOD* lod, const Vector3& viewportPosition, float viewportZoom)
+    {
+        MAKE_SCOPE_PROFILER("Instancing::UpdateInstanceLODs");
+
+        if (lod == nullptr || lod->LODs.empty())
+        {
+            if (!this->lods.empty()) this->ReleaseLODs();
+            return;
+        }
+
+        size_t lodCount = Min(lod->LODs.size(), (size_t)std::numeric_limits<uint8_t>::max());
+        while (this->lods.size() > lodCount)
+        {
+            this->DetachLODMesh(this->lods.back());
+            this->lods.pop_back();
+        }
+        this->lods.resize(lodCount);
+        for (size_t i = 0; i < lodCount; i++)
+        {
+            if (this->lods[i].Mesh != lod->LODs[i])
+                this->AttachLODMesh(this->lods[i], lod->LODs[i]);
+        }
+
+        size_t count = this->GetBufferedCount();
+        auto& bounds = this->bounds;
+        this->instanceLODs.resize(count);
+        this->lodInstanceCounts.assign(lodCount + 1, 0);
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t level = lod->GetCurrentLOD();
+            if (lod->AutoLODSelection)
+            {
+                Vector3 center = MakeVector3(bounds.CenterX[i], bounds.CenterY[i], bounds.CenterZ[i]);
+                float size = 2.0f * Max(bounds.ExtentX[i], Max(bounds.ExtentY[i], bounds.ExtentZ[i]));
+                level = MeshLOD::SelectLOD(center, size, viewportPosition, viewportZoom, lodCount);
+            }
+            if (level > 0 && !this->lods[level - 1].Mesh.IsValid()) level = 0;
+
+            this->instanceLODs[i] = (uint8_t)level;
+            this->lodInstanceCounts[level]++;
+        }
+    }
+
+    size_t InstanceFactory::GetLODCount() const
+    {
+        return this->lods.size();
+    }
+
+    MeshHandle InstanceFactory::GetLODMesh(size_t lodLevel) const
+    {
+        MX_ASSERT(lodLevel > 0 && lodLevel <= this->lods.size());
+        return this->lods[lodLevel - 1].Mesh;
+    }
+
+    size_t InstanceFactory::GetLODInstanceCount(size_t lodLevel) const
+    {
+        if (this->lods.empty() || this->lodInstanceCounts.size() != this->lods.size() + 1)
+            return lodLevel == 0 ? this->GetCount() : 0;
+        return this->lodInstanceCounts[lodLevel];
+    }
+
+    void InstanceFactory::UploadChangedInstances(const Mesh& mesh)
+    {
+        MAKE_SCOPE_PROFILER("Instancing::UploadChangedInstances");
+
+        // small gaps of unchanged instances are uploaded together with their neighbours, as each call has its own overhead
+        constexpr size_t MaxRangeGap = 8;
+
+        auto UploadRange = [this, &mesh](size_t begin, size_t end)
+        {
+            this->BufferSubDataByIndex(mesh, (size_t)this->bufferIndex + 0, this->visibleModels, begin, end);
+            this->BufferSubDataByIndex(mesh, (size_t)this->bufferIndex + 1, this->visibleNormals, begin, end);
+            this->BufferSubDataByIndex(mesh, (size_t)this->bufferIndex + 2, this->visibleColors, begin, end);
+        };
+
+        size_t rangeBegin = 0;
+        size_t rangeEnd = 0;
+        for (size_t i = 0; i < this->uploadedInstances.size(); i++)
+        {
+            size_t index = this->uploadedInstances[i];
+            if ((this->changedInstances[index / 64] & (uint64_t(1) << (index % 64))) == 0) continue;
+
+            this->visibleModels[i] = this->models[index];
+            this->visibleNormals[i] = this->normals[index];
+            this->visibleColors[i] = this->colors[index];
+
+            if (rangeEnd > rangeBegin && i <= rangeEnd + MaxRangeGap)
+            {
+                rangeEnd = i + 1;
+            }
+            else
+            {
+                if (rangeEnd > rangeBegin) UploadRange(rangeBegin, rangeEnd);
+                rangeBegin = i;
+                rangeEnd = i + 1;
+            }
+        }
+        if (rangeEnd > rangeBegin) UploadRange(rangeBegin, rangeEnd);
+
+        std::fill(this->changedInstances.begin(), this->changedInstances.end(), 0);
+        this->changedInstanceCount = 0;
     }
 
     bool IsInstanced(const MxObject& object)
@@ -239,6 +732,10 @@ namespace MxEngine
             (
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::EDITABLE)
             )
+            .property_readonly("lightweight instance count", &InstanceFactory::GetRecordCount)
+            (
+                rttr::metadata(MetaInfo::FLAGS, MetaInfo::EDITABLE)
+            )
             .property_readonly("instances", (GetPoolFunc)&InstanceFactory::GetInstancePool)
             (
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE),
@@ -29,10 +29,13 @@
 #pragma once
 
 #include "Core/Components/Instancing/Instance.h"
-#include "Core/Resources/Mesh.h"
+#include "Core/Resources/AssetManager.h"
+#include "Core/BoundingObjects/FrustrumCuller.h"
 
 namespace MxEngine
 {
+    class MeshLOD;
+
     class InstanceView
     {
     public:
@@ -138,13 +141,67 @@ namespace MxEngine
 		using NormalData = MxVector<Matrix3x3>;
 		using ColorData = MxVector<Vector3>;
 		using BufferIndex = uint16_t;
+
+		/*!
+		lightweight instances, stored as dense arrays instead of separate objects. They cannot have components or scripts,
+		but are much cheaper to create and update. Record can be turned into full object by PromoteInstance()
+		*/
+		struct InstanceRecords
+		{
+			MxVector<Vector3> Positions;
+			MxVector<Quaternion> Rotations;
+			MxVector<Vector3> Scales;
+			MxVector<Vector3> Colors;
+		};
+
+		struct InstanceBounds
+		{
+			MxVector<float> CenterX, CenterY, CenterZ;
+			MxVector<float> ExtentX, ExtentY, ExtentZ;
+		};
 	private:
+		// instances which use simplified mesh of MeshLOD are drawn from separate buffers attached to LOD mesh
+		struct LODInstances
+		{
+			MeshHandle Mesh;
+			BufferIndex Index = std::numeric_limits<BufferIndex>::max();
+			MxVector<uint32_t> UploadedInstances;
+			uint64_t UploadedVersion = 0;
+			// own staging arrays, as MeshSource ones must stay in sync with uploadedInstances for partial updates
+			ModelData Models;
+			NormalData Normals;
+			ColorData Colors;
+		};
+
 		mutable InstancePool pool;
 		ModelData models;
 		NormalData normals;
 		ColorData colors;
+		InstanceRecords records;
+		InstanceBounds bounds;
 		BufferIndex bufferIndex = std::numeric_limits<BufferIndex>::max();
 
+		// compacted data of visible instances, which is sent to GPU
+		ModelData visibleModels;
+		NormalData visibleNormals;
+		ColorData visibleColors;
+		MxVector<uint32_t> visibleInstances;
+		MxVector<uint32_t> uploadedInstances;
+
+		// change tracking: only instances which were modified since last upload are recomputed and re-sent to GPU
+		MxVector<uint64_t> transformVersions;
+		MxVector<uint64_t> changedInstances;
+		MxVector<uint64_t> changedRecords;
+		size_t changedInstanceCount = 0;
+		uint64_t dataVersion = 0;
+		AABB boundsAABB;
+
+		// LOD level of each instance, where zero is MeshSource mesh and level `i` is `lods[i - 1]`
+		MxVector<uint8_t> instanceLODs;
+		MxVector<size_t> lodInstanceCounts;
+		MxVector<LODInstances> lods;
+		bool isLayoutChanged = true;
+
 		template<typename T>
 		BufferIndex AddInstancedBuffer(Mesh& mesh, const MxVector<T>& data)
 		{
@@ -167,15 +224,34 @@ namespace MxEngine
 			VBO->BufferDataWithResize((float*)buffer.data(), buffer.size() * sizeof(T) / sizeof(float));
 		}
 
+		template<typename T>
+		void BufferSubDataByIndex(const Mesh& mesh, size_t index, const MxVector<T>& buffer, size_t begin, size_t end)
+		{
+			constexpr size_t ScalarsPerElement = sizeof(T) / sizeof(float);
+			auto VBO = mesh.GetBufferByIndex(index);
+			VBO->BufferSubData((float*)(buffer.data() + begin), (end - begin) * ScalarsPerElement, begin * ScalarsPerElement);
+		}
+
         void InitMesh();
 		void RemoveInstancedBuffer(Mesh& mesh, size_t index);
+		void AttachLODMesh(LODInstances& lod, const MeshHandle& mesh);
+		void DetachLODMesh(LODInstances& lod);
+		void ReleaseLODs();
 		void RemoveDanglingHandles();
-        void SendInstancesToGPU();
+        void UpdateInstanceData();
 		void Destroy();
 
         ModelData& GetModelData();
         NormalData& GetNormalData();
         ColorData& GetColorData();
+        void UpdateInstanceBounds(const AABB& meshAABB);
+        void UpdateInstanceBounds(size_t index, const Vector3& localCenter, const Vector3& localExtent);
+        void ComposeRecordMatrices(size_t firstRecord, size_t recordCount);
+        void RebuildInstanceData(const AABB& meshAABB);
+        void UpdateChangedInstances(const AABB& meshAABB);
+        void MarkInstanceChanged(size_t index);
+        void UploadChangedInstances(const Mesh& mesh);
+        void UploadVisibleInstances(const Mesh& mesh, size_t bufferIndex, ModelData& visibleModels, NormalData& visibleNormals, ColorData& visibleColors);
 	public:
         InstanceFactory() = default;
 
@@ -183,7 +259,9 @@ namespace MxEngine
 
 		const InstancePool& GetInstancePool() const { return this->pool; }
 		InstancePool& GetInstancePool() { return this->pool; };
-		size_t GetCount() const { return this->GetInstancePool().Allocated(); }
+		size_t GetCount() const;
+		size_t GetObjectCount() const;
+		size_t GetRecordCount() const;
         auto GetInstances() const { return InstanceView{ this->pool }; }
 
 		void Init();
@@ -192,6 +270,103 @@ namespace MxEngine
         void SubmitInstances();
 		void DestroyInstances();
 
+		/*!
+		adds lightweight instance without creating object for it
+		\param position world position of instance
+		\param rotation world rotation of instance
+		\param scale scale of instance
+		\param color color of instance, clamped to [0, 1] range
+		\returns index of instance record
+		*/
+		size_t AddInstance(const Vector3& position, const Quaternion& rotation = Quaternion(1.0f, 0.0f, 0.0f, 0.0f),
+			const Vector3& scale = MakeVector3(1.0f), const Vector3& color = MakeVector3(1.0f));
+		/*!
+		removes lightweight instance. Last record is moved to its place, so index of last record changes
+		\param index index of instance record
+		*/
+		void RemoveInstance(size_t index);
+		/*!
+		converts lightweight instance to full instance object, which can be edited, scripted and serialized as any other object.
+		Record is removed as by RemoveInstance() call
+		\param index index of instance record
+		\returns created instance object
+		*/
+		MxObject::Handle PromoteInstance(size_t index);
+		/*!
+		reserves memory for lightweight instances, so many instances can be added without reallocations
+		\param count total number of records to reserve
+		*/
+		void ReserveInstances(size_t count);
+		/*!
+		removes all lightweight instances. Instance objects are not affected
+		*/
+		void ClearRecords();
+		/*!
+		changes transform of lightweight instance. Only changed instances are recomputed and re-sent to GPU
+		\param index index of instance record
+		\param position new world position of instance
+		\param rotation new world rotation of instance
+		\param scale new scale of instance
+		*/
+		void SetInstanceTransform(size_t index, const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+		/*!
+		changes color of lightweight instance
+		\param index index of instance record
+		\param color new color of instance, clamped to [0, 1] range
+		*/
+		void SetInstanceColor(size_t index, const Vector3& color);
+		const InstanceRecords& GetRecords() const;
+		/*!
+		getter for mutable records. As factory cannot know which records are edited, all instance data is rebuilt on next update.
+		Prefer SetInstanceTransform() and SetInstanceColor() when only few instances are changed
+		\returns lightweight instance records
+		*/
+		InstanceRecords& GetRecords();
+
+		/*!
+		getter for number of instances which data was computed by last update. May differ from GetCount() for static factories
+		\returns number of instances which can be sent to GPU
+		*/
+		size_t GetBufferedCount() const;
+		/*!
+		getter for world-space bounding boxes of instances, computed from mesh bounding box and instance transforms
+		\returns view over GetBufferedCount() boxes
+		*/
+		AABBArrayView GetInstanceBounds() const;
+		/*!
+		sends data of visible instances to GPU, packing them one after another. If same instances were sent last time,
+		only ranges of instances which changed since then are uploaded, and upload is skipped completely if nothing changed
+		\param visibility bitmask with one bit per instance
+		\returns number of visible instances, which should be used as instance count of draw calls
+		*/
+		size_t SendVisibleInstancesToGPU(const MxVector<uint64_t>& visibility, size_t lodLevel = 0);
+
+		/*!
+		selects LOD level of each instance by its screen size, as MeshLOD::FixBestLOD() does for single objects.
+		If MeshLOD does not use automatic selection, its current LOD is applied to all instances
+		\param lod LOD component of object, or nullptr to draw all instances with MeshSource mesh
+		\param viewportPosition position of camera
+		\param viewportZoom zoom of camera
+		*/
+		void UpdateInstanceLODs(const MeshLOD* lod, const Vector3& viewportPosition, float viewportZoom);
+		/*!
+		getter for number of LOD levels used by instances, excluding MeshSource mesh
+		\returns number of LOD meshes
+		*/
+		size_t GetLODCount() const;
+		/*!
+		getter for mesh of LOD level
+		\param lodLevel LOD level in range [1, GetLODCount()]
+		\returns mesh which is used to draw instances of this level
+		*/
+		MeshHandle GetLODMesh(size_t lodLevel) const;
+		/*!
+		getter for number of instances which were assigned to LOD level by last UpdateInstanceLODs() call
+		\param lodLevel LOD level in range [0, GetLODCount()]
+		\returns number of instances of LOD level
+		*/
+		size_t GetLODInstanceCount(size_t lodLevel) const;
+
 		~InstanceFactory();
 	};
 }
\ No newline at end of file
@@ -121,7 +121,7 @@ namespace MxEngine
             if (viewport.IsValid())
             {
                 auto& object = MxObject::GetByComponent(*self);
-                object.Transform.SetPosition(MxObject::GetByComponent(*viewport).Transform.GetPosition());
+                object.Transform.SetPosition(MxObject::GetByComponent(*viewport).Transform.GetWorldPosition());
                 auto direction = viewport->GetDirection();
                 self->CascadeDirection = Normalize(Vector3(direction.x, 0.0f, direction.z));
             }
@@ -29,6 +29,10 @@
 #include "MeshLOD.h"
 #include "Core/MxObject/MxObject.h"
 #include "Core/Runtime/Reflection.h"
+#include "Core/Resources/MeshOptimizer.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Format/Format.h"
 
 namespace MxEngine
 {
@@ -37,33 +41,21 @@ namespace MxEngine
         if (!this->AutoLODSelection) return;
         auto& object = MxObject::GetByComponent(*this);
         auto meshSource = object.GetComponent<MeshSource>();
-        if (!meshSource.IsValid()) 
+        if (!meshSource.IsValid() || !meshSource->Mesh.IsValid()) 
         {
             this->SetCurrentLOD(0); 
             return;
         }
 
         auto box = meshSource->Mesh->MeshAABB * object.Transform.GetMatrix();
-
-        float distance = Length(box.GetCenter() - viewportPosition);
-        Vector3 length = box.Length();
-        float maxLength = ComponentMax(length);
-        float scaledDistance = maxLength / (distance * viewportZoom);
-
-        // magic numbers which were measured in game to find best distance for each LOD peek
-        constexpr static std::array lodDistance = {
-            0.21f, 0.15f, 0.10f, 0.06f, 0.03f, 0.01f
-        };
-        this->SetCurrentLOD(0);
-        while (this->currentLOD < lodDistance.size() && scaledDistance < lodDistance[this->currentLOD])
-            this->currentLOD++;
-
-        this->SetCurrentLOD(Min(this->currentLOD, this->LODs.size()));
+        float maxLength = ComponentMax(box.Length());
+        this->SetCurrentLOD(MeshLOD::SelectLOD(box.GetCenter(), maxLength, viewportPosition, viewportZoom, this->LODs.size()));
     }
 
     void MeshLOD::SetCurrentLOD(size_t lod)
     {
-        this->currentLOD = (uint8_t)Min(lod, (size_t)Max((int)this->LODs.size() - 1, 0));
+        // level zero is source mesh, so the last LOD has index equal to LODs count
+        this->currentLOD = (uint8_t)Min(lod, this->LODs.size());
     }
 
     size_t MeshLOD::GetCurrentLOD() const
@@ -73,14 +65,185 @@ namespace MxEngine
 
     MeshHandle MeshLOD::GetMeshLOD() const
     {
-        if (this->currentLOD == 0 || this->currentLOD >= this->LODs.size())
+        return this->GetMeshByLOD(this->currentLOD);
+    }
+
+    MeshHandle MeshLOD::GetMeshByLOD(size_t lod) const
+    {
+        if (lod == 0 || lod > this->LODs.size() || !this->LODs[lod - 1].IsValid())
             return MxObject::GetByComponent(*this).GetComponent<MeshSource>()->Mesh;
         else
-            return this->LODs[this->currentLOD - 1];
+            return this->LODs[lod - 1];
+    }
+
+    void MeshLOD::GenerateLODs(const LODChainConfig& config)
+    {
+        this->GenerationConfig = config;
+        this->GenerateLODs();
+    }
+
+    void MeshLOD::GenerateLODs()
+    {
+        this->AutoLODGeneration = true;
+        this->LODs.clear();
+        this->SetCurrentLOD(0);
+        this->generatedFrom = MeshHandle{ };
+        this->UpdateGeneratedLODs();
+    }
+
+    void MeshLOD::UpdateGeneratedLODs()
+    {
+        if (!this->AutoLODGeneration) return;
+
+        // mesh may still be loading asynchronously, in this case LODs are generated when its data is uploaded
+        auto meshSource = MxObject::GetByComponent(*this).GetComponent<MeshSource>();
+        if (!meshSource.IsValid() || !meshSource->Mesh.IsValid() || meshSource->Mesh->GetSubMeshes().empty())
+            return;
+        if (this->generatedFrom == meshSource->Mesh)
+            return;
+
+        MAKE_SCOPE_PROFILER("MeshLOD::GenerateLODs()");
+        const auto& config = this->GenerationConfig;
+        this->LODs.clear();
+        for (float factor : config.IndexFactors)
+        {
+            this->LODs.push_back(MeshLOD::CreateLOD(meshSource->Mesh, factor, config.MaxError, config.AttributeWeight));
+        }
+        this->generatedFrom = meshSource->Mesh;
+        this->SetCurrentLOD(this->currentLOD);
+    }
+
+    MxVector<MeshHandle> MeshLOD::GetLODs() const
+    {
+        // internal meshes are not serialized, so their handles would be dangling after scene is loaded
+        MxVector<MeshHandle> result;
+        if (this->AutoLODGeneration) return result;
+        for (const auto& lod : this->LODs)
+        {
+            if (!lod.IsValid() || !lod->IsInternalEngineResource())
+                result.push_back(lod);
+        }
+        return result;
+    }
+
+    void MeshLOD::SetLODs(const MxVector<MeshHandle>& lods)
+    {
+        this->LODs = lods;
+        this->generatedFrom = MeshHandle{ };
+        this->SetCurrentLOD(this->currentLOD);
+    }
+
+    MeshHandle MeshLOD::CreateLOD(const MeshHandle& mesh, float indexFactor, float maxError, float attributeWeight)
+    {
+        MAKE_SCOPE_PROFILER("MeshLOD::CreateLOD()");
+        MX_ASSERT(mesh.IsValid());
+
+        struct SimplifiedSubMesh
+        {
+            MeshData::VertexData Vertecies;
+            MeshData::IndexData Indicies;
+        };
+        MxVector<SimplifiedSubMesh> simplified;
+        simplified.reserve(mesh->GetSubMeshes().size());
+
+        size_t totalVertexCount = 0, totalIndexCount = 0;
+        float maxResultError = 0.0f;
+        for (const auto& submesh : mesh->GetSubMeshes())
+        {
+            auto& lod = simplified.emplace_back();
+            lod.Vertecies = submesh.Data.GetVerteciesFromGPU();
+            auto indicies = submesh.Data.GetIndiciesFromGPU();
+
+            size_t targetIndexCount = (size_t)(float(indicies.size()) * Clamp(indexFactor, 0.0f, 1.0f)) / 3 * 3;
+            float error = MeshSimplifier::Simplify(lod.Vertecies, indicies, lod.Indicies, targetIndexCount, maxError, attributeWeight);
+            maxResultError = Max(maxResultError, error);
+
+            // simplifier keeps original vertex buffer, so unused vertecies are dropped here
+            MeshOptimizer::Optimize(lod.Vertecies, lod.Indicies);
+
+            totalVertexCount += lod.Vertecies.size();
+            totalIndexCount += lod.Indicies.size();
+        }
+
+        auto result = ResourceFactory::Create<Mesh>();
+        result->ReserveData(totalVertexCount, totalIndexCount);
+
+        size_t vertexOffset = 0, indexOffset = 0;
+        for (size_t i = 0; i < simplified.size(); i++)
+        {
+            const auto& source = mesh->GetSubMeshByIndex(i);
+            auto& lod = simplified[i];
+            MeshData meshData{
+                result->GetVBO(), lod.Vertecies.size(), vertexOffset,
+                result->GetIBO(), lod.Indicies.size(), indexOffset
+            };
+
+            auto& submesh = result->AddSubMesh(source.GetMaterialId(), std::move(meshData));
+            submesh.Name = source.Name;
+            submesh.SetTransform(source.GetTransform());
+            submesh.Data.BufferVertecies(lod.Vertecies);
+            submesh.Data.BufferIndicies(lod.Indicies);
+            submesh.Data.UpdateBoundingGeometry(lod.Vertecies);
+
+            vertexOffset += lod.Vertecies.size();
+            indexOffset += lod.Indicies.size();
+        }
+        result->UpdateBoundingGeometry();
+        result->SetInternalEngineTag(MXENGINE_MAKE_INTERNAL_TAG("lod"));
+
+        MXLOG_DEBUG("MxEngine::MeshLOD", MxFormat("generated LOD with {0} of {1} indicies, error {2:.3f}",
+            totalIndexCount, mesh->GetTotalIndiciesCount(), maxResultError));
+
+        return result;
+    }
+
+    size_t MeshLOD::SelectLOD(const Vector3& center, float size, const Vector3& viewportPosition, float viewportZoom, size_t lodCount)
+    {
+        float distance = Length(center - viewportPosition);
+        float scaledDistance = size / (distance * viewportZoom);
+
+        // magic numbers which were measured in game to find best distance for each LOD peek
+        constexpr static std::array lodDistance = {
+            0.21f, 0.15f, 0.10f, 0.06f, 0.03f, 0.01f
+        };
+        size_t lod = 0;
+        while (lod < lodDistance.size() && scaledDistance < lodDistance[lod])
+            lod++;
+
+        return Min(lod, lodCount);
     }
 
     MXENGINE_REFLECT_TYPE
     {
+        using GenerateLODsFunc = void(MeshLOD::*)();
+
+        rttr::registration::class_<LODChainConfig>("LODChainConfig")
+            (
+                rttr::metadata(MetaInfo::COPY_FUNCTION, Copy<LODChainConfig>)
+            )
+            .constructor<>()
+            (
+                rttr::policy::ctor::as_object
+            )
+            .property("index factors", &LODChainConfig::IndexFactors)
+            (
+                rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE),
+                rttr::metadata(EditorInfo::EDIT_RANGE, Range { 0.0f, 1.0f }),
+                rttr::metadata(EditorInfo::EDIT_PRECISION, 0.01f)
+            )
+            .property("max error", &LODChainConfig::MaxError)
+            (
+                rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE),
+                rttr::metadata(EditorInfo::EDIT_RANGE, Range { 0.0f, 1.0f }),
+                rttr::metadata(EditorInfo::EDIT_PRECISION, 0.001f)
+            )
+            .property("attribute weight", &LODChainConfig::AttributeWeight)
+            (
+                rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE),
+                rttr::metadata(EditorInfo::EDIT_RANGE, Range { 0.0f, 10.0f }),
+                rttr::metadata(EditorInfo::EDIT_PRECISION, 0.001f)
+            );
+
         rttr::registration::class_<MeshLOD>("MeshLOD")
             (
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::CLONE_COPY)
@@ -95,9 +258,22 @@ namespace MxEngine
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE),
                 rttr::metadata(MetaInfo::CONDITION, +([](const rttr::instance& v) { return !v.try_convert<MeshLOD>()->AutoLODSelection; }))
             )
-            .property("lods", &MeshLOD::LODs)
+            .property("auto lod generation", &MeshLOD::AutoLODGeneration)
+            (
+                rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE)
+            )
+            .property("generation config", &MeshLOD::GenerationConfig)
             (
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE)
+            )
+            .method("generate lods", (GenerateLODsFunc)&MeshLOD::GenerateLODs)
+            (
+                rttr::metadata(MetaInfo::FLAGS, MetaInfo::EDITABLE)
+            )
+            .property("lods", &MeshLOD::GetLODs, &MeshLOD::SetLODs)
+            (
+                rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE),
+                rttr::metadata(MetaInfo::CONDITION, +([](const rttr::instance& v) { return !v.try_convert<MeshLOD>()->AutoLODGeneration; }))
             );
     }
 }
\ No newline at end of file
@@ -31,24 +31,96 @@
 #include "Utilities/ECS/Component.h"
 #include "Core/Resources/AssetManager.h"
 #include "MeshSource.h"
+#include "Core/Resources/MeshSimplifier.h"
 
 namespace MxEngine
 {
 
+    /*!
+    parameters of automatic LOD chain generation
+    */
+    struct LODChainConfig
+    {
+        /*!
+        fraction of source mesh indicies which is kept by each LOD, from the most detailed to the least detailed
+        */
+        MxVector<float> IndexFactors = { 0.5f, 0.25f, 0.12f, 0.06f };
+        /*!
+        max simplification error of each LOD relative to submesh size. LOD keeps more indicies than requested if error would be higher
+        */
+        float MaxError = 0.05f;
+        /*!
+        weight of texture coordinate and normal difference in simplification cost
+        */
+        float AttributeWeight = MeshSimplifier::DefaultAttributeWeight;
+    };
+
     class MeshLOD
     {
         MAKE_COMPONENT(MeshLOD);
 
         uint8_t currentLOD = 0;
+        MeshHandle generatedFrom;
     public:
         MeshLOD() = default;
 
         bool AutoLODSelection = true;
+        /*!
+        if set, LODs are generated from MeshSource mesh with GenerationConfig and regenerated each time MeshSource mesh changes.
+        Generated meshes are not serialized, only the config is, so they are created again after scene is loaded
+        */
+        bool AutoLODGeneration = false;
+        LODChainConfig GenerationConfig;
 
         MxVector<MeshHandle> LODs;
         void FixBestLOD(const Vector3& viewportPosition, float viewportZoom = 1.0f);
         void SetCurrentLOD(size_t lod);
         size_t GetCurrentLOD() const;
         MeshHandle GetMeshLOD() const;
+        /*!
+        getter for mesh of LOD level
+        \param lod LOD level, where zero is MeshSource mesh and level `i` is `LODs[i - 1]`
+        \returns mesh of LOD level
+        */
+        MeshHandle GetMeshByLOD(size_t lod) const;
+        /*!
+        replaces LODs with meshes simplified from MeshSource mesh and enables AutoLODGeneration
+        \param config parameters of generated LOD chain, which are stored in GenerationConfig
+        */
+        void GenerateLODs(const LODChainConfig& config);
+        /*!
+        replaces LODs with meshes simplified from MeshSource mesh using GenerationConfig and enables AutoLODGeneration
+        */
+        void GenerateLODs();
+        /*!
+        generates LODs if AutoLODGeneration is set and they were not generated from current MeshSource mesh yet
+        */
+        void UpdateGeneratedLODs();
+        /*!
+        getter for LODs which can be serialized. Generated LODs and other internal engine meshes are not returned
+        \returns LODs set by user or empty list if they are generated
+        */
+        MxVector<MeshHandle> GetLODs() const;
+        void SetLODs(const MxVector<MeshHandle>& lods);
+
+        /*!
+        creates simplified copy of mesh. Submeshes, their materials and transforms are kept, only geometry is reduced
+        \param mesh mesh to simplify
+        \param indexFactor fraction of indicies to keep in each submesh
+        \param maxError max simplification error relative to submesh size
+        \param attributeWeight weight of texture coordinate and normal difference in simplification cost
+        \returns new mesh
+        */
+        static MeshHandle CreateLOD(const MeshHandle& mesh, float indexFactor, float maxError, float attributeWeight = MeshSimplifier::DefaultAttributeWeight);
+        /*!
+        selects LOD level by screen size of object
+        \param center world center of object bounding box
+        \param size largest world size of object bounding box
+        \param viewportPosition position of camera
+        \param viewportZoom zoom of camera
+        \param lodCount number of available LODs (excluding source mesh)
+        \returns LOD level in range [0, lodCount]
+        */
+        static size_t SelectLOD(const Vector3& center, float size, const Vector3& viewportPosition, float viewportZoom, size_t lodCount);
     };
 }
\ No newline at end of file
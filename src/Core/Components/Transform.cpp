@@ -29,8 +29,110 @@
 #include "Transform.h"
 #include "Core/Runtime/Reflection.h"
 
+#include <atomic>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MXENGINE_TRANSFORM_SSE
+#include <xmmintrin.h>
+#endif
+
 namespace MxEngine
 {
+    void ComposeMatrix(const Vector3& position, const Quaternion& q, const Vector3& scale, Matrix4x4& model, Matrix3x3& normal)
+    {
+        float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+        Vector3 column0 = MakeVector3(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy));
+        Vector3 column1 = MakeVector3(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx));
+        Vector3 column2 = MakeVector3(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy));
+
+        model[0] = Vector4(column0 * scale.x, 0.0f);
+        model[1] = Vector4(column1 * scale.y, 0.0f);
+        model[2] = Vector4(column2 * scale.z, 0.0f);
+        model[3] = Vector4(position, 1.0f);
+
+        // inverse transpose of rotation * scale is rotation / scale. Uniformly scaled objects keep model matrix as before,
+        // as displacement mapping in shadow passes depends on normal length
+        Vector3 normalScale = (scale.x == scale.y && scale.y == scale.z) ? scale : 1.0f / scale;
+        normal[0] = column0 * normalScale.x;
+        normal[1] = column1 * normalScale.y;
+        normal[2] = column2 * normalScale.z;
+    }
+
+    void TransformComponent::ComposeMatrices(const Vector3* positions, const Quaternion* rotations, const Vector3* scales, size_t count,
+        Matrix4x4* models, Matrix3x3* normals)
+    {
+        size_t i = 0;
+        #if defined(MXENGINE_TRANSFORM_SSE)
+        // four transforms are processed in SIMD lanes, then matrices are scattered to their places
+        for (; i + 4 <= count; i += 4)
+        {
+            const Quaternion* q = rotations + i;
+            const Vector3* s = scales + i;
+            __m128 qx = _mm_setr_ps(q[0].x, q[1].x, q[2].x, q[3].x);
+            __m128 qy = _mm_setr_ps(q[0].y, q[1].y, q[2].y, q[3].y);
+            __m128 qz = _mm_setr_ps(q[0].z, q[1].z, q[2].z, q[3].z);
+            __m128 qw = _mm_setr_ps(q[0].w, q[1].w, q[2].w, q[3].w);
+
+            __m128 x2 = _mm_add_ps(qx, qx);
+            __m128 y2 = _mm_add_ps(qy, qy);
+            __m128 z2 = _mm_add_ps(qz, qz);
+            __m128 xx = _mm_mul_ps(qx, x2), yy = _mm_mul_ps(qy, y2), zz = _mm_mul_ps(qz, z2);
+            __m128 xy = _mm_mul_ps(qx, y2), xz = _mm_mul_ps(qx, z2), yz = _mm_mul_ps(qy, z2);
+            __m128 wx = _mm_mul_ps(qw, x2), wy = _mm_mul_ps(qw, y2), wz = _mm_mul_ps(qw, z2);
+            __m128 one = _mm_set1_ps(1.0f);
+
+            __m128 rotation[9] = {
+                _mm_sub_ps(one, _mm_add_ps(yy, zz)), _mm_add_ps(xy, wz), _mm_sub_ps(xz, wy),
+                _mm_sub_ps(xy, wz), _mm_sub_ps(one, _mm_add_ps(xx, zz)), _mm_add_ps(yz, wx),
+                _mm_add_ps(xz, wy), _mm_sub_ps(yz, wx), _mm_sub_ps(one, _mm_add_ps(xx, yy)),
+            };
+            __m128 scale[3] = {
+                _mm_setr_ps(s[0].x, s[1].x, s[2].x, s[3].x),
+                _mm_setr_ps(s[0].y, s[1].y, s[2].y, s[3].y),
+                _mm_setr_ps(s[0].z, s[1].z, s[2].z, s[3].z),
+            };
+
+            __m128 isUniform = _mm_and_ps(_mm_cmpeq_ps(scale[0], scale[1]), _mm_cmpeq_ps(scale[1], scale[2]));
+            __m128 normalScale[3];
+            for (size_t k = 0; k < 3; k++)
+            {
+                __m128 inverseScale = _mm_div_ps(one, scale[k]);
+                normalScale[k] = _mm_or_ps(_mm_and_ps(isUniform, scale[k]), _mm_andnot_ps(isUniform, inverseScale));
+            }
+
+            alignas(16) float model[9][4];
+            alignas(16) float normal[9][4];
+            for (size_t k = 0; k < 9; k++)
+            {
+                _mm_store_ps(model[k], _mm_mul_ps(rotation[k], scale[k / 3]));
+                _mm_store_ps(normal[k], _mm_mul_ps(rotation[k], normalScale[k / 3]));
+            }
+
+            for (size_t lane = 0; lane < 4; lane++)
+            {
+                auto& m = models[i + lane];
+                auto& n = normals[i + lane];
+                const auto& position = positions[i + lane];
+                m[0] = MakeVector4(model[0][lane], model[1][lane], model[2][lane], 0.0f);
+                m[1] = MakeVector4(model[3][lane], model[4][lane], model[5][lane], 0.0f);
+                m[2] = MakeVector4(model[6][lane], model[7][lane], model[8][lane], 0.0f);
+                m[3] = MakeVector4(position.x, position.y, position.z, 1.0f);
+                n[0] = MakeVector3(normal[0][lane], normal[1][lane], normal[2][lane]);
+                n[1] = MakeVector3(normal[3][lane], normal[4][lane], normal[5][lane]);
+                n[2] = MakeVector3(normal[6][lane], normal[7][lane], normal[8][lane]);
+            }
+        }
+        #endif
+
+        for (; i < count; i++)
+        {
+            ComposeMatrix(positions[i], rotations[i], scales[i], models[i], normals[i]);
+        }
+    }
+
     bool TransformComponent::operator==(const TransformComponent& other) const
     {
         return this->position == other.position && this->rotation == other.rotation && this->scale == other.scale;
@@ -46,16 +148,40 @@ namespace MxEngine
         TransformComponent result;
         result.scale = this->scale * other.scale;
         result.position = this->position + other.position;
-        result.rotation = this->rotation + other.rotation;
+        result.SetRotation(this->rotation * other.rotation);
         return result;
     }
 
+    uint64_t TransformComponent::NextVersion()
+    {
+        static std::atomic<uint64_t> versionCounter{ 0 };
+        return versionCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    void TransformComponent::Invalidate()
+    {
+        this->needTransformUpdate = true;
+        this->version = TransformComponent::NextVersion();
+    }
+
+    void TransformComponent::SetWorldMatrix(const Matrix4x4& world, const Matrix3x3& normal)
+    {
+        this->transform = world;
+        this->normalMatrix = normal;
+        this->needTransformUpdate = false;
+        this->version = TransformComponent::NextVersion();
+    }
+
+    uint64_t TransformComponent::GetVersion() const
+    {
+        return this->version;
+    }
+
     const Matrix4x4& TransformComponent::GetMatrix() const
     {
         if (this->needTransformUpdate)
         {
-            this->GetMatrix(this->transform);
-            this->GetNormalMatrix(this->transform, this->normalMatrix);
+            ComposeMatrix(this->position, this->rotation, this->scale, this->transform, this->normalMatrix);
             this->needTransformUpdate = false;
         }
         return this->transform;
@@ -67,25 +193,35 @@ namespace MxEngine
         return this->normalMatrix;
     }
 
+    Vector3 TransformComponent::GetWorldPosition() const
+    {
+        return Vector3(this->GetMatrix()[3]);
+    }
+
     void TransformComponent::GetMatrix(Matrix4x4& inPlaceMatrix) const
     {
-        Matrix4x4 Translation = MxEngine::Translate(Matrix4x4(1.0f), this->position);
-        Matrix4x4 Rotation = MakeRotationMatrix(RadiansVec(this->rotation));
-        Matrix4x4 Scale = MxEngine::Scale(Matrix4x4(1.0f), this->scale);
-        inPlaceMatrix = Translation * Rotation * Scale;
+        Matrix3x3 normal;
+        ComposeMatrix(this->position, this->rotation, this->scale, inPlaceMatrix, normal);
     }
 
     void TransformComponent::GetNormalMatrix(const Matrix4x4& model, Matrix3x3& inPlaceMatrix) const
     {
         if (this->scale.x == this->scale.y && this->scale.y == this->scale.z)
+        {
             inPlaceMatrix = Matrix3x3(model);
-        else
-            inPlaceMatrix = Transpose(Inverse(model));
+            return;
+        }
+
+        // model columns are rotation columns multiplied by scale, so dividing them by squared scale leaves rotation / scale
+        Vector3 inverseScale2 = 1.0f / (this->scale * this->scale);
+        inPlaceMatrix[0] = Vector3(model[0]) * inverseScale2.x;
+        inPlaceMatrix[1] = Vector3(model[1]) * inverseScale2.y;
+        inPlaceMatrix[2] = Vector3(model[2]) * inverseScale2.z;
     }
 
     const Vector3& TransformComponent::GetRotation() const
     {
-        return this->rotation;
+        return this->eulerRotation;
     }
 
     const Vector3& TransformComponent::GetScale() const
@@ -93,9 +229,9 @@ namespace MxEngine
         return this->scale;
     }
 
-    Quaternion TransformComponent::GetRotationQuaternion() const
+    const Quaternion& TransformComponent::GetRotationQuaternion() const
     {
-        return MakeQuaternion(MakeRotationMatrix(RadiansVec(this->rotation)));
+        return this->rotation;
     }
 
     const Vector3& TransformComponent::GetPosition() const
@@ -105,12 +241,15 @@ namespace MxEngine
 
     TransformComponent& TransformComponent::SetRotation(const Quaternion& q)
     {
-        return this->SetRotation(DegreesVec(MakeEulerAngles(q)));
+        this->rotation = Normalize(q);
+        this->eulerRotation = DegreesVec(MakeEulerAngles(this->rotation));
+        this->Invalidate();
+        return *this;
     }
 
     TransformComponent& TransformComponent::SetRotation(const Vector3& angles)
     {
-        this->rotation = MakeVector3(0.0f);
+        this->eulerRotation = MakeVector3(0.0f);
         this->Rotate(angles);
         return *this;
     }
@@ -118,7 +257,7 @@ namespace MxEngine
     TransformComponent& TransformComponent::SetScale(const Vector3& scale)
     {
         this->scale = scale;
-        this->needTransformUpdate = true;
+        this->Invalidate();
         return *this;
     }
 
@@ -130,7 +269,7 @@ namespace MxEngine
     TransformComponent& TransformComponent::SetPosition(const Vector3& position)
     {
         this->position = position;
-        this->needTransformUpdate = true;
+        this->Invalidate();
         return *this;
     }
 
@@ -142,7 +281,7 @@ namespace MxEngine
     TransformComponent& TransformComponent::Scale(const Vector3& scale)
     {
         this->scale *= scale;
-        this->needTransformUpdate = true;
+        this->Invalidate();
         return *this;
     }
 
@@ -163,16 +302,18 @@ namespace MxEngine
 
     TransformComponent& TransformComponent::Rotate(const Quaternion& q)
     {
-        return this->Rotate(MakeEulerAngles(q));
+        return this->SetRotation(q * this->rotation);
     }
 
     TransformComponent& TransformComponent::Rotate(const Vector3& angles)
     {
-        this->rotation += angles;
-        this->rotation.x = std::fmod(this->rotation.x, 360.0f);
-        this->rotation.y = std::fmod(this->rotation.y, 360.0f);
-        this->rotation.z = std::fmod(this->rotation.z, 360.0f);
-        this->needTransformUpdate = true;
+        // angles are accumulated as before, so scripts which rotate objects around single axis behave exactly as with Euler storage
+        this->eulerRotation += angles;
+        this->eulerRotation.x = std::fmod(this->eulerRotation.x, 360.0f);
+        this->eulerRotation.y = std::fmod(this->eulerRotation.y, 360.0f);
+        this->eulerRotation.z = std::fmod(this->eulerRotation.z, 360.0f);
+        this->rotation = MakeRotationQuaternion(RadiansVec(this->eulerRotation));
+        this->Invalidate();
         return *this;
     }
 
@@ -194,7 +335,7 @@ namespace MxEngine
     TransformComponent& TransformComponent::Translate(const Vector3& dist)
     {
         this->position += dist;
-        this->needTransformUpdate = true;
+        this->Invalidate();
         return *this;
     }
 
@@ -35,26 +35,77 @@ namespace MxEngine
 	class TransformComponent
 	{
 		Vector3 position = MakeVector3(0.0f);
-		Vector3 rotation = MakeVector3(0.0f);
+		Quaternion rotation = Quaternion(1.0f, 0.0f, 0.0f, 0.0f);
 		Vector3 scale = MakeVector3(1.0f);
+		Vector3 eulerRotation = MakeVector3(0.0f); // in degrees, kept only for editing and Euler-based rotations
 		mutable Matrix4x4 transform{ 0.0f };
 		mutable Matrix3x3 normalMatrix{ 0.0f };
 		mutable bool needTransformUpdate = true;
+		uint64_t version = TransformComponent::NextVersion();
+
+		static uint64_t NextVersion();
+		void Invalidate();
+		void SetWorldMatrix(const Matrix4x4& world, const Matrix3x3& normal);
+
+		friend class TransformHierarchy;
 	public:
 		bool operator==(const TransformComponent& other) const;
 		bool operator!=(const TransformComponent& other) const;
 		TransformComponent operator*(const TransformComponent& other) const;
 
+		/*!
+		getter for transform version. Version is changed on each modification and is unique among all transforms,
+		so equal versions mean equal transforms. Used to detect if data computed from transform must be updated
+		\returns current transform version
+		*/
+		uint64_t GetVersion() const;
+
+		/*!
+		getter for world transformation matrix. For objects attached to parent it also includes parent transform,
+		which is applied by TransformHierarchy once per frame before component updates
+		\returns cached world matrix
+		*/
 		const Matrix4x4& GetMatrix() const;
 		const Matrix3x3& GetNormalMatrix() const;
+		/*!
+		getter for world position, i.e. translation part of world matrix. Unlike GetPosition() it includes parent transform
+		\returns position of object in world space
+		*/
+		Vector3 GetWorldPosition() const;
+		/*!
+		computes local transformation matrix from position, rotation and scale, ignoring parent transform
+		\param inPlaceMatrix matrix to write result to
+		*/
 		void GetMatrix(Matrix4x4& inPlaceMatrix) const;
+		/*!
+		computes normal matrix from model matrix built by GetMatrix(Matrix4x4&). Inverse transpose of rotation * scale
+		is rotation / scale, so no matrix inversion is performed even for non-uniform scale
+		\param model local transformation matrix
+		\param inPlaceMatrix matrix to write result to
+		*/
 		void GetNormalMatrix(const Matrix4x4& model, Matrix3x3& inPlaceMatrix) const;
 
+		/*!
+		composes model and normal matrices of many transforms at once. On SSE-capable targets four transforms are processed per iteration
+		\param positions array of positions
+		\param rotations array of normalized rotations
+		\param scales array of non-zero scales
+		\param count number of transforms in each array
+		\param models array of count matrices to write model matrices to
+		\param normals array of count matrices to write normal matrices to
+		*/
+		static void ComposeMatrices(const Vector3* positions, const Quaternion* rotations, const Vector3* scales, size_t count,
+			Matrix4x4* models, Matrix3x3* normals);
+
 		const Vector3& GetPosition() const;
+		/*!
+		getter for rotation in Euler angles. Rotation is stored as quaternion, angles are kept for editing purposes
+		\returns rotation angles in degrees
+		*/
 		const Vector3& GetRotation() const;
 		const Vector3& GetScale() const;
 
-		Quaternion GetRotationQuaternion() const;
+		const Quaternion& GetRotationQuaternion() const;
 
 		TransformComponent& SetRotation(const Quaternion& q);
 		TransformComponent& SetRotation(const Vector3& angles);
@@ -68,7 +119,15 @@ namespace MxEngine
 		TransformComponent& ScaleY(float scale);
 		TransformComponent& ScaleZ(float scale);
 
+		/*!
+		applies rotation in world space, i.e. new rotation is `q * rotation`
+		\param q normalized rotation to apply
+		*/
 		TransformComponent& Rotate(const Quaternion& q);
+		/*!
+		adds angles to Euler representation of rotation
+		\param angles angles in degrees
+		*/
 		TransformComponent& Rotate(const Vector3& angles);
 		TransformComponent& RotateX(float angle);
 		TransformComponent& RotateY(float angle);
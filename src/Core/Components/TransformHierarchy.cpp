@@ -0,0 +1,274 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "TransformHierarchy.h"
+#include "Utilities/JobSystem/JobSystem.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Logging/Logger.h"
+
+namespace MxEngine
+{
+    bool TransformHierarchy::IsAncestor(const MxObject& ancestor, const MxObject& object) const
+    {
+        auto current = this->links.find(object.GetNativeHandle());
+        while (current != this->links.end())
+        {
+            const auto& parent = current->second.Parent;
+            if (!parent.IsValid()) return false;
+            if (parent->GetNativeHandle() == ancestor.GetNativeHandle()) return true;
+            current = this->links.find(parent->GetNativeHandle());
+        }
+        return false;
+    }
+
+    bool TransformHierarchy::SetParent(const MxObject::Handle& child, const MxObject::Handle& parent)
+    {
+        if (!child.IsValid()) return false;
+        if (!parent.IsValid())
+        {
+            this->RemoveParent(child);
+            return true;
+        }
+
+        if (child->GetNativeHandle() == parent->GetNativeHandle() || this->IsAncestor(*child, *parent))
+        {
+            MXLOG_WARNING("MxEngine::TransformHierarchy", "cannot attach object " + child->Name + " to its own descendant " + parent->Name);
+            return false;
+        }
+
+        this->links[child->GetNativeHandle()] = Link{ child, parent };
+        this->isStructureChanged = true;
+        return true;
+    }
+
+    void TransformHierarchy::RemoveParent(const MxObject::Handle& child)
+    {
+        if (!child.IsValid()) return;
+
+        auto it = this->links.find(child->GetNativeHandle());
+        if (it == this->links.end()) return;
+
+        this->links.erase(it);
+        this->isStructureChanged = true;
+        child->Transform.Invalidate(); // cached world matrix still contains parent transform
+    }
+
+    MxObject::Handle TransformHierarchy::GetParent(const MxObject& child) const
+    {
+        auto it = this->links.find(child.GetNativeHandle());
+        if (it == this->links.end() || !it->second.Parent.IsValid()) return MxObject::Handle{ };
+        return it->second.Parent;
+    }
+
+    void TransformHierarchy::GetChildren(const MxObject& parent, MxVector<MxObject::Handle>& children) const
+    {
+        for (const auto& [handle, link] : this->links)
+        {
+            if (link.Child.IsValid() && link.Parent.IsValid() && link.Parent->GetNativeHandle() == parent.GetNativeHandle())
+                children.push_back(link.Child);
+        }
+    }
+
+    const Matrix4x4& TransformHierarchy::GetWorldMatrix(const MxObject& object) const
+    {
+        size_t index = this->GetNodeIndex(object);
+        return index != InvalidNode ? this->worldMatrices[index] : object.Transform.GetMatrix();
+    }
+
+    size_t TransformHierarchy::GetNodeIndex(const MxObject& object) const
+    {
+        auto it = this->nodeIndices.find(object.GetNativeHandle());
+        return it != this->nodeIndices.end() ? it->second : InvalidNode;
+    }
+
+    ArrayView<const MxObject::Handle> TransformHierarchy::GetObjects() const
+    {
+        return ArrayView<const MxObject::Handle>(this->objects.data(), this->objects.size());
+    }
+
+    ArrayView<const Matrix4x4> TransformHierarchy::GetWorldMatrices() const
+    {
+        return ArrayView<const Matrix4x4>(this->worldMatrices.data(), this->worldMatrices.size());
+    }
+
+    size_t TransformHierarchy::GetDepth() const
+    {
+        return this->levelOffsets.empty() ? 0 : this->levelOffsets.size() - 1;
+    }
+
+    void TransformHierarchy::Clear()
+    {
+        for (auto& [handle, link] : this->links)
+        {
+            if (link.Child.IsValid()) link.Child->Transform.Invalidate();
+        }
+        this->links.clear();
+        this->isStructureChanged = true;
+    }
+
+    void TransformHierarchy::RemoveDanglingLinks()
+    {
+        // destroyed parents leave their children detached, destroyed children are simply forgotten
+        for (auto it = this->links.begin(); it != this->links.end();)
+        {
+            auto& link = it->second;
+            if (link.Child.IsValid() && link.Parent.IsValid())
+            {
+                it++;
+                continue;
+            }
+
+            if (link.Child.IsValid()) link.Child->Transform.Invalidate();
+            it = this->links.erase(it);
+            this->isStructureChanged = true;
+        }
+    }
+
+    void TransformHierarchy::Rebuild()
+    {
+        MAKE_SCOPE_PROFILER("TransformHierarchy::Rebuild");
+
+        // depth of each object is found by walking up parent links until object with known depth or root is met
+        MxHashMap<MxObject::EngineHandle, size_t> depths;
+        MxVector<MxObject::Handle> unordered;
+        MxVector<size_t> unorderedDepths;
+        MxVector<MxObject::Handle> chain;
+        size_t maxDepth = 0;
+
+        for (const auto& [handle, link] : this->links)
+        {
+            chain.clear();
+            MxObject::Handle current = link.Child;
+            size_t depth = 0;
+            while (true)
+            {
+                auto known = depths.find(current->GetNativeHandle());
+                if (known != depths.end())
+                {
+                    depth = known->second + 1;
+                    break;
+                }
+                chain.push_back(current);
+
+                auto parentLink = this->links.find(current->GetNativeHandle());
+                if (parentLink == this->links.end()) break; // root is reached
+                current = parentLink->second.Parent;
+            }
+
+            for (auto it = chain.rbegin(); it != chain.rend(); it++, depth++)
+            {
+                depths[(*it)->GetNativeHandle()] = depth;
+                unordered.push_back(*it);
+                unorderedDepths.push_back(depth);
+                maxDepth = Max(maxDepth, depth);
+            }
+        }
+
+        // counting sort by depth, so each level is stored contiguously and parents precede children
+        size_t nodeCount = unordered.size();
+        this->levelOffsets.assign(nodeCount > 0 ? maxDepth + 2 : 0, 0);
+        for (size_t depth : unorderedDepths)
+            this->levelOffsets[depth + 1]++;
+        for (size_t level = 1; level < this->levelOffsets.size(); level++)
+            this->levelOffsets[level] += this->levelOffsets[level - 1];
+
+        MxVector<size_t> levelCursors(this->levelOffsets.begin(), this->levelOffsets.end());
+        this->objects.resize(nodeCount);
+        this->nodeIndices.clear();
+        for (size_t i = 0; i < nodeCount; i++)
+        {
+            size_t index = levelCursors[unorderedDepths[i]]++;
+            this->objects[index] = unordered[i];
+            this->nodeIndices[unordered[i]->GetNativeHandle()] = index;
+        }
+
+        this->parents.resize(nodeCount);
+        for (size_t i = 0; i < nodeCount; i++)
+        {
+            auto link = this->links.find(this->objects[i]->GetNativeHandle());
+            this->parents[i] = link != this->links.end() ? this->nodeIndices[link->second.Parent->GetNativeHandle()] : InvalidNode;
+        }
+
+        // zero version never matches real one, so all nodes are recomputed on first update
+        this->localVersions.assign(nodeCount, 0);
+        this->worldMatrices.resize(nodeCount);
+        this->dirtyFlags.assign(nodeCount, 0);
+        this->isStructureChanged = false;
+    }
+
+    void TransformHierarchy::UpdateNode(size_t index)
+    {
+        auto& transform = this->objects[index]->Transform;
+        size_t parent = this->parents[index];
+
+        bool isParentDirty = parent != InvalidNode && this->dirtyFlags[parent];
+        bool isDirty = isParentDirty || transform.GetVersion() != this->localVersions[index];
+        this->dirtyFlags[index] = isDirty;
+        if (!isDirty) return;
+
+        if (parent == InvalidNode)
+        {
+            this->worldMatrices[index] = transform.GetMatrix();
+        }
+        else
+        {
+            Matrix4x4 local;
+            Matrix3x3 localNormal;
+            transform.GetMatrix(local);
+            transform.GetNormalMatrix(local, localNormal);
+            auto& world = this->worldMatrices[index];
+            world = this->worldMatrices[parent] * local;
+            // normal matrices follow the same rule as ComposeMatrix() and are composed like model matrices,
+            // so uniformly scaled chains keep model 3x3 and no inversion is needed
+            const auto& parentNormal = this->objects[parent]->Transform.GetNormalMatrix();
+            transform.SetWorldMatrix(world, parentNormal * localNormal);
+        }
+        this->localVersions[index] = transform.GetVersion();
+    }
+
+    void TransformHierarchy::Update(JobSystemImpl& jobSystem)
+    {
+        MAKE_SCOPE_PROFILER("TransformHierarchy::Update");
+
+        this->RemoveDanglingLinks();
+        if (this->isStructureChanged) this->Rebuild();
+
+        // nodes of one level depend only on previous levels, so each level is split between worker threads
+        constexpr size_t GrainSize = 256;
+        for (size_t level = 0; level < this->GetDepth(); level++)
+        {
+            size_t levelBegin = this->levelOffsets[level];
+            size_t levelEnd = this->levelOffsets[level + 1];
+            jobSystem.ParallelForRange(levelEnd - levelBegin, GrainSize, [this, levelBegin](size_t begin, size_t end)
+            {
+                for (size_t i = levelBegin + begin; i < levelBegin + end; i++)
+                    this->UpdateNode(i);
+            });
+        }
+    }
+}
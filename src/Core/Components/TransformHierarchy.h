@@ -0,0 +1,135 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/MxObject/MxObject.h"
+#include "Utilities/STL/MxVector.h"
+#include "Utilities/STL/MxHashMap.h"
+#include "Utilities/Array/ArrayView.h"
+
+namespace MxEngine
+{
+    class JobSystemImpl;
+
+    /*!
+    parent-child relations between objects. Nodes are stored as arrays sorted by depth, so parents always precede their children.
+    Once per frame changes of local transforms are propagated top-down in one linear pass, where each depth level is processed in parallel.
+    Resulting world matrices are written back to transforms of child objects, so GetMatrix() of child already includes parent transform
+    */
+    class TransformHierarchy
+    {
+    public:
+        static constexpr size_t InvalidNode = std::numeric_limits<size_t>::max();
+    private:
+        struct Link
+        {
+            MxObject::Handle Child;
+            MxObject::Handle Parent;
+        };
+
+        // structure as set by user, nodes are rebuilt from it only when it changes
+        MxHashMap<MxObject::EngineHandle, Link> links;
+        bool isStructureChanged = false;
+
+        MxVector<MxObject::Handle> objects;
+        MxVector<size_t> parents;
+        MxVector<uint64_t> localVersions;
+        MxVector<Matrix4x4> worldMatrices;
+        MxVector<uint8_t> dirtyFlags;
+        MxVector<size_t> levelOffsets;
+        MxHashMap<MxObject::EngineHandle, size_t> nodeIndices;
+
+        void RemoveDanglingLinks();
+        void Rebuild();
+        void UpdateNode(size_t index);
+        bool IsAncestor(const MxObject& ancestor, const MxObject& object) const;
+    public:
+        /*!
+        attaches object to parent. Current local transform of child becomes relative to parent
+        \param child object to attach
+        \param parent new parent of object. Cannot be child itself or any of its descendants
+        \returns true if object was attached, false if attachment would create cycle
+        */
+        bool SetParent(const MxObject::Handle& child, const MxObject::Handle& parent);
+        /*!
+        detaches object from its parent, so its transform becomes world transform again
+        \param child object to detach
+        */
+        void RemoveParent(const MxObject::Handle& child);
+        /*!
+        getter for object parent
+        \param child object which parent is requested
+        \returns parent handle or invalid handle if object has no parent
+        */
+        MxObject::Handle GetParent(const MxObject& child) const;
+        /*!
+        collects direct children of object
+        \param parent object which children are requested
+        \param children vector to append children to
+        */
+        void GetChildren(const MxObject& parent, MxVector<MxObject::Handle>& children) const;
+        /*!
+        getter for world matrix of object, computed by last Update() call
+        \param object any object, not necessary attached to hierarchy
+        \returns world matrix of object
+        */
+        const Matrix4x4& GetWorldMatrix(const MxObject& object) const;
+        /*!
+        getter for node index of object
+        \param object object to search for
+        \returns index in GetObjects() and GetWorldMatrices() arrays or InvalidNode if object is not in hierarchy
+        */
+        size_t GetNodeIndex(const MxObject& object) const;
+        /*!
+        getter for all objects in hierarchy (both parents and children), sorted by depth
+        \returns view over object handles
+        */
+        ArrayView<const MxObject::Handle> GetObjects() const;
+        /*!
+        getter for world matrices of all objects in hierarchy, in same order as GetObjects()
+        \returns view over contiguous array of world matrices
+        */
+        ArrayView<const Matrix4x4> GetWorldMatrices() const;
+        /*!
+        getter for number of levels in hierarchy
+        \returns number of levels, zero if no objects are attached
+        */
+        size_t GetDepth() const;
+
+        /*!
+        propagates transform changes from parents to children and updates world matrices. Should be called once per frame before component updates
+        \param jobSystem job system used to process large levels in parallel
+        */
+        void Update(JobSystemImpl& jobSystem);
+        /*!
+        detaches all objects
+        */
+        void Clear();
+    };
+}
@@ -100,8 +100,12 @@ namespace MxEngine
         FromJson(config.PointLightTextureSize,  json["renderer"],    "point-light-texture-size");
         FromJson(config.SpotLightTextureSize,   json["renderer"],    "spot-light-texture-size" );
         FromJson(config.EngineTextureSize,      json["renderer"],    "engine-texture-size"     );
+        FromJson(config.WorkerThreadCount,      json["threading"  ], "worker-count"            );
+        FromJson(config.AssetLoaderThreadCount, json["threading"  ], "asset-loader-count"      );
+        FromJson(config.AssetUploadBudget,      json["threading"  ], "asset-upload-budget"     );
         FromJson(config.IgnoredFolders,         json["filesystem" ], "ignored-folders"         );
         FromJson(config.CachePrimitiveModels,   json["filesystem" ], "cache-primitives"        );
+        FromJson(config.CookAssetsOnLoad,       json["filesystem" ], "cook-assets-on-load"     );
         FromJson(config.ShaderSourceDirectory,  json["debug-build"], "shader-source-directory" );
         FromJson(config.ApplicationCloseKey,    json["debug-build"], "app-close-key"           );
         FromJson(config.Style,                  json["debug-build"], "editor-style"            );
@@ -126,8 +130,12 @@ namespace MxEngine
         json["renderer"   ]["point-light-texture-size"] = config.PointLightTextureSize;
         json["renderer"   ]["spot-light-texture-size" ] = config.SpotLightTextureSize;
         json["renderer"   ]["engine-texture-size"     ] = config.EngineTextureSize;
+        json["threading"  ]["worker-count"            ] = config.WorkerThreadCount;
+        json["threading"  ]["asset-loader-count"      ] = config.AssetLoaderThreadCount;
+        json["threading"  ]["asset-upload-budget"     ] = config.AssetUploadBudget;
         json["filesystem" ]["ignored-folders"         ] = config.IgnoredFolders;
         json["filesystem" ]["cache-primitives"        ] = config.CachePrimitiveModels;
+        json["filesystem" ]["cook-assets-on-load"     ] = config.CookAssetsOnLoad;
         json["debug-build"]["shader-source-directory" ] = config.ShaderSourceDirectory;
         json["debug-build"]["app-close-key"           ] = config.ApplicationCloseKey;
         json["debug-build"]["editor-style"            ] = config.Style;
@@ -89,8 +89,14 @@ namespace MxEngine
         size_t SpotLightTextureSize = 512;
         size_t EngineTextureSize = 512;
 
+        // Multithreading settings
+        size_t WorkerThreadCount = 0;
+        size_t AssetLoaderThreadCount = 1;
+        float AssetUploadBudget = 4.0f; // milliseconds per frame
+
         // Filesystem settings
         MxVector<MxString> IgnoredFolders = { "MxEngine", "out", "build", ".git", ".vs" };
+        bool CookAssetsOnLoad = true;
 
         // Debug settings
         MxString ShaderSourceDirectory = "../../src/Platform/OpenGL/Shaders";
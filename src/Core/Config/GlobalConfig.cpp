@@ -111,6 +111,21 @@ namespace MxEngine
         return CFG(EngineTextureSize);
     }
 
+    size_t GlobalConfig::GetWorkerThreadCount()
+    {
+        return CFG(WorkerThreadCount);
+    }
+
+    size_t GlobalConfig::GetAssetLoaderThreadCount()
+    {
+        return CFG(AssetLoaderThreadCount);
+    }
+
+    float GlobalConfig::GetAssetUploadBudget()
+    {
+        return CFG(AssetUploadBudget);
+    }
+
     const MxVector<MxString>& GlobalConfig::GetIgnoredFolders()
     {
         return CFG(IgnoredFolders);
@@ -141,6 +156,11 @@ namespace MxEngine
         return CFG(CachePrimitiveModels);
     }
 
+    bool GlobalConfig::HasCookAssetsOnLoad()
+    {
+        return CFG(CookAssetsOnLoad);
+    }
+
     KeyCode GlobalConfig::GetApplicationCloseKey()
     {
         return CFG(ApplicationCloseKey);
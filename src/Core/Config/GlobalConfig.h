@@ -49,12 +49,16 @@ namespace MxEngine
         static size_t GetPointLightTextureSize();
         static size_t GetSpotLightTextureSize();
         static size_t GetEngineTextureSize();
+        static size_t GetWorkerThreadCount();
+        static size_t GetAssetLoaderThreadCount();
+        static float GetAssetUploadBudget();
         static const MxVector<MxString>& GetIgnoredFolders();
         static const MxString& GetShaderSourceDirectory();
         static EditorStyle GetEditorStyle();
         static bool HasGraphicAPIDebug();
         static bool HasAutoRecompileFiles();
         static bool HasCachePrimitiveModels();
+        static bool HasCookAssetsOnLoad();
         static KeyCode GetApplicationCloseKey();
         static KeyCode GetEditorOpenKey();
         static KeyCode GetRecompileFilesKey();
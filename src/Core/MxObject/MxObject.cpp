@@ -60,7 +60,10 @@ namespace MxEngine
 		for (auto& resource : factory)
 		{
 			if (resource.value.Name == name)
-				return MxObject::Handle{ resource.uuid, factory.IndexOf(resource) };
+			{
+				size_t index = factory.IndexOf(resource);
+				return MxObject::Handle{ index, factory.GetGeneration(index) };
+			}
 		}
 		return MxObject::Handle{ };
 	}
@@ -75,7 +78,7 @@ namespace MxEngine
 		MX_ASSERT(handle != InvalidHandle);
 		auto& managedObject = Factory::Get<MxObject>()[handle];
 		MX_ASSERT(managedObject.refCount > 0 && managedObject.uuid != UUIDGenerator::GetNull());
-		return MxObject::Handle(managedObject.uuid, handle);
+		return MxObject::Handle(handle, Factory::Get<MxObject>().GetGeneration(handle));
 	}
 
     MxObject::EngineHandle MxObject::GetNativeHandle() const
@@ -85,6 +88,6 @@ namespace MxEngine
 
     MxObject::~MxObject()
     {
-		this->components.RemoveAllComponents();
+		this->components.RemoveAllComponents(this->handle);
     }
 }
\ No newline at end of file
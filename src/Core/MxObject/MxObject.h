@@ -61,7 +61,7 @@ namespace MxEngine
 		MxObject(const MxObject&) = delete;
 		MxObject& operator=(const MxObject&) = delete;
 		MxObject(MxObject&&) = default;
-		MxObject& operator=(MxObject&&) = default;
+		MxObject& operator=(MxObject&&) = delete;
 		~MxObject();
 
 		static Handle Create();
@@ -94,7 +94,8 @@ namespace MxEngine
 		template<typename T, typename... Args>
 		auto AddComponent(Args&&... args)
 		{
-			auto component = this->components.AddComponent<T>(std::forward<Args>(args)...);
+			MX_ASSERT(this->handle != InvalidHandle);
+			auto component = this->components.AddComponent<T>(this->handle, std::forward<Args>(args)...);
 			component->UserData = reinterpret_cast<void*>(this->handle);
 			if constexpr (has_method_Init<T>::value) 
 				component->Init();
@@ -104,7 +105,7 @@ namespace MxEngine
 		template<typename T>
 		auto GetComponent() const
 		{
-			return this->components.GetComponent<T>();
+			return this->components.GetComponent<T>(this->handle);
 		}
 
 		template<typename T>
@@ -119,13 +120,13 @@ namespace MxEngine
 		template<typename T>
 		void RemoveComponent()
 		{
-			this->components.RemoveComponent<T>();
+			this->components.RemoveComponent<T>(this->handle);
 		}
 
 		template<typename T>
 		bool HasComponent() const
 		{
-			return this->components.HasComponent<T>();
+			return this->components.HasComponent<T>(this->handle);
 		}
 
 		template<typename T>
@@ -101,6 +101,13 @@ namespace MxEngine
         environment.DefaultShadowCubeMap->SetInternalEngineTag(MXENGINE_MAKE_INTERNAL_TAG("default shadow cubemap"));
         environment.DefaultSkybox->SetInternalEngineTag(MXENGINE_MAKE_INTERNAL_TAG("default skybox cubemap"));
 
+        // uniform buffers shared by all shaders. Material buffer stores one entry per material unit, each aligned for BindBaseRange()
+        environment.CameraUniforms = GraphicFactory::Create<UniformBuffer>((CameraUniformBlock*)nullptr, 1, UsageType::DYNAMIC_DRAW);
+        environment.DirLightUniforms = GraphicFactory::Create<UniformBuffer>((DirLightUniformBlock*)nullptr, 1, UsageType::DYNAMIC_DRAW);
+        environment.MaterialUniforms = GraphicFactory::Create<UniformBuffer>((uint8_t*)nullptr, 0, UsageType::DYNAMIC_DRAW);
+        size_t uniformAlignment = environment.MaterialUniforms->GetBindRangeAlignment();
+        environment.MaterialUniformStride = (sizeof(MaterialUniformBlock) + uniformAlignment - 1) / uniformAlignment * uniformAlignment;
+
         environment.AverageWhiteTexture = GraphicFactory::Create<Texture>();
         environment.AverageWhiteTexture->Load(nullptr, internalTextureSize, internalTextureSize, 1, false, TextureFormat::R16F);
         environment.AverageWhiteTexture->SetMinLOD(environment.AverageWhiteTexture->GetMaxTextureLOD());
@@ -298,7 +305,7 @@ namespace MxEngine
         float viewportZoom = 0.0f;
         if (this->Viewport.IsValid())
         {
-            viewportPosition = MxObject::GetByComponent(*this->Viewport).Transform.GetPosition();
+            viewportPosition = MxObject::GetByComponent(*this->Viewport).Transform.GetWorldPosition();
             viewportZoom = this->Viewport->Camera.GetZoom();
         }
 
@@ -342,14 +349,12 @@ namespace MxEngine
         }
 
         // submit render units
-        auto meshSourceView = ComponentFactory::GetView<MeshSource>();
+        auto meshSourceView = ComponentFactory::GetView<MeshSource, MeshRenderer>();
         {
             MAKE_SCOPE_PROFILER("RenderAdaptor::SubmitMeshPrimitives()");
-            for (const auto& meshSource : meshSourceView)
+            for (auto [meshSource, meshRenderer] : meshSourceView)
             {
                 auto& object = MxObject::GetByComponent(meshSource);
-                auto& transform = object.Transform;
-                auto meshRenderer = object.GetComponent<MeshRenderer>();
                 auto meshLOD = object.GetComponent<MeshLOD>();
                 auto instances = object.GetComponent<InstanceFactory>();
 
@@ -359,25 +364,25 @@ namespace MxEngine
                 bool castsShadow = meshSource.CastsShadow;
                 bool ignoresDepth = meshSource.IgnoresDepth;
 
-                if (!meshSource.IsDrawn || !meshRenderer.IsValid() || !mesh.IsValid()) continue;
+                if (!meshSource.IsDrawn || !mesh.IsValid()) continue;
 
-                // we do not try to use LODs for instanced objects, as its quite hard and time consuming. TODO: fix this
-                if (meshLOD.IsValid() && instanceCount == 0)
+                auto* instanceFactory = instances.IsValid() ? instances.GetUnchecked() : nullptr;
+                if (meshLOD.IsValid()) meshLOD->UpdateGeneratedLODs();
+
+                if (instanceCount > 0)
+                {
+                    // each instance selects its own LOD, object itself is always submitted with source mesh
+                    instanceFactory->UpdateInstanceLODs(meshLOD.IsValid() ? meshLOD.GetUnchecked() : nullptr, viewportPosition, viewportZoom);
+                }
+                else if (meshLOD.IsValid())
                 {
                     meshLOD->FixBestLOD(viewportPosition, viewportZoom);
                     mesh = meshLOD->GetMeshLOD();
                 }
 
-                size_t renderGroupIndex = this->Renderer.SubmitRenderGroup(*mesh, instanceCount);
-                for (const auto& submesh : mesh->GetSubMeshes())
-                {
-                    auto materialId = submesh.GetMaterialId();
-                    if (materialId >= meshRenderer->Materials.size()) continue;
-                    auto material = meshRenderer->Materials[materialId];
-
-                    this->Renderer.SubmitRenderUnit(renderGroupIndex, submesh, *material, transform, castsShadow, ignoresDepth, object.Name.c_str());
-                }
+                this->Renderer.GetRenderScene().SubmitMesh(this->Renderer, object, mesh, meshRenderer, castsShadow, ignoresDepth, instanceFactory);
             }
+            this->Renderer.GetRenderScene().EndSubmission();
         }
 
         {
@@ -391,7 +396,7 @@ namespace MxEngine
                     continue;
 
                 auto& transform = MxObject::GetByComponent(particleSystem).Transform;
-                this->Renderer.SubmitParticleSystem(particleSystem, *meshRenderer->GetMaterial(), transform);
+                this->Renderer.SubmitParticleSystem(particleSystem, meshRenderer->GetMaterial(), transform);
             }
         }
 
@@ -440,6 +445,10 @@ namespace MxEngine
         }
 
         this->Renderer.GetRenderStatistics().ResetAll();
+        auto& scene = this->Renderer.GetRenderScene();
+        this->Renderer.GetRenderStatistics().AddEntry("render scene rebuilt units", scene.GetRebuiltUnitCount());
+        this->Renderer.GetRenderStatistics().AddEntry("render scene tree height", scene.GetTree().GetHeight());
+        scene.ResetStatistics();
         this->Renderer.StartPipeline();
     }
 
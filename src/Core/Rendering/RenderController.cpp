@@ -43,17 +43,36 @@
 #include "Utilities/Profiler/Profiler.h"
 #include "Platform/Compute/Compute.h"
 #include "RenderUtilities/ShadowMapGenerator.h"
+#include "RenderUtilities/VisibilityCuller.h"
+
+#include <cstring>
 
 namespace MxEngine
 {
-	constexpr size_t MaxDirLightCount = 4;
+	constexpr size_t MaxDirLightCount = DirLightUniformBlock::MaxLightCount;
+	constexpr ShaderBase::UniformHandle LightDepthMapUniforms[MaxDirLightCount] = {
+		MAKE_UNIFORM_HANDLE("lightDepthMaps[0]"),
+		MAKE_UNIFORM_HANDLE("lightDepthMaps[1]"),
+		MAKE_UNIFORM_HANDLE("lightDepthMaps[2]"),
+		MAKE_UNIFORM_HANDLE("lightDepthMaps[3]"),
+	};
 	constexpr size_t ParticleComputeGroupSize = 64;
 
+	void RenderController::SortRenderLists()
+	{
+		MAKE_SCOPE_PROFILER("RenderController::SortRenderLists()");
+		for (RenderList* list : { &this->Pipeline.ShadowCasters, &this->Pipeline.TransparentObjects, &this->Pipeline.OpaqueObjects, &this->Pipeline.DepthIgnoreObjects })
+		{
+			SortDrawCommands(list->Commands, this->Pipeline.FrameMemory);
+		}
+	}
+
 	void RenderController::PrepareShadowMaps()
 	{
 		MAKE_SCOPE_PROFILER("RenderController::PrepareShadowMaps()");
 
-		ShadowMapGenerator generator(this->Pipeline.ShadowCasters, this->Pipeline.RenderUnits, this->Pipeline.MaterialUnits);
+		ShadowMapGenerator generator(this->Pipeline.ShadowCasters, this->Pipeline.RenderGroups, this->Pipeline.RenderUnits, 
+			this->Pipeline.MaterialUnits, this->Pipeline.UnitBounds, this->Scene, this->Pipeline.ShadowVisibility, this->Pipeline.InstanceVisibility);
 
 		{
 			MAKE_SCOPE_PROFILER("RenderController::PrepareDirectionalLightMaps()");
@@ -169,41 +188,74 @@ namespace MxEngine
 		}
 	}
 
+	void RenderController::PrepareInstances(const FrustrumCuller& culler)
+	{
+		MAKE_SCOPE_PROFILER("RenderController::PrepareInstances()");
+		MxEngine::PrepareInstances(this->Pipeline.RenderGroups, this->Pipeline.InstanceVisibility,
+			[&culler](const AABBArrayView& boxes, size_t count, MxVector<uint64_t>& visibility)
+			{
+				ComputeVisibility(culler, boxes, count, visibility);
+			});
+
+		for (const auto& group : this->Pipeline.RenderGroups)
+		{
+			if (group.Instances == nullptr) continue;
+			this->Pipeline.Statistics.AddEntry("drawn instances", group.VisibleInstanceCount);
+			this->Pipeline.Statistics.AddEntry("culled instances", group.InstanceCount - Min(group.VisibleInstanceCount, group.InstanceCount));
+		}
+	}
+
 	void RenderController::DrawObjects(const CameraUnit& camera, const Shader& shader, const RenderList& objects)
 	{
 		MAKE_SCOPE_PROFILER("RenderController::DrawObjects()");
 
-		if (objects.UnitsIndex.empty()) return;
+		if (objects.Commands.empty()) return;
 		shader.Bind();
-		shader.IgnoreNonExistingUniform("camera.position");
-		shader.IgnoreNonExistingUniform("camera.invViewProjMatrix");
-		this->BindCameraInformation(camera, shader);
-		shader.SetUniform("gamma", camera.Gamma);
-
-		size_t currentUnit = 0;
-		for (const auto& group : objects.Groups)
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("gamma"), camera.Gamma);
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("map_albedo"), 0);
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("map_metallic"), 1);
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("map_roughness"), 2);
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("map_emmisive"), 3);
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("map_normal"), 4);
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("map_height"), 5);
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("map_occlusion"), 6);
+
+		// commands are sorted by VAO and material, so state is changed only when it differs from previous command
+		constexpr size_t InvalidIndex = std::numeric_limits<size_t>::max();
+		size_t boundVAO = InvalidIndex;
+		size_t boundMaterial = InvalidIndex;
+
+		for (const auto& command : objects.Commands)
 		{
-			if (group.unitCount == 0) continue;
-			bool isInstanced = group.InstanceCount > 0;
-
-			group.VAO->Bind();
-			for (size_t i = 0; i < group.unitCount; i++, currentUnit++)
+			const auto& group = this->Pipeline.RenderGroups[command.GroupIndex];
+			const auto& unit = this->Pipeline.RenderUnits[command.UnitIndex];
+			bool isInstanced = group.Instances != nullptr;
+			bool isUnitVisible = isInstanced ? group.VisibleInstanceCount > 0 : IsUnitVisible(this->Pipeline.CameraVisibility, command.UnitIndex);
+			this->Pipeline.Statistics.AddEntry(isUnitVisible ? "drawn objects" : "culled objects", 1);
+			if (!isUnitVisible) continue;
+
+			if (group.VAO.GetHandle() != boundVAO)
 			{
-				const auto& unit = this->Pipeline.RenderUnits[objects.UnitsIndex[currentUnit]];
-				bool isUnitVisible = isInstanced || camera.Culler.IsAABBVisible(unit.MinAABB, unit.MaxAABB);
-				this->Pipeline.Statistics.AddEntry(isUnitVisible ? "drawn objects" : "culled objects", 1);
-
-				if (isUnitVisible) this->DrawObject(unit, group.InstanceCount, shader);
+				group.VAO->Bind();
+				boundVAO = group.VAO.GetHandle();
+				this->Pipeline.Statistics.AddEntry("VAO binds", 1);
 			}
+			if (unit.materialIndex != boundMaterial)
+			{
+				this->BindMaterial(unit.materialIndex);
+				boundMaterial = unit.materialIndex;
+				this->Pipeline.Statistics.AddEntry("material binds", 1);
+			}
+			this->DrawObject(unit, group.VisibleInstanceCount, shader);
 		}
 	}
 
-	void RenderController::DrawObject(const RenderUnit& unit, size_t instanceCount, const Shader& shader)
+	void RenderController::BindMaterial(size_t materialIndex)
 	{
+		const auto& material = this->Pipeline.MaterialUnits[materialIndex];
 		Texture::TextureBindId textureBindIndex = 0;
-		const auto& material = this->Pipeline.MaterialUnits[unit.materialIndex];
-		shader.IgnoreNonExistingUniform("material.transparency");
 
+		// texture units are the same for all materials, so sampler uniforms are set once in DrawObjects()
 		material.AlbedoMap->Bind(textureBindIndex++);
 		material.MetallicMap->Bind(textureBindIndex++);
 		material.RoughnessMap->Bind(textureBindIndex++);
@@ -212,22 +264,13 @@ namespace MxEngine
 		material.HeightMap->Bind(textureBindIndex++);
 		material.AmbientOcclusionMap->Bind(textureBindIndex++);
 
-		shader.SetUniform("map_albedo", material.AlbedoMap->GetBoundId());
-		shader.SetUniform("map_metallic", material.MetallicMap->GetBoundId());
-		shader.SetUniform("map_roughness", material.RoughnessMap->GetBoundId());
-		shader.SetUniform("map_emmisive", material.EmissiveMap->GetBoundId());
-		shader.SetUniform("map_normal", material.NormalMap->GetBoundId());
-		shader.SetUniform("map_height", material.HeightMap->GetBoundId());
-		shader.SetUniform("map_occlusion", material.AmbientOcclusionMap->GetBoundId());
-
-		shader.SetUniform("material.roughness", material.RoughnessFactor);
-		shader.SetUniform("material.metallic", material.MetallicFactor);
-		shader.SetUniform("material.emmisive", material.Emission);
-		shader.SetUniform("material.transparency", material.Transparency);
+		this->BindMaterialUniforms(materialIndex);
+	}
 
-		shader.SetUniform("displacement", material.Displacement);
-		shader.SetUniform("uvMultipliers", material.UVMultipliers);
-		shader.SetUniform("color", material.BaseColor);
+	void RenderController::DrawObject(const RenderUnit& unit, size_t instanceCount, const Shader& shader)
+	{
+		const auto& material = this->Pipeline.MaterialUnits[unit.materialIndex];
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("displacement"), material.Displacement * unit.DisplacementScale);
 
 		this->GetRenderEngine().SetDefaultVertexAttribute(5, unit.ModelMatrix); //-V807
 		this->GetRenderEngine().SetDefaultVertexAttribute(9, unit.NormalMatrix);
@@ -277,11 +320,9 @@ namespace MxEngine
 		ssaoShader->Bind();
 		ssaoShader->IgnoreNonExistingUniform("materialTex");
 		ssaoShader->IgnoreNonExistingUniform("albedoTex");
-		ssaoShader->IgnoreNonExistingUniform("camera.position");
 
 		Texture::TextureBindId textureId = 0;
 		this->BindGBuffer(camera, *ssaoShader, textureId);
-		this->BindCameraInformation(camera, *ssaoShader);
 
 		ssaoShader->SetUniform("sampleCount", (int)camera.SSAO->GetSampleCount());
 		ssaoShader->SetUniform("radius", camera.SSAO->GetRadius());
@@ -381,43 +422,13 @@ namespace MxEngine
 		auto& shader = this->Pipeline.Environment.Shaders["DirLight"_id];
 		shader->Bind();
 
-		shader->IgnoreNonExistingUniform("camera.viewProjMatrix");
-		shader->IgnoreNonExistingUniform("camera.position");
 		shader->IgnoreNonExistingUniform("albedoTex");
 		shader->IgnoreNonExistingUniform("materialTex");
 
 		Texture::TextureBindId textureId = 0;
 		this->BindGBuffer(camera, *shader, textureId);
-		this->BindCameraInformation(camera, *shader);
-
-		// submit directional light information
-		constexpr size_t MaxDirLightCount = 4;
-		const auto& dirLights = this->Pipeline.Lighting.DirectionalLights;
-		size_t lightCount = Min(MaxDirLightCount, dirLights.size());
-
-		shader->SetUniform("lightCount", (int)lightCount);
-
-		for (size_t i = 0; i < lightCount; i++)
-		{
-			auto& dirLight = this->Pipeline.Lighting.DirectionalLights[i];
-
-			Vector4 colorPacked = Vector4(dirLight.Color * dirLight.Intensity, dirLight.AmbientIntensity);
-			dirLight.ShadowMap->Bind(textureId++);
-			shader->SetUniform(MxFormat("lights[{}].color", i), colorPacked);
-			shader->SetUniform(MxFormat("lights[{}].direction", i), dirLight.Direction);
-			shader->SetUniform(MxFormat("lightDepthMaps[{}]", i), dirLight.ShadowMap->GetBoundId());
-
-			for (size_t j = 0; j < dirLight.BiasedProjectionMatrices.size(); j++)
-			{
-				shader->SetUniform(MxFormat("lights[{}].transform[{}]", i, j), dirLight.BiasedProjectionMatrices[j]);
-			}
-		}
-
-		this->Pipeline.Environment.DefaultShadowMap->Bind(textureId);
-		for (size_t i = lightCount; i < MaxDirLightCount; i++)
-		{
-			shader->SetUniform(MxFormat("lightDepthMaps[{}]", i), this->Pipeline.Environment.DefaultShadowMap->GetBoundId());
-		}
+		// light parameters are taken from uniform buffer uploaded in StartPipeline()
+		this->BindDirLightShadowMaps(*shader, textureId);
 
 		this->RenderToTextureNoClear(output, shader);
 	}
@@ -445,45 +456,15 @@ namespace MxEngine
 
 	void RenderController::DrawTransparentObjects(CameraUnit& camera)
 	{
-		if (this->Pipeline.TransparentObjects.UnitsIndex.empty()) return;
+		if (this->Pipeline.TransparentObjects.Commands.empty()) return;
 		MAKE_SCOPE_PROFILER("RenderController::DrawTransparentObjects()");
 
 		auto& shader = this->Pipeline.Environment.Shaders["Transparent"_id];
 		shader->Bind();
 
-		shader->SetUniform("viewportPosition", camera.ViewportPosition);
-		shader->SetUniform("gamma", camera.Gamma);
-
 		Texture::TextureBindId textureId = Material::TextureCount;
 		this->BindSkyboxInformation(camera, *shader, textureId);
-
-		// submit directional light information
-		const auto& dirLights = this->Pipeline.Lighting.DirectionalLights;
-		size_t lightCount = Min(MaxDirLightCount, dirLights.size());
-
-		shader->SetUniform("lightCount", (int)lightCount);
-
-		for (size_t i = 0; i < lightCount; i++)
-		{
-			auto& dirLight = this->Pipeline.Lighting.DirectionalLights[i];
-
-			Vector4 colorPacked = Vector4(dirLight.Color * dirLight.Intensity, dirLight.AmbientIntensity);
-			dirLight.ShadowMap->Bind(textureId++);
-			shader->SetUniform(MxFormat("lights[{}].color", i), colorPacked);
-			shader->SetUniform(MxFormat("lights[{}].direction", i), dirLight.Direction);
-			shader->SetUniform(MxFormat("lightDepthMaps[{}]", i), dirLight.ShadowMap->GetBoundId());
-
-			for (size_t j = 0; j < dirLight.BiasedProjectionMatrices.size(); j++)
-			{
-				shader->SetUniform(MxFormat("lights[{}].transform[{}]", i, j), dirLight.BiasedProjectionMatrices[j]);
-			}
-		}
-
-		this->Pipeline.Environment.DefaultShadowMap->Bind(textureId);
-		for (size_t i = lightCount; i < MaxDirLightCount; i++)
-		{
-			shader->SetUniform(MxFormat("lightDepthMaps[{}]", i), this->Pipeline.Environment.DefaultShadowMap->GetBoundId());
-		}
+		this->BindDirLightShadowMaps(*shader, textureId);
 
 		this->DrawObjects(camera, *shader, this->Pipeline.TransparentObjects);
 	}
@@ -494,11 +475,9 @@ namespace MxEngine
 
 		auto shader = this->Pipeline.Environment.Shaders["IBL"_id];
 		shader->Bind();
-		shader->IgnoreNonExistingUniform("camera.viewProjMatrix");
 		Texture::TextureBindId textureId = 0;
 
 		this->BindGBuffer(camera, *shader, textureId);
-		this->BindCameraInformation(camera, *shader);
 		this->BindSkyboxInformation(camera, *shader, textureId);
 		
 		shader->SetUniform("gamma", camera.Gamma);
@@ -515,15 +494,12 @@ namespace MxEngine
 
 		auto fogShader = this->Pipeline.Environment.Shaders["Fog"_id];
 		fogShader->Bind();
-		fogShader->IgnoreNonExistingUniform("camera.viewProjMatrix");
 		fogShader->IgnoreNonExistingUniform("normalTex");
 		fogShader->IgnoreNonExistingUniform("albedoTex");
 		fogShader->IgnoreNonExistingUniform("materialTex");
 
 		Texture::TextureBindId textureId = 0;
 		this->BindGBuffer(camera, *fogShader, textureId);
-		this->BindFogInformation(camera, *fogShader);
-		this->BindCameraInformation(camera, *fogShader);
 
 		input->Bind(textureId++);
 		fogShader->SetUniform("cameraOutput", input->GetBoundId());
@@ -564,7 +540,6 @@ namespace MxEngine
 		
 		Texture::TextureBindId textureId = 0;
 		this->BindGBuffer(camera, *SSRShader, textureId);
-		this->BindCameraInformation(camera, *SSRShader);
 
 		SSRShader->SetUniform("thickness", camera.SSR->GetThickness());
 		SSRShader->SetUniform("startDistance", camera.SSR->GetStartDistance());
@@ -602,11 +577,9 @@ namespace MxEngine
 		SSGIShader->IgnoreNonExistingUniform("albedoTex");
 		SSGIShader->IgnoreNonExistingUniform("normalTex");
 		SSGIShader->IgnoreNonExistingUniform("materialTex");
-		SSGIShader->IgnoreNonExistingUniform("camera.position");
 
 		Texture::TextureBindId textureId = 0;
 		this->BindGBuffer(camera, *SSGIShader, textureId);
-		this->BindCameraInformation(camera, *SSGIShader);
 
 		input->Bind(textureId++);
 		SSGIShader->SetUniform("inputTex", input->GetBoundId());
@@ -728,7 +701,6 @@ namespace MxEngine
 
 		auto shader = this->Pipeline.Environment.Shaders["SpotLight"_id];
 		shader->Bind();
-		shader->IgnoreNonExistingUniform("camera.position");
 		shader->IgnoreNonExistingUniform("albedoTex");
 		shader->IgnoreNonExistingUniform("materialTex");
 
@@ -740,7 +712,6 @@ namespace MxEngine
 
 		Texture::TextureBindId textureId = 0;
 		this->BindGBuffer(camera, *shader, textureId);
-		this->BindCameraInformation(camera, *shader);
 		
 		shader->SetUniform("lightDepthMap", textureId);
 
@@ -773,7 +744,6 @@ namespace MxEngine
 
 		auto shader = this->Pipeline.Environment.Shaders["PointLight"_id];
 		shader->Bind();
-		shader->IgnoreNonExistingUniform("camera.position");
 		shader->IgnoreNonExistingUniform("albedoTex");
 		shader->IgnoreNonExistingUniform("materialTex");
 
@@ -785,7 +755,6 @@ namespace MxEngine
 
 		Texture::TextureBindId textureId = 0;
 		this->BindGBuffer(camera, *shader, textureId);
-		this->BindCameraInformation(camera, *shader);
 
 		shader->SetUniform("lightDepthMap", textureId);
 
@@ -815,14 +784,12 @@ namespace MxEngine
 
 		auto shader = this->Pipeline.Environment.Shaders["PointLight"_id];
 		shader->Bind();
-		shader->IgnoreNonExistingUniform("camera.position");
 		shader->IgnoreNonExistingUniform("albedoTex");
 		shader->IgnoreNonExistingUniform("materialTex");
 		auto viewportSize = MakeVector2((float)camera.OutputTexture->GetWidth(), (float)camera.OutputTexture->GetHeight());
 
 		Texture::TextureBindId textureId = 0;
 		this->BindGBuffer(camera, *shader, textureId);
-		this->BindCameraInformation(camera, *shader);
 
 		this->Pipeline.Environment.DefaultShadowCubeMap->Bind(textureId++);
 
@@ -846,14 +813,12 @@ namespace MxEngine
 
 		auto shader = this->Pipeline.Environment.Shaders["SpotLight"_id];
 		shader->Bind();
-		shader->IgnoreNonExistingUniform("camera.position");
 		shader->IgnoreNonExistingUniform("albedoTex");
 		shader->IgnoreNonExistingUniform("materialTex");
 		auto viewportSize = MakeVector2((float)camera.OutputTexture->GetWidth(), (float)camera.OutputTexture->GetHeight());
 
 		Texture::TextureBindId textureId = 0;
 		this->BindGBuffer(camera, *shader, textureId);
-		this->BindCameraInformation(camera, *shader);
 
 		this->Pipeline.Environment.DefaultShadowCubeMap->Bind(textureId++);
 
@@ -869,14 +834,6 @@ namespace MxEngine
 		this->DrawIndicies(RenderPrimitive::TRIANGLES, instancedSpotLights.GetIndexCount(), 0, instancedSpotLights.Instances.size());
 	}
 
-	void RenderController::BindFogInformation(const CameraUnit& camera, const Shader& shader)
-	{
-		MX_ASSERT(camera.Effects != nullptr);
-		shader.SetUniform("fog.distance", camera.Effects->GetFogDistance());
-		shader.SetUniform("fog.density", camera.Effects->GetFogDensity());
-		shader.SetUniform("fog.color", camera.Effects->GetFogColor());
-	}
-
 	void RenderController::AttachDefaultVAO()
 	{
 		// simular to default framebuffer, we simply unbind any VAO to set it
@@ -889,18 +846,100 @@ namespace MxEngine
 		camera.SkyboxTexture->Bind(startId++);
 		camera.IrradianceTexture->Bind(startId++);
 		this->Pipeline.Environment.EnvironmentBRDFLUT->Bind(startId++);
-		shader.SetUniform("environment.skybox", camera.SkyboxTexture->GetBoundId());
-		shader.SetUniform("environment.irradiance", camera.IrradianceTexture->GetBoundId());
-		shader.SetUniform("environment.envBRDFLUT", this->Pipeline.Environment.EnvironmentBRDFLUT->GetBoundId());
-		shader.SetUniform("environment.skyboxRotation", camera.InversedSkyboxRotation);
-		shader.SetUniform("environment.intensity", camera.SkyboxIntensity);
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("environment.skybox"), camera.SkyboxTexture->GetBoundId());
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("environment.irradiance"), camera.IrradianceTexture->GetBoundId());
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("environment.envBRDFLUT"), this->Pipeline.Environment.EnvironmentBRDFLUT->GetBoundId());
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("environment.skyboxRotation"), camera.InversedSkyboxRotation);
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("environment.intensity"), camera.SkyboxIntensity);
+	}
+
+	void RenderController::UploadCameraUniforms(const CameraUnit& camera)
+	{
+		CameraUniformBlock block;
+		block.ViewProjMatrix = camera.ViewProjectionMatrix;
+		block.InvViewProjMatrix = camera.InverseViewProjMatrix;
+		block.Position = camera.ViewportPosition;
+		block.FogDistance = camera.Effects != nullptr ? camera.Effects->GetFogDistance() : 0.0f;
+		block.FogColor = camera.Effects != nullptr ? camera.Effects->GetFogColor() : Vector3(0.0f);
+		block.FogDensity = camera.Effects != nullptr ? camera.Effects->GetFogDensity() : 0.0f;
+
+		auto& uniforms = this->Pipeline.Environment.CameraUniforms;
+		uniforms->BufferSubData(&block, 1);
+		uniforms->BindBase(CameraUniformBlock::Binding);
+	}
+
+	void RenderController::UploadDirLightUniforms()
+	{
+		const auto& dirLights = this->Pipeline.Lighting.DirectionalLights;
+		size_t lightCount = Min(MaxDirLightCount, dirLights.size());
+
+		DirLightUniformBlock block{ };
+		block.LightCount = (int)lightCount;
+		for (size_t i = 0; i < lightCount; i++)
+		{
+			const auto& dirLight = dirLights[i];
+			auto& light = block.Lights[i];
+			light.Color = Vector4(dirLight.Color * dirLight.Intensity, dirLight.AmbientIntensity);
+			light.Direction = dirLight.Direction;
+			for (size_t j = 0; j < dirLight.BiasedProjectionMatrices.size(); j++)
+				light.Transform[j] = dirLight.BiasedProjectionMatrices[j];
+		}
+
+		auto& uniforms = this->Pipeline.Environment.DirLightUniforms;
+		uniforms->BufferSubData(&block, 1);
+		uniforms->BindBase(DirLightUniformBlock::Binding);
 	}
 
-	void RenderController::BindCameraInformation(const CameraUnit& camera, const Shader& shader)
+	void RenderController::UploadMaterialUniforms()
 	{
-		shader.SetUniform("camera.position", camera.ViewportPosition);
-		shader.SetUniform("camera.viewProjMatrix", camera.ViewProjectionMatrix);
-		shader.SetUniform("camera.invViewProjMatrix", camera.InverseViewProjMatrix);
+		MAKE_SCOPE_PROFILER("RenderController::UploadMaterialUniforms()");
+		const auto& materials = this->Pipeline.MaterialUnits;
+		size_t stride = this->Pipeline.Environment.MaterialUniformStride;
+		auto& data = this->Pipeline.MaterialUniformData;
+		data.resize(materials.size() * stride);
+
+		for (size_t i = 0; i < materials.size(); i++)
+		{
+			// materials not submitted in this frame are never bound, so their entries may stay outdated
+			if (this->Pipeline.MaterialUnitsFrame[i] != this->Pipeline.FrameIndex) continue;
+			const auto& material = materials[i];
+
+			MaterialUniformBlock block{ };
+			block.Color = material.BaseColor;
+			block.Emmisive = material.Emission;
+			block.UVMultipliers = material.UVMultipliers;
+			block.Roughness = material.RoughnessFactor;
+			block.Metallic = material.MetallicFactor;
+			block.Transparency = material.Transparency;
+			std::memcpy(data.data() + i * stride, &block, sizeof(block));
+		}
+
+		if (!data.empty())
+			this->Pipeline.Environment.MaterialUniforms->BufferSubDataWithResize(data.data(), data.size());
+	}
+
+	void RenderController::BindMaterialUniforms(size_t materialIndex)
+	{
+		size_t stride = this->Pipeline.Environment.MaterialUniformStride;
+		this->Pipeline.Environment.MaterialUniforms->BindBaseRange(MaterialUniformBlock::Binding, materialIndex * stride, sizeof(MaterialUniformBlock));
+	}
+
+	void RenderController::BindDirLightShadowMaps(const Shader& shader, Texture::TextureBindId& startId)
+	{
+		const auto& dirLights = this->Pipeline.Lighting.DirectionalLights;
+		size_t lightCount = Min(MaxDirLightCount, dirLights.size());
+
+		for (size_t i = 0; i < lightCount; i++)
+		{
+			dirLights[i].ShadowMap->Bind(startId++);
+			shader.SetUniform(LightDepthMapUniforms[i], dirLights[i].ShadowMap->GetBoundId());
+		}
+
+		this->Pipeline.Environment.DefaultShadowMap->Bind(startId);
+		for (size_t i = lightCount; i < MaxDirLightCount; i++)
+		{
+			shader.SetUniform(LightDepthMapUniforms[i], this->Pipeline.Environment.DefaultShadowMap->GetBoundId());
+		}
 	}
 
 	void RenderController::BindGBuffer(const CameraUnit& camera, const Shader& shader, Texture::TextureBindId& startId)
@@ -910,10 +949,10 @@ namespace MxEngine
 		camera.MaterialTexture->Bind(startId++);
 		camera.DepthTexture->Bind(startId++);
 
-		shader.SetUniform("albedoTex", camera.AlbedoTexture->GetBoundId());
-		shader.SetUniform("normalTex", camera.NormalTexture->GetBoundId());
-		shader.SetUniform("materialTex", camera.MaterialTexture->GetBoundId());
-		shader.SetUniform("depthTex", camera.DepthTexture->GetBoundId());
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("albedoTex"), camera.AlbedoTexture->GetBoundId());
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("normalTex"), camera.NormalTexture->GetBoundId());
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("materialTex"), camera.MaterialTexture->GetBoundId());
+		shader.SetUniform(MAKE_UNIFORM_HANDLE("depthTex"), camera.DepthTexture->GetBoundId());
 	}
 
 	const Renderer& RenderController::GetRenderEngine() const
@@ -1170,6 +1209,21 @@ namespace MxEngine
 		return this->Pipeline.Statistics;
 	}
 
+	const RenderScene& RenderController::GetRenderScene() const
+	{
+		return this->Scene;
+	}
+
+	RenderScene& RenderController::GetRenderScene()
+	{
+		return this->Scene;
+	}
+
+	size_t RenderController::GetRenderUnitCount() const
+	{
+		return this->Pipeline.RenderUnits.size();
+	}
+
 	void RenderController::ResetPipeline()
 	{
 		this->Pipeline.Lighting.DirectionalLights.clear();
@@ -1177,23 +1231,38 @@ namespace MxEngine
 		this->Pipeline.Lighting.SpotLightsInstanced.Instances.clear();
 		this->Pipeline.Lighting.PointLights.clear();
 		this->Pipeline.Lighting.SpotLights.clear();
-		this->Pipeline.ShadowCasters.Groups.clear();
-		this->Pipeline.ShadowCasters.UnitsIndex.clear();
-		this->Pipeline.TransparentObjects.Groups.clear();
-		this->Pipeline.TransparentObjects.UnitsIndex.clear();
-		this->Pipeline.OpaqueObjects.Groups.clear();
-		this->Pipeline.OpaqueObjects.UnitsIndex.clear();
-		this->Pipeline.DepthIgnoreObjects.Groups.clear();
-		this->Pipeline.DepthIgnoreObjects.UnitsIndex.clear();
-		this->Pipeline.RenderUnits.clear();
 		this->Pipeline.OpaqueParticleSystems.clear();
 		this->Pipeline.TransparentParticleSystems.clear();
-		this->Pipeline.MaterialUnits.clear();
-		this->Pipeline.Cameras.clear();
+
+		// per-frame containers drop their storage and start allocating from next arena buffer
+		auto& arena = this->Pipeline.FrameMemory;
+		arena.NextFrame();
+		for (RenderList* list : { &this->Pipeline.ShadowCasters, &this->Pipeline.TransparentObjects, &this->Pipeline.OpaqueObjects, &this->Pipeline.DepthIgnoreObjects })
+		{
+			ResetFrameContainer(list->Commands, arena);
+		}
+		ResetFrameContainer(this->Pipeline.RenderGroups, arena);
+		ResetFrameContainer(this->Pipeline.RenderUnits, arena);
+		for (FrameVector<float>* bounds : { &this->Pipeline.UnitBounds.CenterX, &this->Pipeline.UnitBounds.CenterY, &this->Pipeline.UnitBounds.CenterZ,
+			&this->Pipeline.UnitBounds.ExtentX, &this->Pipeline.UnitBounds.ExtentY, &this->Pipeline.UnitBounds.ExtentZ })
+		{
+			ResetFrameContainer(*bounds, arena);
+		}
+		ResetFrameContainer(this->Pipeline.Cameras, arena);
+
+		// material copies are kept between frames, but the ones not used in this frame release their textures
+		for (size_t i = 0; i < this->Pipeline.MaterialUnits.size(); i++)
+		{
+			if (this->Pipeline.MaterialUnitsFrame[i] != this->Pipeline.FrameIndex)
+				this->Pipeline.MaterialUnits[i] = Material{ };
+		}
+		this->Pipeline.FrameIndex++;
 	}
 
-	void RenderController::SubmitParticleSystem(const ParticleSystem& system, const Material& material, const TransformComponent& parentTransform)
+	void RenderController::SubmitParticleSystem(const ParticleSystem& system, const MaterialHandle& materialHandle, const TransformComponent& parentTransform)
 	{
+		size_t materialIndex = this->SubmitMaterial(materialHandle);
+		const auto& material = this->Pipeline.MaterialUnits[materialIndex];
 		if (material.Transparency == 0.0f) return;
 		bool isTransparent = material.Transparency < 1.0f;
 
@@ -1203,12 +1272,9 @@ namespace MxEngine
 		particleSystem.Fading = system.GetFading();
 		particleSystem.IsRelative = system.IsRelative();
 		particleSystem.InvocationCount = system.GetMaxParticleCount() / ParticleComputeGroupSize;
-		particleSystem.MaterialIndex = this->Pipeline.MaterialUnits.size();
+		particleSystem.MaterialIndex = materialIndex;
 
 		parentTransform.GetMatrix(particleSystem.Transform);
-		
-		auto& materialCopy = this->Pipeline.MaterialUnits.emplace_back(material);
-		if (!materialCopy.AlbedoMap.IsValid()) materialCopy.AlbedoMap = this->Pipeline.Environment.DefaultMaterialMap;
 	}
 
 	void RenderController::SubmitLightSource(const DirectionalLight& light, const TransformComponent& parentTransform)
@@ -1217,6 +1283,7 @@ namespace MxEngine
 		MX_ASSERT(dirLight.ProjectionMatrices.size() == DirectionalLight::TextureCount);
 		MX_ASSERT(dirLight.BiasedProjectionMatrices.size() == DirectionalLight::TextureCount);
 
+		Vector3 worldPosition = parentTransform.GetWorldPosition();
 		dirLight.AmbientIntensity = light.GetAmbientIntensity();
 		dirLight.Intensity = light.GetIntensity();
 		dirLight.Color = light.GetColor();
@@ -1239,13 +1306,14 @@ namespace MxEngine
 		dirLight.ShadowMap = light.DepthMap;
 		for (size_t i = 0; i < dirLight.ProjectionMatrices.size(); i++)
 		{
-			dirLight.ProjectionMatrices[i] = light.GetMatrix(parentTransform.GetPosition(), i);
+			dirLight.ProjectionMatrices[i] = light.GetMatrix(worldPosition, i);
 			dirLight.BiasedProjectionMatrices[i] = ProjectionBiasMatrix(i) * dirLight.ProjectionMatrices[i];
 		}
 	}
 
 	void RenderController::SubmitLightSource(const PointLight& light, const TransformComponent& parentTransform)
 	{
+		Vector3 worldPosition = parentTransform.GetWorldPosition();
 		PointLightBaseData* baseLightData = nullptr;
 		if (light.IsCastingShadows())
 		{
@@ -1254,7 +1322,7 @@ namespace MxEngine
 
 			pointLight.ShadowMap = light.DepthMap;
 			for (size_t i = 0; i < std::size(pointLight.ProjectionMatrices); i++)
-				pointLight.ProjectionMatrices[i] = light.GetMatrix(i, parentTransform.GetPosition());
+				pointLight.ProjectionMatrices[i] = light.GetMatrix(i, worldPosition);
 		}
 		else
 		{
@@ -1264,21 +1332,22 @@ namespace MxEngine
 
 		baseLightData->AmbientIntensity = light.GetAmbientIntensity();
 		baseLightData->Color = light.GetIntensity() * light.GetColor();
-		baseLightData->Position = parentTransform.GetPosition();
+		baseLightData->Position = worldPosition;
 		baseLightData->Radius = light.GetRadius();
-		baseLightData->Transform = light.GetSphereTransform(parentTransform.GetPosition());
+		baseLightData->Transform = light.GetSphereTransform(worldPosition);
 	}
 
 	void RenderController::SubmitLightSource(const SpotLight& light, const TransformComponent& parentTransform)
 	{
+		Vector3 worldPosition = parentTransform.GetWorldPosition();
 		SpotLightBaseData* baseLightData = nullptr;
 		if (light.IsCastingShadows())
 		{
 			auto& spotLight = this->Pipeline.Lighting.SpotLights.emplace_back();
 			baseLightData = &spotLight;
 
-			spotLight.ProjectionMatrix = light.GetMatrix(parentTransform.GetPosition());
-			spotLight.BiasedProjectionMatrix = MakeBiasMatrix() * light.GetMatrix(parentTransform.GetPosition());
+			spotLight.ProjectionMatrix = light.GetMatrix(worldPosition);
+			spotLight.BiasedProjectionMatrix = MakeBiasMatrix() * light.GetMatrix(worldPosition);
 			spotLight.ShadowMap = light.DepthMap;
 		}
 		else
@@ -1289,8 +1358,8 @@ namespace MxEngine
 
 		baseLightData->AmbientIntensity = light.GetAmbientIntensity();
 		baseLightData->Color = light.GetIntensity() * light.GetColor();
-		baseLightData->Position = parentTransform.GetPosition();
-		baseLightData->Transform = light.GetPyramidTransform(parentTransform.GetPosition());
+		baseLightData->Position = worldPosition;
+		baseLightData->Transform = light.GetPyramidTransform(worldPosition);
 		baseLightData->InnerAngle = light.GetInnerCos();
 		baseLightData->OuterAngle = light.GetOuterCos();
 		// pack max distance to normalized direction vector (see spotlight vertex shader)
@@ -1301,11 +1370,12 @@ namespace MxEngine
 		const Skybox* skybox, const CameraEffects* effects, const CameraToneMapping* toneMapping, const CameraSSR* ssr, const CameraSSGI* ssgi, const CameraSSAO* ssao)
 	{
 		auto& camera = this->Pipeline.Cameras.emplace_back();
+		Vector3 worldPosition = parentTransform.GetWorldPosition();
 
-		camera.ViewportPosition           = parentTransform.GetPosition();
+		camera.ViewportPosition           = worldPosition;
 		camera.AspectRatio                = controller.Camera.GetAspectRatio();
 		camera.StaticViewProjectionMatrix = controller.GetMatrix(MakeVector3(0.0f));
-		camera.ViewProjectionMatrix       = controller.GetMatrix(parentTransform.GetPosition());
+		camera.ViewProjectionMatrix       = controller.GetMatrix(worldPosition);
 		camera.InverseViewProjMatrix      = Inverse(camera.ViewProjectionMatrix);
 		camera.Culler                     = controller.GetFrustrumCuller();
 		camera.IsPerspective              = controller.GetCameraType() == CameraType::PERSPECTIVE;
@@ -1332,94 +1402,120 @@ namespace MxEngine
 		camera.SSAO                       = ssao;
 	}
 
-	size_t RenderController::SubmitRenderGroup(const Mesh& mesh, size_t instanceCount)
+	size_t RenderController::SubmitRenderGroup(const Mesh& mesh, InstanceFactory* instances, size_t lodLevel)
 	{
-		size_t renderGroupIndex = this->Pipeline.OpaqueObjects.Groups.size();
+		size_t renderGroupIndex = this->Pipeline.RenderGroups.size();
+		bool isInstanced = instances != nullptr && instances->GetCount() > 0;
+		// instances of one factory are split between groups of its LOD meshes
+		size_t instanceCount = isInstanced ? instances->GetLODInstanceCount(lodLevel) : 0;
 
-		std::array groupSubTypes = {
-			std::ref(this->Pipeline.OpaqueObjects.Groups.emplace_back()),
-			std::ref(this->Pipeline.TransparentObjects.Groups.emplace_back()),
-			std::ref(this->Pipeline.ShadowCasters.Groups.emplace_back()),
-			std::ref(this->Pipeline.DepthIgnoreObjects.Groups.emplace_back()),
-		};
+		auto& group = this->Pipeline.RenderGroups.emplace_back();
+		group.VAO = mesh.GetVAO();
+		group.InstanceCount = instanceCount;
+		// visible instance count is computed for each camera or light before drawing
+		group.VisibleInstanceCount = 0;
+		group.Instances = isInstanced ? instances : nullptr;
+		group.LODLevel = lodLevel;
 
-		for (auto subType : groupSubTypes)
+		return renderGroupIndex;
+	}
+
+	size_t RenderController::SubmitMaterial(const MaterialHandle& material)
+	{
+		MX_ASSERT(material.IsValid());
+		size_t materialIndex = material.GetHandle();
+		if (materialIndex >= this->Pipeline.MaterialUnits.size())
 		{
-			subType.get().VAO = mesh.GetVAO();
-			subType.get().InstanceCount = instanceCount;
-			subType.get().unitCount = 0;
+			this->Pipeline.MaterialUnits.resize(materialIndex + 1);
+			this->Pipeline.MaterialUnitsFrame.resize(materialIndex + 1, 0);
 		}
 
-		return renderGroupIndex;
+		// material copy is refreshed only once per frame, no matter how many units use it
+		if (this->Pipeline.MaterialUnitsFrame[materialIndex] == this->Pipeline.FrameIndex)
+			return materialIndex;
+		this->Pipeline.MaterialUnitsFrame[materialIndex] = this->Pipeline.FrameIndex;
+
+		auto& renderMaterial = this->Pipeline.MaterialUnits[materialIndex];
+		renderMaterial = *material; // create a copy of material for future work
+
+		if (renderMaterial.RoughnessMap.IsValid())         renderMaterial.RoughnessFactor = 1.0f;
+		if (renderMaterial.MetallicMap.IsValid())          renderMaterial.MetallicFactor = 1.0f;
+
+		// set default textures if they are not exist
+		if (!renderMaterial.AlbedoMap.IsValid())           renderMaterial.AlbedoMap = this->Pipeline.Environment.DefaultMaterialMap;
+		if (!renderMaterial.RoughnessMap.IsValid())        renderMaterial.RoughnessMap = this->Pipeline.Environment.DefaultMaterialMap;
+		if (!renderMaterial.MetallicMap.IsValid())         renderMaterial.MetallicMap = this->Pipeline.Environment.DefaultMaterialMap;
+		if (!renderMaterial.EmissiveMap.IsValid())         renderMaterial.EmissiveMap = this->Pipeline.Environment.DefaultMaterialMap;
+		if (!renderMaterial.AmbientOcclusionMap.IsValid()) renderMaterial.AmbientOcclusionMap = this->Pipeline.Environment.DefaultMaterialMap;
+		if (!renderMaterial.NormalMap.IsValid())           renderMaterial.NormalMap = this->Pipeline.Environment.DefaultNormalMap;
+		if (!renderMaterial.HeightMap.IsValid())           renderMaterial.HeightMap = this->Pipeline.Environment.DefaultBlackMap;
+
+		return materialIndex;
 	}
 
-	void RenderController::SubmitRenderUnit(size_t renderGroupIndex, const SubMesh& submesh, const Material& material, const TransformComponent& parentTransform, bool castsShadow, bool ignoresDepth, const char* debugName)
+	void RenderController::SubmitRenderUnit(size_t renderGroupIndex, const RenderUnit& unit, const MaterialHandle& material, bool castsShadow, bool ignoresDepth, const char* debugName)
 	{
-		bool isInvisible = material.Transparency == 0.0f;
-		bool isTransparent = material.Transparency < 1.0f;
+		size_t materialIndex = this->SubmitMaterial(material);
+		const auto& renderMaterial = this->Pipeline.MaterialUnits[materialIndex];
+
+		bool isInvisible = renderMaterial.Transparency == 0.0f;
+		bool isTransparent = renderMaterial.Transparency < 1.0f;
 		if (isInvisible) return;
 
 		size_t unitIndex = this->Pipeline.RenderUnits.size();
-		auto& renderUnit = this->Pipeline.RenderUnits.emplace_back();
-
-		renderUnit.materialIndex = this->Pipeline.MaterialUnits.size();
-		renderUnit.IndexCount = submesh.Data.GetIndiciesCount();
-		renderUnit.IndexOffset = submesh.Data.GetIndiciesOffset();
-		renderUnit.ModelMatrix = parentTransform.GetMatrix() * submesh.GetTransform().GetMatrix(); //-V807
-		renderUnit.NormalMatrix = parentTransform.GetNormalMatrix() * submesh.GetTransform().GetNormalMatrix();
+		auto& renderUnit = this->Pipeline.RenderUnits.emplace_back(unit);
+		renderUnit.materialIndex = materialIndex;
 
 		#if defined(MXENGINE_DEBUG)
 		renderUnit.DebugName = debugName;
 		#endif
 
-		// compute aabb of primitive object for later frustrum culling
-		auto aabb = submesh.Data.GetAABB() * renderUnit.ModelMatrix;
-		renderUnit.MinAABB = aabb.Min;
-		renderUnit.MaxAABB = aabb.Max;
+		// bounding boxes are stored separately as structure of arrays for batch culling
+		Vector3 center = 0.5f * (renderUnit.MinAABB + renderUnit.MaxAABB);
+		Vector3 extent = 0.5f * (renderUnit.MaxAABB - renderUnit.MinAABB);
+		auto& bounds = this->Pipeline.UnitBounds;
+		bounds.CenterX.push_back(center.x);
+		bounds.CenterY.push_back(center.y);
+		bounds.CenterZ.push_back(center.z);
+		bounds.ExtentX.push_back(extent.x);
+		bounds.ExtentY.push_back(extent.y);
+		bounds.ExtentZ.push_back(extent.z);
+
+		// depth is measured from main camera, as all cameras share same draw commands
+		float depth = 0.0f;
+		const auto& cameras = this->Pipeline.Cameras;
+		if (!cameras.empty())
+		{
+			size_t cameraIndex = this->Pipeline.Environment.MainCameraIndex < cameras.size() ? this->Pipeline.Environment.MainCameraIndex : 0;
+			depth = Length(center - cameras[cameraIndex].ViewportPosition);
+		}
+
+		size_t vaoIndex = this->Pipeline.RenderGroups[renderGroupIndex].VAO.GetHandle();
+		DrawCommand command;
+		command.UnitIndex = (uint32_t)unitIndex;
+		command.GroupIndex = (uint32_t)renderGroupIndex;
 
 		if (castsShadow)
 		{
-			auto& shadowCasters = this->Pipeline.ShadowCasters;
-			shadowCasters.Groups[renderGroupIndex].unitCount++;
-			shadowCasters.UnitsIndex.push_back(unitIndex);
+			command.SortKey = MakeOpaqueSortKey(DrawPass::SHADOW_CASTERS, vaoIndex, materialIndex, 0.0f);
+			this->Pipeline.ShadowCasters.Commands.push_back(command);
 		}
 
 		if (ignoresDepth)
 		{
-			auto& depthIgnoreObjects = this->Pipeline.DepthIgnoreObjects;
-			depthIgnoreObjects.Groups[renderGroupIndex].unitCount++;
-			depthIgnoreObjects.UnitsIndex.push_back(unitIndex);
+			command.SortKey = MakeOpaqueSortKey(DrawPass::DEPTH_IGNORE_OBJECTS, vaoIndex, materialIndex, depth);
+			this->Pipeline.DepthIgnoreObjects.Commands.push_back(command);
 		}
 		else if (isTransparent)
 		{
-			auto& transparentObjects = this->Pipeline.TransparentObjects;
-			transparentObjects.Groups[renderGroupIndex].unitCount++;
-			transparentObjects.UnitsIndex.push_back(unitIndex);
+			command.SortKey = MakeTransparentSortKey(DrawPass::TRANSPARENT_OBJECTS, vaoIndex, materialIndex, depth);
+			this->Pipeline.TransparentObjects.Commands.push_back(command);
 		}
 		else
 		{
-			auto& opaqueObjects = this->Pipeline.OpaqueObjects;
-			opaqueObjects.Groups[renderGroupIndex].unitCount++;
-			opaqueObjects.UnitsIndex.push_back(unitIndex);
+			command.SortKey = MakeOpaqueSortKey(DrawPass::OPAQUE_OBJECTS, vaoIndex, materialIndex, depth);
+			this->Pipeline.OpaqueObjects.Commands.push_back(command);
 		}
-
-		// submit render material
-		auto& renderMaterial = this->Pipeline.MaterialUnits.emplace_back(material); // create a copy of material for future work
-
-		// we need to change displacement to account object scale, so we take average of object scale components as multiplier
-		renderMaterial.Displacement *= Dot(parentTransform.GetScale() * submesh.GetTransform().GetScale(), MakeVector3(1.0f / 3.0f));
-
-		if (renderMaterial.RoughnessMap.IsValid())         renderMaterial.RoughnessFactor = 1.0f;
-		if (renderMaterial.MetallicMap.IsValid())          renderMaterial.MetallicFactor = 1.0f;
-
-		// set default textures if they are not exist
-		if (!renderMaterial.AlbedoMap.IsValid())           renderMaterial.AlbedoMap = this->Pipeline.Environment.DefaultMaterialMap;
-		if (!renderMaterial.RoughnessMap.IsValid())        renderMaterial.RoughnessMap = this->Pipeline.Environment.DefaultMaterialMap;
-		if (!renderMaterial.MetallicMap.IsValid())         renderMaterial.MetallicMap = this->Pipeline.Environment.DefaultMaterialMap;
-		if (!renderMaterial.EmissiveMap.IsValid())         renderMaterial.EmissiveMap = this->Pipeline.Environment.DefaultMaterialMap;
-		if (!renderMaterial.AmbientOcclusionMap.IsValid()) renderMaterial.AmbientOcclusionMap = this->Pipeline.Environment.DefaultMaterialMap;
-		if (!renderMaterial.NormalMap.IsValid())           renderMaterial.NormalMap = this->Pipeline.Environment.DefaultNormalMap;
-		if (!renderMaterial.HeightMap.IsValid())           renderMaterial.HeightMap = this->Pipeline.Environment.DefaultBlackMap;
 	}
 
 	void RenderController::SubmitImage(const TextureHandle& texture)
@@ -1441,6 +1537,9 @@ namespace MxEngine
 	void RenderController::StartPipeline()
 	{
 		MAKE_SCOPE_PROFILER("RenderController::StartPipeline()");
+		this->Pipeline.Statistics.AddEntry("frame arena used bytes", this->Pipeline.FrameMemory.GetUsedBytes());
+		this->Pipeline.Statistics.AddEntry("frame arena peak bytes", this->Pipeline.FrameMemory.GetPeakBytes());
+		this->Pipeline.Statistics.AddEntry("frame arena heap fallback bytes", this->Pipeline.FrameMemory.GetOverflowBytes());
 		if (this->Pipeline.Cameras.empty())
 		{
 			if(this->Pipeline.Environment.RenderToDefaultFrameBuffer)
@@ -1451,6 +1550,11 @@ namespace MxEngine
 		this->ComputeParticles(this->Pipeline.OpaqueParticleSystems);
 		this->ComputeParticles(this->Pipeline.TransparentParticleSystems);
 
+		// per-frame data is uploaded once and shared by all shaders through uniform buffer bindings
+		this->UploadMaterialUniforms();
+		this->UploadDirLightUniforms();
+
+		this->SortRenderLists();
 		this->PrepareShadowMaps();
 
 		for (auto& camera : this->Pipeline.Cameras)
@@ -1460,6 +1564,11 @@ namespace MxEngine
 			this->GetRenderEngine().UseBlendFactors(BlendFactor::ONE, BlendFactor::ZERO);
 			this->ToggleReversedDepth(camera.IsPerspective);
 			this->AttachFrameBuffer(camera.GBuffer);
+			this->UploadCameraUniforms(camera);
+
+			// culling is done once per camera and reused by all passes which draw render units
+			ComputeVisibility(camera.Culler, this->Scene, this->Pipeline.UnitBounds, this->Pipeline.CameraVisibility);
+			this->PrepareInstances(camera.Culler);
 
 			this->DrawObjects(camera, *this->Pipeline.Environment.Shaders["GBuffer"_id], this->Pipeline.OpaqueObjects);
 			// TODO: implement depth ignore rendering
@@ -29,8 +29,10 @@
 #pragma once
 
 #include "Core/Resources/Material.h"
+#include "Core/Resources/AssetManager.h"
 #include "Platform/OpenGL/Renderer.h"
 #include "RenderPipeline.h"
+#include "RenderScene.h"
 #include "RenderObjects/DebugBuffer.h"
 
 namespace MxEngine
@@ -46,19 +48,24 @@ namespace MxEngine
 	class Mesh;
 	class ParticleSystem;
 	class TransformComponent;
+	class InstanceFactory;
 
 	class RenderController
 	{
 		Renderer renderer;
 		RenderPipeline Pipeline;
+		RenderScene Scene;
 
+		void SortRenderLists();
 		void PrepareShadowMaps();
 		void DrawSkybox(const CameraUnit& camera);
+		void PrepareInstances(const FrustrumCuller& culler);
 		void ComputeParticles(const MxVector<ParticleSystemUnit>& particleSystems);
 		void SortParticles(const CameraUnit& camera, MxVector<ParticleSystemUnit>& particleSystems);
 		void DrawParticles(const CameraUnit& camera, MxVector<ParticleSystemUnit>& particleSystems, const Shader& shader);
 		void DrawObjects(const CameraUnit& camera, const Shader& shader, const RenderList& objects);
 		void DrawDebugBuffer(const CameraUnit& camera);
+		void BindMaterial(size_t materialIndex);
 		void DrawObject(const RenderUnit& unit, size_t instanceCount, const Shader& shader);
 		void ComputeBloomEffect(CameraUnit& camera, const TextureHandle& output);
 		TextureHandle ComputeAverageWhite(CameraUnit& camera);
@@ -82,8 +89,10 @@ namespace MxEngine
 		void DrawNonShadowedSpotLights(CameraUnit& camera, TextureHandle& output);
 		void BindGBuffer(const CameraUnit& camera, const Shader& shader, Texture::TextureBindId& startId);
 		void BindSkyboxInformation(const CameraUnit& camera, const Shader& shader, Texture::TextureBindId& startId);
-		void BindCameraInformation(const CameraUnit& camera, const Shader& shader);
-		void BindFogInformation(const CameraUnit& camera, const Shader& shader);
+		void BindDirLightShadowMaps(const Shader& shader, Texture::TextureBindId& startId);
+		void UploadCameraUniforms(const CameraUnit& camera);
+		void UploadDirLightUniforms();
+		void UploadMaterialUniforms();
 		void AttachDefaultVAO();
 		void RenderToAttachedFrameBuffer(const Shader& shader);
 	public:
@@ -110,6 +119,7 @@ namespace MxEngine
 		void ApplyGaussianBlur(const TextureHandle& inputOutput, const TextureHandle& temporary, size_t iterations, size_t lod = 0);
 		void DrawVertecies(RenderPrimitive primitive, size_t vertexCount, size_t vertexOffset, size_t instanceCount);
 		void DrawIndicies(RenderPrimitive primitive, size_t indexCount, size_t indexOffset, size_t instanceCount);
+		void BindMaterialUniforms(size_t materialIndex);
 
 		EnvironmentUnit& GetEnvironment();
 		const EnvironmentUnit& GetEnvironment() const;
@@ -117,16 +127,20 @@ namespace MxEngine
 		const LightingSystem& GetLightInformation() const;
 		const RenderStatistics& GetRenderStatistics() const;
 		RenderStatistics& GetRenderStatistics();
+		const RenderScene& GetRenderScene() const;
+		RenderScene& GetRenderScene();
+		size_t GetRenderUnitCount() const;
 		void ResetPipeline();
-		void SubmitParticleSystem(const ParticleSystem& system, const Material& material, const TransformComponent& parentTransform);
+		void SubmitParticleSystem(const ParticleSystem& system, const MaterialHandle& material, const TransformComponent& parentTransform);
 		void SubmitLightSource(const DirectionalLight& light, const TransformComponent& parentTransform);
 		void SubmitLightSource(const PointLight& light, const TransformComponent& parentTransform);
 		void SubmitLightSource(const SpotLight& light, const TransformComponent& parentTransform);
 		void SubmitCamera(const CameraController& controller, const TransformComponent& parentTransform, 
 			const Skybox* skybox, const CameraEffects* effects, const CameraToneMapping* toneMapping,
 			const CameraSSR* ssr, const CameraSSGI* ssgi, const CameraSSAO* ssao);
-		size_t SubmitRenderGroup(const Mesh& mesh, size_t instanceCount);
-		void SubmitRenderUnit(size_t renderGroupIndex, const SubMesh& object, const Material& material, const TransformComponent& parentTransform, bool castsShadow, bool ignoresDepth, const char* debugName = nullptr);
+		size_t SubmitMaterial(const MaterialHandle& material);
+		size_t SubmitRenderGroup(const Mesh& mesh, InstanceFactory* instances, size_t lodLevel = 0);
+		void SubmitRenderUnit(size_t renderGroupIndex, const RenderUnit& unit, const MaterialHandle& material, bool castsShadow, bool ignoresDepth, const char* debugName = nullptr);
 		void SubmitImage(const TextureHandle& texture);
 		void StartPipeline();
 		void EndPipeline();
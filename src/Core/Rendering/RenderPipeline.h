@@ -35,9 +35,12 @@
 #include "RenderObjects/PointLightInstancedObject.h"
 #include "RenderObjects/SpotLightInstancedObject.h"
 #include "RenderUtilities/RenderStatistics.h"
+#include "RenderUtilities/DrawCommandList.h"
+#include "RenderUtilities/UniformBlocks.h"
 #include "Core/Resources/ACESCurve.h"
 #include "Core/Resources/Material.h"
 #include "Utilities/String/String.h"
+#include "Utilities/Memory/FrameAllocator.h"
 
 namespace MxEngine
 {
@@ -47,6 +50,7 @@ namespace MxEngine
     class CameraSSR;
     class CameraSSGI;
     class CameraSSAO;
+    class InstanceFactory;
     
     struct DebugBufferUnit
     {
@@ -107,6 +111,11 @@ namespace MxEngine
         CubeMapHandle DefaultShadowCubeMap;
         CubeMapHandle DefaultSkybox;
 
+        UniformBufferHandle CameraUniforms;
+        UniformBufferHandle DirLightUniforms;
+        UniformBufferHandle MaterialUniforms;
+        size_t MaterialUniformStride;
+
         FrameBufferHandle DepthFrameBuffer;
         FrameBufferHandle PostProcessFrameBuffer;
         FrameBufferHandle BloomFrameBuffer;
@@ -163,7 +172,9 @@ namespace MxEngine
     {
         VertexArrayHandle VAO;
         size_t InstanceCount;
-        size_t unitCount;
+        size_t VisibleInstanceCount;
+        InstanceFactory* Instances;
+        size_t LODLevel;
     };
 
     struct RenderUnit
@@ -176,15 +187,25 @@ namespace MxEngine
         Matrix3x3 NormalMatrix;
 
         Vector3 MinAABB, MaxAABB;
+        float DisplacementScale;
         #if defined(MXENGINE_DEBUG)
         const char* DebugName;
         #endif
     };
 
+    struct RenderBounds
+    {
+        FrameVector<float> CenterX;
+        FrameVector<float> CenterY;
+        FrameVector<float> CenterZ;
+        FrameVector<float> ExtentX;
+        FrameVector<float> ExtentY;
+        FrameVector<float> ExtentZ;
+    };
+
     struct RenderList
     {
-        MxVector<RenderGroup> Groups;
-        MxVector<size_t> UnitsIndex;
+        FrameVector<DrawCommand> Commands;
     };
 
     struct ParticleSystemUnit
@@ -207,12 +228,21 @@ namespace MxEngine
         RenderList TransparentObjects;
         RenderList OpaqueObjects;
         RenderList DepthIgnoreObjects;
-        MxVector<RenderUnit> RenderUnits;
+        FrameVector<RenderGroup> RenderGroups;
+        FrameVector<RenderUnit> RenderUnits;
+        RenderBounds UnitBounds;
+        MxVector<uint64_t> CameraVisibility;
+        MxVector<uint64_t> ShadowVisibility;
+        MxVector<uint64_t> InstanceVisibility;
 
         MxVector<ParticleSystemUnit> OpaqueParticleSystems;
         MxVector<ParticleSystemUnit> TransparentParticleSystems;
         MxVector<Material> MaterialUnits;
-        MxVector<CameraUnit> Cameras;
+        MxVector<uint32_t> MaterialUnitsFrame;
+        MxVector<uint8_t> MaterialUniformData;
+        uint32_t FrameIndex = 1;
+        FrameVector<CameraUnit> Cameras;
         RenderStatistics Statistics;
+        FrameArena FrameMemory;
     };
 }
\ No newline at end of file
@@ -0,0 +1,298 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "RenderScene.h"
+#include "Core/Rendering/RenderController.h"
+#include "Core/Components/Rendering/MeshRenderer.h"
+#include "Core/MxObject/MxObject.h"
+#include "Core/Components/Instancing/InstanceFactory.h"
+
+#include <algorithm>
+
+namespace MxEngine
+{
+    RenderScene::Entry& RenderScene::GetEntry(const MxObject& object)
+    {
+        auto handle = object.GetNativeHandle();
+        auto generation = MxObject::Factory::Get<MxObject>().GetGeneration(handle);
+        if (handle >= this->entries.size())
+            this->entries.resize(handle + 1);
+
+        auto& entry = this->entries[handle];
+        if (entry.ObjectGeneration != generation)
+        {
+            // slot was reused by other object, drop data of previous one
+            if (entry.Proxy != DynamicAABBTree::InvalidProxy)
+                this->tree.Remove(entry.Proxy);
+            entry = Entry{ };
+            entry.ObjectGeneration = generation;
+        }
+        return entry;
+    }
+
+    void RenderScene::RebuildUnit(CachedUnit& unit, const SubMesh& submesh, const TransformComponent& parentTransform)
+    {
+        const auto& submeshTransform = submesh.GetTransform();
+        auto& renderUnit = unit.Unit;
+
+        unit.SubMeshTransformVersion = submeshTransform.GetVersion();
+        unit.LocalAABB = submesh.Data.GetAABB();
+
+        renderUnit.ModelMatrix = parentTransform.GetMatrix() * submeshTransform.GetMatrix(); //-V807
+        renderUnit.NormalMatrix = parentTransform.GetNormalMatrix() * submeshTransform.GetNormalMatrix();
+
+        // compute aabb of primitive object for later frustrum culling
+        auto aabb = unit.LocalAABB * renderUnit.ModelMatrix;
+        renderUnit.MinAABB = aabb.Min;
+        renderUnit.MaxAABB = aabb.Max;
+
+        // we need to change displacement to account object scale, so we take average of object scale components as multiplier
+        renderUnit.DisplacementScale = Dot(parentTransform.GetScale() * submeshTransform.GetScale(), MakeVector3(1.0f / 3.0f));
+
+        this->rebuiltUnitCount++;
+    }
+
+    void RenderScene::UpdateBounds(Entry& entry, size_t entryIndex)
+    {
+        if (entry.Units.empty()) return;
+
+        AABB bounds{ entry.Units.front().Unit.MinAABB, entry.Units.front().Unit.MaxAABB };
+        for (const auto& cachedUnit : entry.Units)
+        {
+            bounds.Min = VectorMin(bounds.Min, cachedUnit.Unit.MinAABB);
+            bounds.Max = VectorMax(bounds.Max, cachedUnit.Unit.MaxAABB);
+        }
+
+        entry.Bounds = bounds;
+        if (entry.Proxy == DynamicAABBTree::InvalidProxy)
+            entry.Proxy = this->tree.Insert(bounds, entryIndex);
+        else
+            this->tree.Move(entry.Proxy, bounds);
+    }
+
+    MxObject::Handle RenderScene::GetObjectHandle(size_t entryIndex) const
+    {
+        // object could be destroyed after last submission, in this case handle is invalid
+        return MxObject::Handle(entryIndex, this->entries[entryIndex].ObjectGeneration);
+    }
+
+    void RenderScene::SubmitMesh(RenderController& renderer, const MxObject& object, const MeshHandle& mesh, const MeshRenderer& meshRenderer,
+        bool castsShadow, bool ignoresDepth, InstanceFactory* instances)
+    {
+        auto& entry = this->GetEntry(object);
+        size_t entryIndex = object.GetNativeHandle();
+        const auto& transform = object.Transform;
+        const auto& submeshes = mesh->GetSubMeshes();
+
+        bool isOutdated = entry.TransformVersion != transform.GetVersion() ||
+            entry.MeshHandle != mesh.GetHandle() || entry.MeshGeneration != mesh.GetGeneration() ||
+            entry.Units.size() != submeshes.size();
+
+        if (isOutdated)
+        {
+            entry.TransformVersion = transform.GetVersion();
+            entry.MeshHandle = mesh.GetHandle();
+            entry.MeshGeneration = mesh.GetGeneration();
+            entry.Units.resize(submeshes.size());
+            for (size_t i = 0; i < submeshes.size(); i++)
+                this->RebuildUnit(entry.Units[i], submeshes[i], transform);
+        }
+
+        bool isRebuilt = isOutdated;
+        size_t renderGroupIndex = renderer.SubmitRenderGroup(*mesh, instances);
+        entry.FirstUnit = renderer.GetRenderUnitCount();
+        for (size_t i = 0; i < submeshes.size(); i++)
+        {
+            const auto& submesh = submeshes[i];
+            auto& cachedUnit = entry.Units[i];
+
+            auto materialId = submesh.GetMaterialId();
+            if (materialId >= meshRenderer.Materials.size()) continue;
+            const auto& material = meshRenderer.Materials[materialId];
+            if (!material.IsValid()) continue;
+
+            // submesh can be moved or its geometry changed independently of object
+            const auto& localAABB = submesh.Data.GetAABB();
+            if (cachedUnit.SubMeshTransformVersion != submesh.GetTransform().GetVersion() ||
+                cachedUnit.LocalAABB.Min != localAABB.Min || cachedUnit.LocalAABB.Max != localAABB.Max)
+            {
+                this->RebuildUnit(cachedUnit, submesh, transform);
+                isRebuilt = true;
+            }
+
+            cachedUnit.Unit.IndexCount = submesh.Data.GetIndiciesCount();
+            cachedUnit.Unit.IndexOffset = submesh.Data.GetIndiciesOffset();
+            renderer.SubmitRenderUnit(renderGroupIndex, cachedUnit.Unit, material, castsShadow, ignoresDepth, object.Name.c_str());
+        }
+
+        // instances which are far from camera are drawn with LOD meshes. Their units reuse cached data of source submeshes,
+        // so all units of object stay in one range, which is culled as a whole
+        size_t lodCount = instances != nullptr ? instances->GetLODCount() : 0;
+        for (size_t lodLevel = 1; lodLevel <= lodCount; lodLevel++)
+        {
+            auto lodMesh = instances->GetLODMesh(lodLevel);
+            if (!lodMesh.IsValid() || instances->GetLODInstanceCount(lodLevel) == 0) continue;
+
+            const auto& lodSubmeshes = lodMesh->GetSubMeshes();
+            size_t lodGroupIndex = renderer.SubmitRenderGroup(*lodMesh, instances, lodLevel);
+            for (size_t i = 0; i < Min(lodSubmeshes.size(), entry.Units.size()); i++)
+            {
+                const auto& submesh = lodSubmeshes[i];
+                auto materialId = submesh.GetMaterialId();
+                if (materialId >= meshRenderer.Materials.size()) continue;
+                const auto& material = meshRenderer.Materials[materialId];
+                if (!material.IsValid()) continue;
+
+                auto unit = entry.Units[i].Unit;
+                unit.IndexCount = submesh.Data.GetIndiciesCount();
+                unit.IndexOffset = submesh.Data.GetIndiciesOffset();
+                renderer.SubmitRenderUnit(lodGroupIndex, unit, material, castsShadow, ignoresDepth, object.Name.c_str());
+            }
+        }
+        entry.UnitCount = renderer.GetRenderUnitCount() - entry.FirstUnit;
+
+        if (isRebuilt || entry.Proxy == DynamicAABBTree::InvalidProxy)
+            this->UpdateBounds(entry, entryIndex);
+
+        if (entry.SubmittedFrame != this->frameIndex)
+        {
+            entry.SubmittedFrame = this->frameIndex;
+            this->submittedEntries.push_back(entryIndex);
+        }
+        this->submittedUnitCount += entry.UnitCount;
+    }
+
+    void RenderScene::EndSubmission()
+    {
+        // objects which were hidden or destroyed since previous frame must not be reported by queries
+        for (size_t entryIndex : this->previousEntries)
+        {
+            auto& entry = this->entries[entryIndex];
+            if (entry.SubmittedFrame != this->frameIndex && entry.Proxy != DynamicAABBTree::InvalidProxy)
+            {
+                this->tree.Remove(entry.Proxy);
+                entry.Proxy = DynamicAABBTree::InvalidProxy;
+            }
+        }
+        std::swap(this->previousEntries, this->submittedEntries);
+        this->submittedEntries.clear();
+        this->frameIndex++;
+
+        this->lastSubmittedUnitCount = this->submittedUnitCount;
+        this->submittedUnitCount = 0;
+    }
+
+    size_t RenderScene::GetSubmittedUnitCount() const
+    {
+        return this->lastSubmittedUnitCount;
+    }
+
+    void RenderScene::QueryObjects(const AABB& box, MxVector<MxObject::Handle>& result) const
+    {
+        this->tree.QueryAABB(box, [this, &box, &result](size_t entryIndex)
+        {
+            auto handle = this->GetObjectHandle(entryIndex);
+            if (handle.IsValid() && IsOverlapping(this->entries[entryIndex].Bounds, box))
+                result.push_back(std::move(handle));
+        });
+    }
+
+    void RenderScene::QueryObjects(const BoundingSphere& sphere, MxVector<MxObject::Handle>& result) const
+    {
+        this->tree.QuerySphere(sphere, [this, &sphere, &result](size_t entryIndex)
+        {
+            auto handle = this->GetObjectHandle(entryIndex);
+            if (handle.IsValid() && IsOverlapping(this->entries[entryIndex].Bounds, sphere))
+                result.push_back(std::move(handle));
+        });
+    }
+
+    void RenderScene::QueryObjects(const FrustrumCuller& culler, MxVector<MxObject::Handle>& result) const
+    {
+        this->tree.QueryFrustrum(culler, [this, &culler, &result](size_t entryIndex, bool fullyInside)
+        {
+            const auto& bounds = this->entries[entryIndex].Bounds;
+            if (!fullyInside && !culler.IsAABBVisible(bounds.Min, bounds.Max)) return;
+
+            auto handle = this->GetObjectHandle(entryIndex);
+            if (handle.IsValid())
+                result.push_back(std::move(handle));
+        });
+    }
+
+    void RenderScene::RayCast(const Vector3& from, const Vector3& to, MxVector<MxObject::Handle>& result) const
+    {
+        float length = Length(to - from);
+        if (length == 0.0f) return;
+        Vector3 direction = (to - from) / length;
+        Vector3 inverseDirection = 1.0f / direction;
+
+        MxVector<std::pair<float, size_t>> hits;
+        this->tree.RayCast(from, direction, length, [this, &from, &inverseDirection, length, &hits](size_t entryIndex, float)
+        {
+            float distance = 0.0f;
+            if (RayIntersects(this->entries[entryIndex].Bounds, from, inverseDirection, length, distance))
+                hits.emplace_back(distance, entryIndex);
+            return length;
+        });
+
+        std::sort(hits.begin(), hits.end());
+        for (const auto& [distance, entryIndex] : hits)
+        {
+            auto handle = this->GetObjectHandle(entryIndex);
+            if (handle.IsValid())
+                result.push_back(std::move(handle));
+        }
+    }
+
+    const DynamicAABBTree& RenderScene::GetTree() const
+    {
+        return this->tree;
+    }
+
+    size_t RenderScene::GetRebuiltUnitCount() const
+    {
+        return this->rebuiltUnitCount;
+    }
+
+    void RenderScene::ResetStatistics()
+    {
+        this->rebuiltUnitCount = 0;
+    }
+
+    void RenderScene::Clear()
+    {
+        this->entries.clear();
+        this->submittedEntries.clear();
+        this->previousEntries.clear();
+        this->tree.Clear();
+        this->submittedUnitCount = 0;
+        this->lastSubmittedUnitCount = 0;
+        this->rebuiltUnitCount = 0;
+    }
+}
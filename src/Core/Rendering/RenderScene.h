@@ -0,0 +1,188 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <limits>
+
+#include "Core/Rendering/RenderPipeline.h"
+#include "Core/BoundingObjects/AABB.h"
+#include "Core/BoundingObjects/DynamicAABBTree.h"
+#include "Core/Resources/AssetManager.h"
+#include "Core/MxObject/MxObject.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+    class MeshRenderer;
+    class InstanceFactory;
+    class RenderController;
+    class TransformComponent;
+    class SubMesh;
+
+    /*!
+    render scene keeps render units of mesh objects between frames. Unit matrices and bounding boxes are recomputed only if
+    object transform, submesh transform or mesh itself changed, so static objects are submitted to pipeline by plain copy.
+    World bounds of submitted objects are stored in dynamic AABB tree, which is used for hierarchical culling and spatial queries
+    */
+    class RenderScene
+    {
+        struct CachedUnit
+        {
+            RenderUnit Unit;
+            AABB LocalAABB;
+            uint64_t SubMeshTransformVersion = 0;
+        };
+
+        struct Entry
+        {
+            uint32_t ObjectGeneration = 0;
+            uint64_t TransformVersion = 0;
+            size_t MeshHandle = std::numeric_limits<size_t>::max();
+            uint32_t MeshGeneration = 0;
+            MxVector<CachedUnit> Units;
+
+            size_t Proxy = DynamicAABBTree::InvalidProxy;
+            AABB Bounds;
+            size_t FirstUnit = 0;
+            size_t UnitCount = 0;
+            uint32_t SubmittedFrame = 0;
+        };
+
+        MxVector<Entry> entries;
+        MxVector<size_t> submittedEntries;
+        MxVector<size_t> previousEntries;
+        DynamicAABBTree tree;
+        uint32_t frameIndex = 1;
+        size_t submittedUnitCount = 0;
+        size_t lastSubmittedUnitCount = 0;
+        size_t rebuiltUnitCount = 0;
+
+        Entry& GetEntry(const MxObject& object);
+        void RebuildUnit(CachedUnit& unit, const SubMesh& submesh, const TransformComponent& parentTransform);
+        void UpdateBounds(Entry& entry, size_t entryIndex);
+        MxObject::Handle GetObjectHandle(size_t entryIndex) const;
+    public:
+        /*!
+        submits all submeshes of mesh object to render pipeline, updating cached units if object was changed
+        \param renderer render controller to submit units to
+        \param object object which owns mesh
+        \param mesh mesh to render (may differ from MeshSource one if LODs are used)
+        \param meshRenderer materials of object
+        \param castsShadow if object should be rendered to shadow maps
+        \param ignoresDepth if object should be rendered without depth test
+        \param instances instance factory of object or nullptr if object is not instanced
+        */
+        void SubmitMesh(RenderController& renderer, const MxObject& object, const MeshHandle& mesh, const MeshRenderer& meshRenderer,
+            bool castsShadow, bool ignoresDepth, InstanceFactory* instances);
+        /*!
+        finishes frame submission. Objects which were not submitted since previous call are removed from the tree
+        */
+        void EndSubmission();
+        /*!
+        getter for number of render units submitted by scene during last finished submission. If it differs from number of units
+        in render pipeline, some units were submitted directly to render controller and are not present in the tree
+        \returns number of submitted units
+        */
+        size_t GetSubmittedUnitCount() const;
+
+        /*!
+        invokes callback for each range of render units submitted in current frame which object bounds are visible from frustrum
+        \param culler frustrum to test against
+        \param callback functor with signature `void(size_t firstUnit, size_t unitCount, bool fullyInside)`
+        */
+        template<typename Func>
+        void QueryUnits(const FrustrumCuller& culler, Func&& callback) const
+        {
+            this->tree.QueryFrustrum(culler, [this, &callback](size_t entryIndex, bool fullyInside)
+            {
+                const auto& entry = this->entries[entryIndex];
+                callback(entry.FirstUnit, entry.UnitCount, fullyInside);
+            });
+        }
+        /*!
+        invokes callback for each range of render units submitted in current frame which object bounds overlap sphere
+        \param sphere sphere to test against
+        \param callback functor with signature `void(size_t firstUnit, size_t unitCount)`
+        */
+        template<typename Func>
+        void QueryUnits(const BoundingSphere& sphere, Func&& callback) const
+        {
+            this->tree.QuerySphere(sphere, [this, &callback](size_t entryIndex)
+            {
+                const auto& entry = this->entries[entryIndex];
+                callback(entry.FirstUnit, entry.UnitCount);
+            });
+        }
+
+        /*!
+        collects objects which bounds overlap box
+        \param box box to test against
+        \param result list to append objects to
+        */
+        void QueryObjects(const AABB& box, MxVector<MxObject::Handle>& result) const;
+        /*!
+        collects objects which bounds overlap sphere
+        \param sphere sphere to test against
+        \param result list to append objects to
+        */
+        void QueryObjects(const BoundingSphere& sphere, MxVector<MxObject::Handle>& result) const;
+        /*!
+        collects objects which bounds are visible from frustrum
+        \param culler frustrum to test against
+        \param result list to append objects to
+        */
+        void QueryObjects(const FrustrumCuller& culler, MxVector<MxObject::Handle>& result) const;
+        /*!
+        collects objects which bounds are intersected by ray, ordered by distance from ray origin
+        \param from ray origin
+        \param to ray end
+        \param result list to append objects to
+        */
+        void RayCast(const Vector3& from, const Vector3& to, MxVector<MxObject::Handle>& result) const;
+        /*!
+        getter for bounding volume hierarchy of submitted objects
+        \returns tree which user data is native handle of object
+        */
+        const DynamicAABBTree& GetTree() const;
+
+        /*!
+        getter for number of units which were recomputed since last ResetStatistics() call
+        \returns number of rebuilt units
+        */
+        size_t GetRebuiltUnitCount() const;
+        /*!
+        resets rebuilt unit counter
+        */
+        void ResetStatistics();
+        /*!
+        drops all cached units and clears the tree
+        */
+        void Clear();
+    };
+}
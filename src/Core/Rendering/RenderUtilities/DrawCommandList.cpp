@@ -0,0 +1,113 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "DrawCommandList.h"
+
+#include <array>
+#include <cstring>
+#include <algorithm>
+
+namespace MxEngine
+{
+    constexpr size_t SortKeyFieldBits = 20;
+    constexpr uint64_t SortKeyFieldMask = (uint64_t(1) << SortKeyFieldBits) - 1;
+    constexpr size_t SortKeyPassShift = 3 * SortKeyFieldBits;
+
+    uint64_t QuantizeDepth(float depth)
+    {
+        // bit pattern of non-negative float grows monotonically with its value, so its top bits can be compared as integer
+        depth = std::max(depth, 0.0f);
+        uint32_t bits = 0;
+        std::memcpy(&bits, &depth, sizeof(bits));
+        return uint64_t(bits >> (31 - SortKeyFieldBits)) & SortKeyFieldMask;
+    }
+
+    uint64_t MakeOpaqueSortKey(DrawPass pass, size_t vaoIndex, size_t materialIndex, float depth)
+    {
+        return (uint64_t(pass) << SortKeyPassShift) |
+            ((uint64_t(vaoIndex) & SortKeyFieldMask) << (2 * SortKeyFieldBits)) |
+            ((uint64_t(materialIndex) & SortKeyFieldMask) << SortKeyFieldBits) |
+            QuantizeDepth(depth);
+    }
+
+    uint64_t MakeTransparentSortKey(DrawPass pass, size_t vaoIndex, size_t materialIndex, float depth)
+    {
+        return (uint64_t(pass) << SortKeyPassShift) |
+            ((SortKeyFieldMask - QuantizeDepth(depth)) << (2 * SortKeyFieldBits)) |
+            ((uint64_t(vaoIndex) & SortKeyFieldMask) << SortKeyFieldBits) |
+            (uint64_t(materialIndex) & SortKeyFieldMask);
+    }
+
+    void SortDrawCommands(FrameVector<DrawCommand>& commands, FrameArena& arena)
+    {
+        constexpr size_t RadixBits = 8;
+        constexpr size_t RadixSize = size_t(1) << RadixBits;
+        constexpr size_t PassCount = 8 * sizeof(uint64_t) / RadixBits;
+
+        size_t count = commands.size();
+        if (count < 2) return;
+
+        std::array<std::array<size_t, RadixSize>, PassCount> histograms{ };
+        for (const auto& command : commands)
+        {
+            for (size_t pass = 0; pass < PassCount; pass++)
+                histograms[pass][(command.SortKey >> (pass * RadixBits)) & (RadixSize - 1)]++;
+        }
+
+        auto* temporary = static_cast<DrawCommand*>(arena.Allocate(count * sizeof(DrawCommand), alignof(DrawCommand)));
+        DrawCommand* source = commands.data();
+        DrawCommand* destination = temporary;
+
+        for (size_t pass = 0; pass < PassCount; pass++)
+        {
+            auto& histogram = histograms[pass];
+            size_t shift = pass * RadixBits;
+
+            // all keys have same digit, pass would not change order
+            if (histogram[(source->SortKey >> shift) & (RadixSize - 1)] == count) continue;
+
+            size_t offset = 0;
+            for (auto& bucket : histogram)
+            {
+                size_t bucketSize = bucket;
+                bucket = offset;
+                offset += bucketSize;
+            }
+
+            for (size_t i = 0; i < count; i++)
+            {
+                size_t digit = (source[i].SortKey >> shift) & (RadixSize - 1);
+                destination[histogram[digit]++] = source[i];
+            }
+            std::swap(source, destination);
+        }
+
+        if (source != commands.data())
+            std::copy(source, source + count, commands.data());
+    }
+}
@@ -0,0 +1,86 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstdint>
+
+#include "Utilities/Memory/FrameAllocator.h"
+
+namespace MxEngine
+{
+    /*!
+    render pass of draw command. Stored in most significant bits of sort key, so commands of one pass are always drawn together.
+    Each pass is drawn by single shader program, so pass also determines which shader is bound
+    */
+    enum class DrawPass : uint8_t
+    {
+        SHADOW_CASTERS,
+        OPAQUE_OBJECTS,
+        DEPTH_IGNORE_OBJECTS,
+        TRANSPARENT_OBJECTS,
+    };
+
+    /*!
+    draw command references render unit and render group (VAO + instance count) which should be drawn.
+    Commands are ordered by sort key to minimize state changes between consecutive draw calls
+    */
+    struct DrawCommand
+    {
+        uint64_t SortKey;
+        uint32_t UnitIndex;
+        uint32_t GroupIndex;
+    };
+
+    /*!
+    creates sort key for opaque geometry. Layout (from most significant bits): pass (4 bits), VAO (20 bits), material (20 bits), depth (20 bits).
+    Commands with same VAO and material end up adjacent and are drawn front-to-back inside each batch
+    \param pass render pass of command
+    \param vaoIndex index of vertex array used by command
+    \param materialIndex index of material used by command
+    \param depth non-negative distance from viewer to object
+    \returns 64-bit sort key
+    */
+    uint64_t MakeOpaqueSortKey(DrawPass pass, size_t vaoIndex, size_t materialIndex, float depth);
+    /*!
+    creates sort key for transparent geometry. Layout (from most significant bits): pass (4 bits), inverted depth (20 bits), VAO (20 bits), material (20 bits).
+    Commands are drawn back-to-front, state is shared only between objects at equal depth
+    \param pass render pass of command
+    \param vaoIndex index of vertex array used by command
+    \param materialIndex index of material used by command
+    \param depth non-negative distance from viewer to object
+    \returns 64-bit sort key
+    */
+    uint64_t MakeTransparentSortKey(DrawPass pass, size_t vaoIndex, size_t materialIndex, float depth);
+    /*!
+    sorts draw commands by their sort keys using LSD radix sort. Sort is stable, so commands with equal keys keep submission order
+    \param commands commands to sort
+    \param arena frame arena used for temporary buffer
+    */
+    void SortDrawCommands(FrameVector<DrawCommand>& commands, FrameArena& arena);
+}
@@ -30,11 +30,15 @@
 #include "Core/Application/Rendering.h"
 #include "Core/Rendering/RenderPipeline.h"
 #include "Core/BoundingObjects/FrustrumCuller.h"
+#include "VisibilityCuller.h"
 
 namespace MxEngine
 {
-    ShadowMapGenerator::ShadowMapGenerator(const RenderList& shadowCasters, ArrayView<RenderUnit> renderUnits, ArrayView<Material> materials)
-        : shadowCasters(shadowCasters), renderUnits(renderUnits), materials(materials)
+    ShadowMapGenerator::ShadowMapGenerator(const RenderList& shadowCasters, ArrayView<RenderGroup> renderGroups, ArrayView<RenderUnit> renderUnits, 
+        ArrayView<Material> materials, const RenderBounds& unitBounds, const RenderScene& scene, 
+        MxVector<uint64_t>& visibility, MxVector<uint64_t>& instanceVisibility)
+        : shadowCasters(shadowCasters), renderGroups(renderGroups), renderUnits(renderUnits), materials(materials), unitBounds(unitBounds), 
+          scene(scene), visibility(visibility), instanceVisibility(instanceVisibility)
     {
         Rendering::GetController().ToggleReversedDepth(false);
         Rendering::GetController().ToggleDepthOnlyMode(true);
@@ -45,15 +49,18 @@ namespace MxEngine
         Rendering::GetController().ToggleDepthOnlyMode(false);
     }
 
-    void RenderUnitToDepthMap(const Shader& shader, size_t instanceCount, const RenderUnit& unit, ArrayView<Material> materials)
+    void BindMaterialForDepthMap(const Shader& shader, const Material& material, size_t materialIndex)
     {
-        const auto& material = materials[unit.materialIndex];
         material.HeightMap->Bind(0);
         material.AlbedoMap->Bind(1);
-        shader.SetUniform("displacement", material.Displacement);
-        shader.SetUniform("uvMultipliers", material.UVMultipliers);
-        shader.SetUniform("map_height", material.HeightMap->GetBoundId());
-        shader.SetUniform("map_albedo", material.AlbedoMap->GetBoundId());
+        shader.SetUniform(MAKE_UNIFORM_HANDLE("map_height"), material.HeightMap->GetBoundId());
+        shader.SetUniform(MAKE_UNIFORM_HANDLE("map_albedo"), material.AlbedoMap->GetBoundId());
+        Rendering::GetController().BindMaterialUniforms(materialIndex);
+    }
+
+    void RenderUnitToDepthMap(const Shader& shader, size_t instanceCount, const RenderUnit& unit, const Material& material)
+    {
+        shader.SetUniform(MAKE_UNIFORM_HANDLE("displacement"), material.Displacement * unit.DisplacementScale);
 
         Rendering::GetController().GetRenderEngine().SetDefaultVertexAttribute(5, unit.ModelMatrix); //-V807
         Rendering::GetController().GetRenderEngine().SetDefaultVertexAttribute(9, unit.NormalMatrix);
@@ -61,15 +68,8 @@ namespace MxEngine
         Rendering::GetController().GetRenderStatistics().AddEntry("shadow casts", 1);
     }
 
-    bool InOrthoFrustrum(const FrustrumCuller& culler, const Vector3& minAABB, const Vector3& maxAABB)
+    bool InSphereBounds(const PointLightUnit& pointLight, const Vector3& pos, const Vector3& halfSize)
     {
-        return culler.IsAABBVisible(minAABB, maxAABB);
-    };
-
-    bool InSphereBounds(const PointLightUnit& pointLight, const Vector3& minAABB, const Vector3& maxAABB)
-    {
-        auto halfSize = 0.5f * (maxAABB - minAABB);
-        auto pos = minAABB + halfSize;
         auto dist = RootThree<float>() * Max(halfSize.x, halfSize.y, halfSize.z);
 
         auto relative = pointLight.Position - pos;
@@ -77,10 +77,8 @@ namespace MxEngine
         return Dot(relative, relative) < radius * radius;
     }
 
-    bool InConeBounds(const SpotLightUnit& spotLight, const Vector3& minAABB, const Vector3& maxAABB)
+    bool InConeBounds(const SpotLightUnit& spotLight, const Vector3& pos, const Vector3& halfSize)
     {
-        auto halfSize = 0.5f * (maxAABB - minAABB);
-        auto pos = minAABB + halfSize;
         auto dist = RootThree<float>() * Max(halfSize.x, halfSize.y, halfSize.z);
 
         auto relative = pos - spotLight.Position;
@@ -91,35 +89,39 @@ namespace MxEngine
         return inside || (Dot(relative, relative) < dist * dist);
     }
 
-    template<typename CullFunc>
-    void CastShadowsPerUnit(const CullFunc& culler, const Shader& shader, const RenderUnit& unit, size_t instanceCount, ArrayView<Material> materials)
+    void CastShadows(const MxVector<uint64_t>& visibility, const Shader& shader, const RenderList& shadowCasters, 
+        ArrayView<RenderGroup> groups, ArrayView<RenderUnit> units, ArrayView<Material> materials)
     {
-        // do not cull instanced objects, as their position may differ
-        bool culled = instanceCount == 0 && !culler(unit.MinAABB, unit.MaxAABB);
-        if (!culled)
-        {
-            RenderUnitToDepthMap(shader, instanceCount, unit, materials);
-        }
-        else
-        {
-            Rendering::GetController().GetRenderStatistics().AddEntry("culled from shadow cast", 1);
-        }
-    }
+        // shadow casters are sorted by VAO and material, so state is changed only when it differs from previous command
+        constexpr size_t InvalidIndex = std::numeric_limits<size_t>::max();
+        size_t boundVAO = InvalidIndex;
+        size_t boundMaterial = InvalidIndex;
 
-    template<typename CullFunc>
-    void CastsShadowsPerGroup(const CullFunc& culler, const Shader& shader, const RenderList& shadowCasters, ArrayView<RenderUnit> units, ArrayView<Material> materials)
-    {
-        size_t currentUnit = 0;
-        for (const auto& group : shadowCasters.Groups)
+        for (const auto& command : shadowCasters.Commands)
         {
-            if (group.unitCount == 0) continue;
+            const RenderGroup& group = groups[command.GroupIndex];
+            const RenderUnit& unit = units[command.UnitIndex];
 
-            group.VAO->Bind();
-            for (size_t i = 0; i < group.unitCount; i++, currentUnit++)
+            // instanced objects are culled per instance, unit is skipped only if all its instances are invisible
+            bool isInstanced = group.Instances != nullptr;
+            bool culled = isInstanced ? group.VisibleInstanceCount == 0 : !IsUnitVisible(visibility, command.UnitIndex);
+            if (culled)
             {
-                const RenderUnit& unit = units[shadowCasters.UnitsIndex[currentUnit]];
-                CastShadowsPerUnit(culler, shader, unit, group.InstanceCount, materials);
+                Rendering::GetController().GetRenderStatistics().AddEntry("culled from shadow cast", 1);
+                continue;
             }
+
+            if (group.VAO.GetHandle() != boundVAO)
+            {
+                group.VAO->Bind();
+                boundVAO = group.VAO.GetHandle();
+            }
+            if (unit.materialIndex != boundMaterial)
+            {
+                BindMaterialForDepthMap(shader, materials[unit.materialIndex], unit.materialIndex);
+                boundMaterial = unit.materialIndex;
+            }
+            RenderUnitToDepthMap(shader, group.VisibleInstanceCount, unit, materials[unit.materialIndex]);
         }
     }
 
@@ -138,14 +140,16 @@ namespace MxEngine
                 controller.SetViewport(int(i * splitSize), 0, splitSize, splitSize);
 
                 const auto& projection = directionalLight.ProjectionMatrices[i];
-                shader.SetUniform("LightProjMatrix", projection);
-
-                auto CullingFunction = [culler = FrustrumCuller(projection)](const Vector3& min, const Vector3& max)
-                {
-                    return InOrthoFrustrum(culler, min, max);
-                };
-
-                CastsShadowsPerGroup(CullingFunction, shader, this->shadowCasters, this->renderUnits, this->materials);
+                shader.SetUniform(MAKE_UNIFORM_HANDLE("LightProjMatrix"), projection);
+
+                FrustrumCuller culler(projection);
+                ComputeVisibility(culler, this->scene, this->unitBounds, this->visibility);
+                PrepareInstances(this->renderGroups, this->instanceVisibility, 
+                    [&culler](const AABBArrayView& boxes, size_t count, MxVector<uint64_t>& visibility)
+                    {
+                        ComputeVisibility(culler, boxes, count, visibility);
+                    });
+                CastShadows(this->visibility, shader, this->shadowCasters, this->renderGroups, this->renderUnits, this->materials);
             }
 
         }
@@ -164,14 +168,23 @@ namespace MxEngine
         for (auto& spotLight : spotLights)
         {
             controller.AttachDepthMap(spotLight.ShadowMap);
-            shader.SetUniform("LightProjMatrix", spotLight.ProjectionMatrix);
+            shader.SetUniform(MAKE_UNIFORM_HANDLE("LightProjMatrix"), spotLight.ProjectionMatrix);
 
-            auto CullingFunction = [&spotLight](const Vector3& min, const Vector3& max)
+            // max distance of spot light is packed into length of its direction
+            BoundingSphere lightBounds(spotLight.Position, Length(spotLight.Direction));
+            ComputeVisibility(lightBounds, this->scene, this->unitBounds, this->visibility, [&spotLight](const Vector3& center, const Vector3& extent)
             {
-                return InConeBounds(spotLight, min, max);
-            };
-
-            CastsShadowsPerGroup(CullingFunction, shader, this->shadowCasters, this->renderUnits, this->materials);
+                return InConeBounds(spotLight, center, extent);
+            });
+            PrepareInstances(this->renderGroups, this->instanceVisibility, 
+                [&spotLight](const AABBArrayView& boxes, size_t count, MxVector<uint64_t>& visibility)
+                {
+                    ComputeVisibility(boxes, count, visibility, [&spotLight](const Vector3& center, const Vector3& extent)
+                    {
+                        return InConeBounds(spotLight, center, extent);
+                    });
+                });
+            CastShadows(this->visibility, shader, this->shadowCasters, this->renderGroups, this->renderUnits, this->materials);
         }
 
         for (auto& spotLight : spotLights)
@@ -188,21 +201,29 @@ namespace MxEngine
         for (auto& pointLight : pointLights)
         {
             controller.AttachDepthMap(pointLight.ShadowMap);
-            shader.SetUniform("LightProjMatrix[0]", pointLight.ProjectionMatrices[0]);
-            shader.SetUniform("LightProjMatrix[1]", pointLight.ProjectionMatrices[1]);
-            shader.SetUniform("LightProjMatrix[2]", pointLight.ProjectionMatrices[2]);
-            shader.SetUniform("LightProjMatrix[3]", pointLight.ProjectionMatrices[3]);
-            shader.SetUniform("LightProjMatrix[4]", pointLight.ProjectionMatrices[4]);
-            shader.SetUniform("LightProjMatrix[5]", pointLight.ProjectionMatrices[5]);
-            shader.SetUniform("zFar", pointLight.Radius);
-            shader.SetUniform("lightPos", pointLight.Position);
-
-            auto CullingFunction = [&pointLight](const Vector3& min, const Vector3& max)
+            shader.SetUniform(MAKE_UNIFORM_HANDLE("LightProjMatrix[0]"), pointLight.ProjectionMatrices[0]);
+            shader.SetUniform(MAKE_UNIFORM_HANDLE("LightProjMatrix[1]"), pointLight.ProjectionMatrices[1]);
+            shader.SetUniform(MAKE_UNIFORM_HANDLE("LightProjMatrix[2]"), pointLight.ProjectionMatrices[2]);
+            shader.SetUniform(MAKE_UNIFORM_HANDLE("LightProjMatrix[3]"), pointLight.ProjectionMatrices[3]);
+            shader.SetUniform(MAKE_UNIFORM_HANDLE("LightProjMatrix[4]"), pointLight.ProjectionMatrices[4]);
+            shader.SetUniform(MAKE_UNIFORM_HANDLE("LightProjMatrix[5]"), pointLight.ProjectionMatrices[5]);
+            shader.SetUniform(MAKE_UNIFORM_HANDLE("zFar"), pointLight.Radius);
+            shader.SetUniform(MAKE_UNIFORM_HANDLE("lightPos"), pointLight.Position);
+
+            BoundingSphere lightBounds(pointLight.Position, pointLight.Radius);
+            ComputeVisibility(lightBounds, this->scene, this->unitBounds, this->visibility, [&pointLight](const Vector3& center, const Vector3& extent)
             {
-                return InSphereBounds(pointLight, min, max);
-            };
-
-            CastsShadowsPerGroup(CullingFunction, shader, this->shadowCasters, this->renderUnits, this->materials);
+                return InSphereBounds(pointLight, center, extent);
+            });
+            PrepareInstances(this->renderGroups, this->instanceVisibility, 
+                [&pointLight](const AABBArrayView& boxes, size_t count, MxVector<uint64_t>& visibility)
+                {
+                    ComputeVisibility(boxes, count, visibility, [&pointLight](const Vector3& center, const Vector3& extent)
+                    {
+                        return InSphereBounds(pointLight, center, extent);
+                    });
+                });
+            CastShadows(this->visibility, shader, this->shadowCasters, this->renderGroups, this->renderUnits, this->materials);
         }
 
         for (auto& pointLight : pointLights)
@@ -27,6 +27,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Utilities/Array/ArrayView.h"
+#include "Utilities/STL/MxVector.h"
 
 namespace MxEngine
 {
@@ -36,15 +37,25 @@ namespace MxEngine
     struct PointLightUnit;
     struct SpotLightUnit;
     struct RenderList;
+    struct RenderGroup;
     struct RenderUnit;
+    struct RenderBounds;
+    class RenderScene;
 
     class ShadowMapGenerator
     {
         const RenderList& shadowCasters;
+        ArrayView<RenderGroup> renderGroups;
         ArrayView<RenderUnit> renderUnits;
         ArrayView<Material> materials;
+        const RenderBounds& unitBounds;
+        const RenderScene& scene;
+        MxVector<uint64_t>& visibility;
+        MxVector<uint64_t>& instanceVisibility;
     public:
-        ShadowMapGenerator(const RenderList& shadowCasters, ArrayView<RenderUnit> renderUnits, ArrayView<Material> materials);
+        ShadowMapGenerator(const RenderList& shadowCasters, ArrayView<RenderGroup> renderGroups, ArrayView<RenderUnit> renderUnits, 
+            ArrayView<Material> materials, const RenderBounds& unitBounds, const RenderScene& scene, 
+            MxVector<uint64_t>& visibility, MxVector<uint64_t>& instanceVisibility);
         ~ShadowMapGenerator();
 
         void GenerateFor(const Shader& shader, ArrayView<DirectionalLightUnit> directionalLights);
@@ -0,0 +1,90 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/Math/Math.h"
+
+namespace MxEngine
+{
+    /*!
+    CPU mirrors of std140 uniform blocks declared in Engine/Shaders/Library. Members are ordered so that std140 rules
+    do not insert implicit padding, and every block is padded to 16 bytes. Binding points must match layout(binding) in GLSL
+    */
+
+    // Library/camera.glsl
+    struct CameraUniformBlock
+    {
+        static constexpr size_t Binding = 0;
+
+        Matrix4x4 ViewProjMatrix;
+        Matrix4x4 InvViewProjMatrix;
+        Vector3 Position;
+        float FogDistance;
+        Vector3 FogColor;
+        float FogDensity;
+    };
+
+    // Library/material.glsl
+    struct MaterialUniformBlock
+    {
+        static constexpr size_t Binding = 1;
+
+        Vector3 Color;
+        float Emmisive;
+        Vector2 UVMultipliers;
+        float Roughness;
+        float Metallic;
+        float Transparency;
+        float Padding[3];
+    };
+
+    // Library/directional_light.glsl
+    struct DirLightUniformBlock
+    {
+        static constexpr size_t Binding = 2;
+        static constexpr size_t MaxLightCount = 4;
+        static constexpr size_t CascadeCount = 3;
+
+        struct DirLight
+        {
+            Matrix4x4 Transform[CascadeCount];
+            Vector4 Color;
+            Vector3 Direction;
+            float Padding;
+        };
+
+        DirLight Lights[MaxLightCount];
+        int LightCount;
+        int Padding[3];
+    };
+
+    static_assert(sizeof(CameraUniformBlock) == 160, "camera block does not match std140 layout");
+    static_assert(sizeof(MaterialUniformBlock) == 48, "material block does not match std140 layout");
+    static_assert(sizeof(DirLightUniformBlock) == 912, "directional light block does not match std140 layout");
+}
@@ -0,0 +1,132 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "VisibilityCuller.h"
+#include "Core/Application/Jobs.h"
+
+#include <algorithm>
+
+namespace MxEngine
+{
+    constexpr size_t VisibilityWordsPerJob = 16;
+    constexpr size_t VisibilityRangeGroupsPerJob = 16;
+
+    void ComputeVisibilityInParallel(size_t unitCount, MxVector<uint64_t>& visibility, const std::function<void(size_t, size_t)>& func)
+    {
+        size_t wordCount = (unitCount + 63) / 64;
+        visibility.resize(wordCount);
+
+        // each job owns whole mask words, so no synchronization is needed while writing bits
+        Jobs::ParallelForRange(wordCount, VisibilityWordsPerJob, [unitCount, &func](size_t beginWord, size_t endWord)
+        {
+            func(beginWord * 64, Min(endWord * 64, unitCount));
+        });
+    }
+
+    void ResetVisibility(size_t unitCount, MxVector<uint64_t>& visibility)
+    {
+        visibility.assign((unitCount + 63) / 64, 0);
+    }
+
+    AABBArrayView MakeAABBArrayView(const RenderBounds& bounds)
+    {
+        return AABBArrayView{
+            bounds.CenterX.data(), bounds.CenterY.data(), bounds.CenterZ.data(),
+            bounds.ExtentX.data(), bounds.ExtentY.data(), bounds.ExtentZ.data(),
+        };
+    }
+
+    void SetUnitRangeVisible(MxVector<uint64_t>& visibility, size_t begin, size_t end)
+    {
+        while (begin < end)
+        {
+            size_t bit = begin % 64;
+            size_t count = Min(end - begin, 64 - bit);
+            uint64_t mask = count == 64 ? ~uint64_t(0) : ((uint64_t(1) << count) - 1) << bit;
+            visibility[begin / 64] |= mask;
+            begin += count;
+        }
+    }
+
+    void ComputeVisibility(const FrustrumCuller& culler, const AABBArrayView& boxes, size_t count, MxVector<uint64_t>& visibility)
+    {
+        // culler only sets bits of visible boxes, so mask is cleared first
+        ResetVisibility(count, visibility);
+        ComputeVisibilityInParallel(count, visibility, [&culler, &boxes, &visibility](size_t begin, size_t end)
+        {
+            culler.CullAABBs(boxes, begin, end, visibility.data());
+        });
+    }
+
+    void ComputeVisibility(const FrustrumCuller& culler, const RenderScene& scene, const RenderBounds& bounds, MxVector<uint64_t>& visibility)
+    {
+        size_t unitCount = bounds.CenterX.size();
+        if (scene.GetSubmittedUnitCount() != unitCount)
+        {
+            ComputeVisibility(culler, MakeAABBArrayView(bounds), unitCount, visibility);
+            return;
+        }
+
+        auto boxes = MakeAABBArrayView(bounds);
+        ResetVisibility(unitCount, visibility);
+
+        // fully visible ranges are marked while walking the tree, partially visible ones are collected and tested on workers
+        MxVector<std::pair<size_t, size_t>> partialRanges;
+        scene.QueryUnits(culler, [&visibility, &partialRanges](size_t firstUnit, size_t unitCount, bool fullyInside)
+        {
+            if (unitCount == 0) return;
+            if (fullyInside)
+                SetUnitRangeVisible(visibility, firstUnit, firstUnit + unitCount);
+            else
+                partialRanges.emplace_back(firstUnit, firstUnit + unitCount);
+        });
+        if (partialRanges.empty()) return;
+
+        // ranges which share mask word must be tested by the same job, so they are sorted and grouped by words they touch
+        std::sort(partialRanges.begin(), partialRanges.end());
+        MxVector<size_t> groupStarts;
+        size_t lastWord = std::numeric_limits<size_t>::max();
+        for (size_t i = 0; i < partialRanges.size(); i++)
+        {
+            if (partialRanges[i].first / 64 != lastWord)
+                groupStarts.push_back(i);
+            lastWord = (partialRanges[i].second - 1) / 64;
+        }
+        groupStarts.push_back(partialRanges.size());
+
+        Jobs::ParallelForRange(groupStarts.size() - 1, VisibilityRangeGroupsPerJob, 
+            [&culler, &boxes, &visibility, &partialRanges, &groupStarts](size_t beginGroup, size_t endGroup)
+        {
+            for (size_t i = groupStarts[beginGroup]; i < groupStarts[endGroup]; i++)
+            {
+                const auto& range = partialRanges[i];
+                culler.CullAABBs(boxes, range.first, range.second, visibility.data());
+            }
+        });
+    }
+}
@@ -0,0 +1,179 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <functional>
+
+#include "Core/Rendering/RenderPipeline.h"
+#include "Core/Rendering/RenderScene.h"
+#include "Core/Components/Instancing/InstanceFactory.h"
+#include "Utilities/Array/ArrayView.h"
+
+namespace MxEngine
+{
+    /*!
+    computes visibility of bounding boxes against frustrum. Boxes are tested in batches on job system workers
+    \param culler frustrum of camera or light
+    \param boxes bounding boxes of render units or instances
+    \param count number of boxes
+    \param visibility bitmask with one bit per box. Resized to fit all boxes
+    */
+    void ComputeVisibility(const FrustrumCuller& culler, const AABBArrayView& boxes, size_t count, MxVector<uint64_t>& visibility);
+    /*!
+    computes visibility of all submitted render units against frustrum using bounding volume hierarchy of render scene.
+    Units of objects which bounds are fully inside frustrum are marked visible without tests, other units are tested in batches.
+    If some units were not submitted through render scene, falls back to testing all bounding boxes
+    \param culler frustrum of camera or light
+    \param scene render scene which submitted units in current frame
+    \param bounds bounding boxes of render units
+    \param visibility bitmask with one bit per render unit. Resized to fit all units
+    */
+    void ComputeVisibility(const FrustrumCuller& culler, const RenderScene& scene, const RenderBounds& bounds, MxVector<uint64_t>& visibility);
+    /*!
+    computes visibility of bounding boxes using custom test. Boxes are tested on job system workers
+    \param boxes bounding boxes of render units or instances
+    \param count number of boxes
+    \param visibility bitmask with one bit per box. Resized to fit all boxes
+    \param isVisible thread-safe functor with signature `bool(const Vector3& center, const Vector3& extent)`
+    */
+    template<typename Predicate>
+    void ComputeVisibility(const AABBArrayView& boxes, size_t count, MxVector<uint64_t>& visibility, Predicate&& isVisible);
+    /*!
+    computes visibility of all submitted render units using custom test. Only units of objects which bounds overlap sphere are tested.
+    If some units were not submitted through render scene, falls back to testing all bounding boxes
+    \param sphere sphere which contains all units which can pass test
+    \param scene render scene which submitted units in current frame
+    \param bounds bounding boxes of render units
+    \param visibility bitmask with one bit per render unit. Resized to fit all units
+    \param isVisible functor with signature `bool(const Vector3& center, const Vector3& extent)`
+    */
+    template<typename Predicate>
+    void ComputeVisibility(const BoundingSphere& sphere, const RenderScene& scene, const RenderBounds& bounds, MxVector<uint64_t>& visibility, Predicate&& isVisible);
+
+    /*!
+    culls instances of all instanced render groups and sends visible ones to GPU. Sets VisibleInstanceCount of each instanced group
+    \param groups render groups of current frame
+    \param visibility temporary bitmask for instances
+    \param computeVisibility functor with signature `void(const AABBArrayView& boxes, size_t count, MxVector<uint64_t>& visibility)`
+    */
+    template<typename Func>
+    void PrepareInstances(ArrayView<RenderGroup> groups, MxVector<uint64_t>& visibility, Func&& computeVisibility);
+
+    /*!
+    checks bit of render unit in visibility mask
+    \param visibility bitmask computed by ComputeVisibility()
+    \param unitIndex index of render unit
+    \returns true if unit is visible, false otherwise
+    */
+    inline bool IsUnitVisible(const MxVector<uint64_t>& visibility, size_t unitIndex)
+    {
+        return (visibility[unitIndex / 64] >> (unitIndex % 64)) & 1;
+    }
+
+    /*!
+    resizes visibility mask and splits render units into chunks of whole mask words, which are processed on job system workers
+    \param unitCount number of render units
+    \param visibility bitmask to resize
+    \param func functor which computes mask words for units in range [begin, end)
+    */
+    void ComputeVisibilityInParallel(size_t unitCount, MxVector<uint64_t>& visibility, const std::function<void(size_t, size_t)>& func);
+    /*!
+    resizes visibility mask to fit all units and marks them as invisible
+    \param unitCount number of render units
+    \param visibility bitmask to reset
+    */
+    void ResetVisibility(size_t unitCount, MxVector<uint64_t>& visibility);
+    /*!
+    creates structure of arrays view over bounding boxes of render units
+    \param bounds bounding boxes of render units
+    \returns view over bounds arrays
+    */
+    AABBArrayView MakeAABBArrayView(const RenderBounds& bounds);
+
+    template<typename Predicate>
+    void ComputeVisibility(const AABBArrayView& boxes, size_t count, MxVector<uint64_t>& visibility, Predicate&& isVisible)
+    {
+        ComputeVisibilityInParallel(count, visibility, [&boxes, &visibility, &isVisible](size_t begin, size_t end)
+        {
+            for (size_t wordBegin = begin; wordBegin < end; wordBegin += 64)
+            {
+                size_t wordEnd = Min(wordBegin + 64, end);
+                uint64_t word = 0;
+                for (size_t i = wordBegin; i < wordEnd; i++)
+                {
+                    Vector3 center(boxes.CenterX[i], boxes.CenterY[i], boxes.CenterZ[i]);
+                    Vector3 extent(boxes.ExtentX[i], boxes.ExtentY[i], boxes.ExtentZ[i]);
+                    word |= uint64_t(isVisible(center, extent)) << (i - wordBegin);
+                }
+                visibility[wordBegin / 64] = word;
+            }
+        });
+    }
+
+    template<typename Predicate>
+    void ComputeVisibility(const BoundingSphere& sphere, const RenderScene& scene, const RenderBounds& bounds, MxVector<uint64_t>& visibility, Predicate&& isVisible)
+    {
+        size_t unitCount = bounds.CenterX.size();
+        if (scene.GetSubmittedUnitCount() != unitCount)
+        {
+            ComputeVisibility(MakeAABBArrayView(bounds), unitCount, visibility, std::forward<Predicate>(isVisible));
+            return;
+        }
+
+        ResetVisibility(unitCount, visibility);
+        scene.QueryUnits(sphere, [&bounds, &visibility, &isVisible](size_t firstUnit, size_t unitCount)
+        {
+            for (size_t i = firstUnit; i < firstUnit + unitCount; i++)
+            {
+                Vector3 center(bounds.CenterX[i], bounds.CenterY[i], bounds.CenterZ[i]);
+                Vector3 extent(bounds.ExtentX[i], bounds.ExtentY[i], bounds.ExtentZ[i]);
+                visibility[i / 64] |= uint64_t(isVisible(center, extent)) << (i % 64);
+            }
+        });
+    }
+
+    template<typename Func>
+    void PrepareInstances(ArrayView<RenderGroup> groups, MxVector<uint64_t>& visibility, Func&& computeVisibility)
+    {
+        const InstanceFactory* culledInstances = nullptr;
+        for (auto& group : groups)
+        {
+            if (group.Instances == nullptr) continue;
+
+            auto& instances = *group.Instances;
+            // LOD groups of one factory are submitted one after another and share its visibility
+            if (culledInstances != &instances)
+            {
+                computeVisibility(instances.GetInstanceBounds(), instances.GetBufferedCount(), visibility);
+                culledInstances = &instances;
+            }
+            group.VisibleInstanceCount = instances.SendVisibleInstancesToGPU(visibility, group.LODLevel);
+        }
+    }
+}
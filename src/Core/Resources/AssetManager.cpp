@@ -28,7 +28,13 @@
 
 #include "AssetManager.h"
 #include "Utilities/FileSystem/FileManager.h"
+#include "Utilities/Memory/SmallObjectAllocator.h"
+#include "Utilities/Logging/Logger.h"
 #include "Core/Components/Rendering/MeshRenderer.h"
+#include "Core/Application/Application.h"
+#include "Utilities/ObjectLoading/ObjectLoader.h"
+#include "Utilities/Image/ImageLoader.h"
+#include "Utilities/Audio/AudioLoader.h"
 
 namespace MxEngine
 {
@@ -48,8 +54,30 @@ namespace MxEngine
         }
     }
 
+    AsyncAssetLoaderImpl& GetAssetLoader()
+    {
+        return Application::GetImpl()->GetAssetLoader();
+    }
+
+    /*!
+    owns audio samples decoded by loader thread until they are uploaded to audio buffer
+    */
+    struct DecodedAudio
+    {
+        AudioData Audio;
+
+        DecodedAudio() = default;
+        DecodedAudio(const DecodedAudio&) = delete;
+        DecodedAudio& operator=(const DecodedAudio&) = delete;
+        ~DecodedAudio()
+        {
+            if (this->Audio.data != nullptr) AudioLoader::Free(this->Audio);
+        }
+    };
+
     CubeMapHandle AssetManager::LoadCubeMap(StringId hash)
     {
+        MemoryTagScope memoryTag(MemoryTag::ASSETS);
         auto& path = FileManager::GetFilePath(hash);
         return GraphicFactory::Create<CubeMap>(path);
     }
@@ -72,6 +100,7 @@ namespace MxEngine
 
     CubeMapHandle AssetManager::LoadCubeMap(StringId right, StringId left, StringId top, StringId bottom, StringId front, StringId back)
     {
+        MemoryTagScope memoryTag(MemoryTag::ASSETS);
         auto cubemap = GraphicFactory::Create<CubeMap>();
 
         cubemap->Load(
@@ -119,6 +148,7 @@ namespace MxEngine
 
     TextureHandle AssetManager::LoadTexture(StringId hash, TextureFormat format)
     {
+        MemoryTagScope memoryTag(MemoryTag::ASSETS);
         auto path = FileManager::GetFilePath(hash);
         return GraphicFactory::Create<Texture>(path,format);
     }
@@ -314,4 +344,178 @@ namespace MxEngine
     {
         return AssetManager::LoadAudio(FilePath(path));
     }
-}
\ No newline at end of file
+
+    AsyncAsset<CubeMapHandle> AssetManager::LoadCubeMapAsync(StringId hash, AssetLoadPriority priority)
+    {
+        MemoryTagScope memoryTag(MemoryTag::ASSETS);
+        auto path = FileManager::GetFilePath(hash);
+        auto cubemap = GraphicFactory::Create<CubeMap>();
+        auto image = MakeRef<Image>();
+
+        auto state = GetAssetLoader().Submit(priority,
+            [path, image]()
+            {
+                MemoryTagScope memoryTag(MemoryTag::ASSETS);
+                bool flipImage = false;
+                *image = ImageLoader::LoadImage(path, flipImage);
+                if (image->GetRawData() == nullptr)
+                {
+                    MXLOG_WARNING("OpenGL::CubeMap", "file with name '" + ToMxString(path) + "' was not found");
+                    return false;
+                }
+                return true;
+            },
+            [path, image, cubemap]() mutable
+            {
+                cubemap->Load(*image, path);
+            });
+        return { cubemap, state };
+    }
+
+    AsyncAsset<CubeMapHandle> AssetManager::LoadCubeMapAsync(const FilePath& path, AssetLoadPriority priority)
+    {
+        auto hash = FileManager::RegisterExternalResource(path);
+        return AssetManager::LoadCubeMapAsync(hash, priority);
+    }
+
+    AsyncAsset<CubeMapHandle> AssetManager::LoadCubeMapAsync(const MxString& path, AssetLoadPriority priority)
+    {
+        return AssetManager::LoadCubeMapAsync(ToFilePath(path), priority);
+    }
+
+    AsyncAsset<CubeMapHandle> AssetManager::LoadCubeMapAsync(const char* path, AssetLoadPriority priority)
+    {
+        return AssetManager::LoadCubeMapAsync(FilePath(path), priority);
+    }
+
+    AsyncAsset<TextureHandle> AssetManager::LoadTextureAsync(StringId hash, TextureFormat format, AssetLoadPriority priority)
+    {
+        MemoryTagScope memoryTag(MemoryTag::ASSETS);
+        auto path = FileManager::GetFilePath(hash);
+        auto texture = GraphicFactory::Create<Texture>();
+        auto image = MakeRef<Image>();
+
+        auto state = GetAssetLoader().Submit(priority,
+            [path, image]()
+            {
+                MemoryTagScope memoryTag(MemoryTag::ASSETS);
+                bool flipImage = true;
+                *image = ImageLoader::LoadImage(path, flipImage);
+                if (image->GetRawData() == nullptr)
+                {
+                    MXLOG_ERROR("Texture", "file with name '" + ToMxString(path) + "' was not found or cannot be loaded");
+                    return false;
+                }
+                return true;
+            },
+            [path, image, texture, format]() mutable
+            {
+                texture->Load(*image, path, format);
+            });
+        return { texture, state };
+    }
+
+    AsyncAsset<TextureHandle> AssetManager::LoadTextureAsync(const FilePath& path, TextureFormat format, AssetLoadPriority priority)
+    {
+        auto hash = FileManager::RegisterExternalResource(path);
+        return AssetManager::LoadTextureAsync(hash, format, priority);
+    }
+
+    AsyncAsset<TextureHandle> AssetManager::LoadTextureAsync(const MxString& path, TextureFormat format, AssetLoadPriority priority)
+    {
+        return AssetManager::LoadTextureAsync(ToFilePath(path), format, priority);
+    }
+
+    AsyncAsset<TextureHandle> AssetManager::LoadTextureAsync(const char* path, TextureFormat format, AssetLoadPriority priority)
+    {
+        return AssetManager::LoadTextureAsync(FilePath(path), format, priority);
+    }
+
+    AsyncAsset<MeshHandle> AssetManager::LoadMeshAsync(StringId hash, AssetLoadPriority priority)
+    {
+        auto path = std::filesystem::proximate(FileManager::GetFilePath(hash));
+        auto mesh = ResourceFactory::Create<Mesh>();
+        auto data = MakeRef<MeshImportData>();
+
+        auto state = GetAssetLoader().Submit(priority,
+            [path, data]()
+            {
+                *data = Mesh::Import(path);
+                return data->Cache.Header != nullptr || !data->SubMeshes.empty();
+            },
+            [path, data, mesh]() mutable
+            {
+                mesh->Upload(path, *data);
+            });
+        return { mesh, state };
+    }
+
+    AsyncAsset<MeshHandle> AssetManager::LoadMeshAsync(const FilePath& path, AssetLoadPriority priority)
+    {
+        auto localPath = RegisterExternalFolder(path);
+        auto hash = FileManager::RegisterExternalResource(localPath);
+        return AssetManager::LoadMeshAsync(hash, priority);
+    }
+
+    AsyncAsset<MeshHandle> AssetManager::LoadMeshAsync(const MxString& path, AssetLoadPriority priority)
+    {
+        return AssetManager::LoadMeshAsync(ToFilePath(path), priority);
+    }
+
+    AsyncAsset<MeshHandle> AssetManager::LoadMeshAsync(const char* path, AssetLoadPriority priority)
+    {
+        return AssetManager::LoadMeshAsync(FilePath(path), priority);
+    }
+
+    AsyncAsset<AudioBufferHandle> AssetManager::LoadAudioAsync(StringId hash, AssetLoadPriority priority)
+    {
+        auto path = FileManager::GetFilePath(hash);
+        auto buffer = AudioFactory::Create<AudioBuffer>();
+        auto decoded = MakeRef<DecodedAudio>();
+
+        auto state = GetAssetLoader().Submit(priority,
+            [path, decoded]()
+            {
+                auto& audio = decoded->Audio;
+                audio = AudioLoader::Load(path);
+                if (audio.data == nullptr)
+                {
+                    MXLOG_ERROR("MxEngine::AudioLoader", "audio file was not loaded: " + ToMxString(path));
+                    return false;
+                }
+                if (audio.channels != 1)
+                {
+                    auto copy = audio;
+                    audio = AudioLoader::ConvertToMono(audio);
+                    AudioLoader::Free(copy);
+                }
+                return true;
+            },
+            [path, decoded, buffer]() mutable
+            {
+                buffer->Load(decoded->Audio, path);
+            });
+        return { buffer, state };
+    }
+
+    AsyncAsset<AudioBufferHandle> AssetManager::LoadAudioAsync(const FilePath& path, AssetLoadPriority priority)
+    {
+        auto hash = FileManager::RegisterExternalResource(path);
+        return AssetManager::LoadAudioAsync(hash, priority);
+    }
+
+    AsyncAsset<AudioBufferHandle> AssetManager::LoadAudioAsync(const MxString& path, AssetLoadPriority priority)
+    {
+        return AssetManager::LoadAudioAsync(ToFilePath(path), priority);
+    }
+
+    AsyncAsset<AudioBufferHandle> AssetManager::LoadAudioAsync(const char* path, AssetLoadPriority priority)
+    {
+        return AssetManager::LoadAudioAsync(FilePath(path), priority);
+    }
+
+    void AssetManager::FlushAsyncLoads()
+    {
+        GetAssetLoader().Flush();
+    }
+}
@@ -33,6 +33,7 @@
 #include "Core/Resources/Material.h"
 #include "Platform/GraphicAPI.h"
 #include "Platform/AudioAPI.h"
+#include "Core/Resources/AsyncAssetLoader.h"
 #include "Utilities/FileSystem/File.h"
 
 namespace MxEngine
@@ -92,5 +93,27 @@ namespace MxEngine
         static AudioBufferHandle LoadAudio(const FilePath& path);
         static AudioBufferHandle LoadAudio(const MxString& path);
         static AudioBufferHandle LoadAudio(const char* path);
+
+        static AsyncAsset<CubeMapHandle> LoadCubeMapAsync(StringId hash, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+        static AsyncAsset<CubeMapHandle> LoadCubeMapAsync(const FilePath& path, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+        static AsyncAsset<CubeMapHandle> LoadCubeMapAsync(const MxString& path, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+        static AsyncAsset<CubeMapHandle> LoadCubeMapAsync(const char* path, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+
+        static AsyncAsset<TextureHandle> LoadTextureAsync(StringId hash, TextureFormat format = TextureFormat::RGB, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+        static AsyncAsset<TextureHandle> LoadTextureAsync(const FilePath& path, TextureFormat format = TextureFormat::RGB, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+        static AsyncAsset<TextureHandle> LoadTextureAsync(const MxString& path, TextureFormat format = TextureFormat::RGB, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+        static AsyncAsset<TextureHandle> LoadTextureAsync(const char* path, TextureFormat format = TextureFormat::RGB, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+
+        static AsyncAsset<MeshHandle> LoadMeshAsync(StringId hash, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+        static AsyncAsset<MeshHandle> LoadMeshAsync(const FilePath& path, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+        static AsyncAsset<MeshHandle> LoadMeshAsync(const MxString& path, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+        static AsyncAsset<MeshHandle> LoadMeshAsync(const char* path, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+
+        static AsyncAsset<AudioBufferHandle> LoadAudioAsync(StringId hash, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+        static AsyncAsset<AudioBufferHandle> LoadAudioAsync(const FilePath& path, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+        static AsyncAsset<AudioBufferHandle> LoadAudioAsync(const MxString& path, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+        static AsyncAsset<AudioBufferHandle> LoadAudioAsync(const char* path, AssetLoadPriority priority = AssetLoadPriority::NORMAL);
+
+        static void FlushAsyncLoads();
     };
 }
\ No newline at end of file
@@ -0,0 +1,231 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "AsyncAssetLoader.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Format/Format.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace MxEngine
+{
+    AsyncAssetLoaderImpl::~AsyncAssetLoaderImpl()
+    {
+        this->Destroy();
+    }
+
+    void AsyncAssetLoaderImpl::Init(size_t threadCount)
+    {
+        if (this->isRunning) return;
+        threadCount = threadCount == 0 ? 1 : threadCount;
+
+        this->isRunning = true;
+        this->workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; i++)
+        {
+            this->workers.emplace_back([this]() { this->WorkerLoop(); });
+        }
+        MXLOG_INFO("MxEngine::AsyncAssetLoader", MxFormat("started {0} asset loader threads", threadCount));
+    }
+
+    void AsyncAssetLoaderImpl::Destroy()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->queueMutex);
+            if (!this->isRunning) return;
+            this->isRunning = false;
+        }
+        this->queueCondition.notify_all();
+
+        for (auto& worker : this->workers)
+        {
+            if (worker.joinable()) worker.join();
+        }
+        this->workers.clear();
+
+        // requests hold resource handles, so they are released here on main thread and not by loader threads
+        for (auto& request : this->queued)
+        {
+            request.State->Cancel();
+            this->Finish(request, AssetLoadStatus::CANCELLED);
+        }
+        for (auto& request : this->decoded)
+        {
+            request.State->Cancel();
+            this->Finish(request, AssetLoadStatus::CANCELLED);
+        }
+        this->queued.clear();
+        this->decoded.clear();
+    }
+
+    Ref<AssetLoadState> AsyncAssetLoaderImpl::Submit(AssetLoadPriority priority, DecodeFunction decode, UploadFunction upload)
+    {
+        Request request;
+        request.State = MakeRef<AssetLoadState>();
+        request.State->SetPriority(priority);
+        request.Decode = std::move(decode);
+        request.Upload = std::move(upload);
+        auto state = request.State;
+
+        this->unfinishedCount.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::unique_lock<std::mutex> lock(this->queueMutex);
+            if (this->isRunning)
+            {
+                request.Sequence = this->nextSequence++;
+                this->queued.push_back(std::move(request));
+                lock.unlock();
+                this->queueCondition.notify_one();
+                return state;
+            }
+        }
+
+        // loader is not started, so asset is loaded synchronously
+        state->status.store(AssetLoadStatus::DECODING, std::memory_order_release);
+        if (request.Decode())
+        {
+            state->status.store(AssetLoadStatus::UPLOADING, std::memory_order_release);
+            request.Upload();
+            this->Finish(request, AssetLoadStatus::READY);
+        }
+        else
+        {
+            this->Finish(request, AssetLoadStatus::FAILED);
+        }
+        return state;
+    }
+
+    bool AsyncAssetLoaderImpl::IsProcessedBefore(const Request& r1, const Request& r2)
+    {
+        auto p1 = r1.State->GetPriority();
+        auto p2 = r2.State->GetPriority();
+        if (p1 != p2) return p1 > p2;
+        return r1.Sequence < r2.Sequence;
+    }
+
+    void AsyncAssetLoaderImpl::WorkerLoop()
+    {
+        while (true)
+        {
+            Request request;
+            {
+                std::unique_lock<std::mutex> lock(this->queueMutex);
+                this->queueCondition.wait(lock, [this]() { return !this->isRunning || !this->queued.empty(); });
+                if (!this->isRunning) return;
+
+                auto next = std::min_element(this->queued.begin(), this->queued.end(), IsProcessedBefore);
+                request = std::move(*next);
+                this->queued.erase(next);
+            }
+
+            // cancelled requests are not decoded, but still passed to main thread which releases them
+            auto status = AssetLoadStatus::QUEUED;
+            if (request.State->status.compare_exchange_strong(status, AssetLoadStatus::DECODING, std::memory_order_acq_rel))
+            {
+                bool isDecoded = request.Decode();
+                status = AssetLoadStatus::DECODING;
+                request.State->status.compare_exchange_strong(status, isDecoded ? AssetLoadStatus::DECODED : AssetLoadStatus::FAILED, std::memory_order_acq_rel);
+            }
+
+            std::lock_guard<std::mutex> lock(this->decodedMutex);
+            this->decoded.push_back(std::move(request));
+        }
+    }
+
+    void AsyncAssetLoaderImpl::Finish(Request& request, AssetLoadStatus status)
+    {
+        auto current = request.State->GetStatus();
+        if (current != AssetLoadStatus::CANCELLED && current != AssetLoadStatus::FAILED)
+            request.State->status.store(status, std::memory_order_release);
+
+        request.Decode = nullptr;
+        request.Upload = nullptr;
+        this->unfinishedCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void AsyncAssetLoaderImpl::Update(float budgetMilliseconds)
+    {
+        MAKE_SCOPE_PROFILER("AsyncAssetLoader::Update()");
+
+        MxVector<Request> requests;
+        {
+            std::lock_guard<std::mutex> lock(this->decodedMutex);
+            if (this->decoded.empty()) return;
+            std::swap(requests, this->decoded);
+        }
+        std::sort(requests.begin(), requests.end(), IsProcessedBefore);
+
+        using Clock = std::chrono::steady_clock;
+        auto start = Clock::now();
+        auto budget = std::chrono::duration<float, std::milli>(budgetMilliseconds);
+        bool uploadedAny = false;
+
+        size_t processed = 0;
+        for (; processed < requests.size(); processed++)
+        {
+            auto& request = requests[processed];
+            auto status = AssetLoadStatus::DECODED;
+            if (request.State->GetStatus() == status)
+            {
+                if (uploadedAny && Clock::now() - start >= budget) break;
+
+                if (request.State->status.compare_exchange_strong(status, AssetLoadStatus::UPLOADING, std::memory_order_acq_rel))
+                {
+                    request.Upload();
+                    uploadedAny = true;
+                }
+            }
+            this->Finish(request, AssetLoadStatus::READY);
+        }
+
+        if (processed < requests.size())
+        {
+            std::lock_guard<std::mutex> lock(this->decodedMutex);
+            for (size_t i = processed; i < requests.size(); i++)
+                this->decoded.push_back(std::move(requests[i]));
+        }
+    }
+
+    void AsyncAssetLoaderImpl::Flush()
+    {
+        MAKE_SCOPE_PROFILER("AsyncAssetLoader::Flush()");
+        while (this->GetUnfinishedCount() > 0)
+        {
+            this->Update(std::numeric_limits<float>::max());
+            if (this->GetUnfinishedCount() > 0) std::this_thread::yield();
+        }
+    }
+
+    size_t AsyncAssetLoaderImpl::GetUnfinishedCount() const
+    {
+        return this->unfinishedCount.load(std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,208 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include "Utilities/Memory/Memory.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+    /*!
+    priority of asynchronous asset load. Requests with higher priority are decoded and uploaded first,
+    requests with same priority are processed in order of submission
+    */
+    enum class AssetLoadPriority : uint8_t
+    {
+        LOW,
+        NORMAL,
+        HIGH,
+    };
+
+    /*!
+    stage of asynchronous asset load
+    */
+    enum class AssetLoadStatus : uint8_t
+    {
+        QUEUED,    // waiting for loader thread
+        DECODING,  // file is read and decoded by loader thread
+        DECODED,   // decoded data is waiting for upload on main thread
+        UPLOADING, // data is uploaded to graphic/audio API
+        READY,     // resource is loaded and can be used
+        FAILED,    // file was not found or cannot be decoded, resource is left as placeholder
+        CANCELLED, // load was cancelled by user, resource is left as placeholder
+    };
+
+    /*!
+    load state is shared between asset loader and user. It can be queried and modified from any thread
+    */
+    class AssetLoadState
+    {
+        std::atomic<AssetLoadStatus> status{ AssetLoadStatus::QUEUED };
+        std::atomic<AssetLoadPriority> priority{ AssetLoadPriority::NORMAL };
+
+        friend class AsyncAssetLoaderImpl;
+    public:
+        /*!
+        getter for current stage of load
+        \returns load status
+        */
+        AssetLoadStatus GetStatus() const { return this->status.load(std::memory_order_acquire); }
+        /*!
+        getter for load priority
+        \returns priority of load
+        */
+        AssetLoadPriority GetPriority() const { return this->priority.load(std::memory_order_relaxed); }
+        /*!
+        changes priority of load. Has effect only if asset is not decoded or uploaded yet
+        \param priority new priority
+        */
+        void SetPriority(AssetLoadPriority priority) { this->priority.store(priority, std::memory_order_relaxed); }
+        /*!
+        checks if load is finished, successfully or not
+        \returns true if status is READY, FAILED or CANCELLED
+        */
+        bool IsFinished() const
+        {
+            auto status = this->GetStatus();
+            return status == AssetLoadStatus::READY || status == AssetLoadStatus::FAILED || status == AssetLoadStatus::CANCELLED;
+        }
+        /*!
+        cancels load. Decoded data is dropped without upload. Has no effect if resource is already being uploaded or loaded
+        \returns true if load was cancelled, false otherwise
+        */
+        bool Cancel()
+        {
+            auto status = this->GetStatus();
+            while (status == AssetLoadStatus::QUEUED || status == AssetLoadStatus::DECODING || status == AssetLoadStatus::DECODED)
+            {
+                if (this->status.compare_exchange_weak(status, AssetLoadStatus::CANCELLED, std::memory_order_acq_rel))
+                    return true;
+            }
+            return status == AssetLoadStatus::CANCELLED;
+        }
+    };
+
+    /*!
+    result of asynchronous asset load. Resource handle is valid immediately and refers to placeholder (empty) resource,
+    which is filled with actual data on main thread after load is finished
+    */
+    template<typename Handle>
+    struct AsyncAsset
+    {
+        Handle Resource;
+        Ref<AssetLoadState> State;
+
+        bool IsReady() const { return this->State != nullptr && this->State->GetStatus() == AssetLoadStatus::READY; }
+        bool IsFinished() const { return this->State == nullptr || this->State->IsFinished(); }
+        bool Cancel() { return this->State != nullptr && this->State->Cancel(); }
+    };
+
+    /*!
+    asynchronous asset loader reads and decodes files on dedicated loader threads and uploads decoded data on main thread.
+    Dedicated threads are used instead of job system, because decoding takes much longer than frame jobs and must not be picked up
+    by main thread while it waits for job completion. Upload is limited by per-frame time budget to avoid frame hitches
+    */
+    class AsyncAssetLoaderImpl
+    {
+    public:
+        /*!
+        invoked on loader thread. Reads and decodes asset, returns false if asset cannot be loaded
+        */
+        using DecodeFunction = std::function<bool()>;
+        /*!
+        invoked on main thread. Uploads decoded data into placeholder resource
+        */
+        using UploadFunction = std::function<void()>;
+    private:
+        struct Request
+        {
+            Ref<AssetLoadState> State;
+            DecodeFunction Decode;
+            UploadFunction Upload;
+            uint64_t Sequence = 0;
+        };
+
+        MxVector<std::thread> workers;
+        MxVector<Request> queued;
+        MxVector<Request> decoded;
+        std::mutex queueMutex;
+        std::mutex decodedMutex;
+        std::condition_variable queueCondition;
+        std::atomic<size_t> unfinishedCount{ 0 };
+        uint64_t nextSequence = 0;
+        bool isRunning = false;
+
+        void WorkerLoop();
+        void Finish(Request& request, AssetLoadStatus status);
+        static bool IsProcessedBefore(const Request& r1, const Request& r2);
+    public:
+        AsyncAssetLoaderImpl() = default;
+        AsyncAssetLoaderImpl(const AsyncAssetLoaderImpl&) = delete;
+        AsyncAssetLoaderImpl& operator=(const AsyncAssetLoaderImpl&) = delete;
+        ~AsyncAssetLoaderImpl();
+
+        /*!
+        starts loader threads
+        \param threadCount number of threads which decode assets. If zero, single thread is used
+        */
+        void Init(size_t threadCount);
+        /*!
+        cancels all unfinished loads and joins loader threads. Must be called before resources are released
+        */
+        void Destroy();
+        /*!
+        schedules asset load
+        \param priority initial priority of load
+        \param decode functor invoked on loader thread
+        \param upload functor invoked on main thread if decoding succeeded
+        \returns shared load state
+        */
+        Ref<AssetLoadState> Submit(AssetLoadPriority priority, DecodeFunction decode, UploadFunction upload);
+        /*!
+        uploads decoded assets in priority order until time budget is exhausted. At least one asset is uploaded per call. Must be called on main thread
+        \param budgetMilliseconds time limit for uploads
+        */
+        void Update(float budgetMilliseconds);
+        /*!
+        blocks until all submitted loads are finished, uploading them without time limit. Must be called on main thread
+        */
+        void Flush();
+        /*!
+        getter for number of loads which are not finished yet
+        \returns count of queued, decoding and not uploaded assets
+        */
+        size_t GetUnfinishedCount() const;
+    };
+}
@@ -27,90 +27,103 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Mesh.h"
-#include "Utilities/ObjectLoading/ObjectLoader.h"
+#include "Utilities/ObjectLoading/AssetCooker.h"
+#include "Utilities/Logging/Logger.h"
 #include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Memory/SmallObjectAllocator.h"
 #include "Platform/GraphicAPI.h"
 #include "Utilities/Format/Format.h"
 #include "Core/Resources/AssetManager.h"
-#include "Core/Components/Rendering/MeshRenderer.h"
+#include "Core/Config/GlobalConfig.h"
 #include "Core/Runtime/Reflection.h"
 
 #include <algorithm>
 
 namespace MxEngine
 {
-	template<>
-	void Mesh::LoadFromFile(const std::filesystem::path& filepath)
+	MeshImportData Mesh::Import(const FilePath& filepath)
 	{
-		ObjectInfo objectInfo = ObjectLoader::Load(filepath);
-
-		this->filepath = ToMxString(filepath);
-		std::replace(this->filepath.begin(), this->filepath.end(), '\\', '/');
+		MemoryTagScope memoryTag(MemoryTag::ASSETS);
+		MeshImportData result;
 
-		MxVector<SubMesh::MaterialId> materialIds;
-		materialIds.reserve(objectInfo.meshes.size());
-		for (const auto& group : objectInfo.meshes)
+		// cooked asset is loaded from mapped mesh cache without touching source file importer
+		CookedAssetManifest manifest;
+		if (AssetCooker::LoadManifest(filepath, manifest))
 		{
-			if (group.useTexture && group.material != nullptr)
-			{
-				auto offset = size_t(group.material - objectInfo.materials.data());
-				materialIds.push_back(offset);
-			}
-			else
+			int64_t cookedWriteTime = manifest.SourceWriteTime;
+			if (AssetCooker::IsUpToDate(filepath, manifest))
 			{
-				materialIds.push_back(std::numeric_limits<SubMesh::MaterialId>::max());
+				FilePath cachePath = filepath.native() + Mesh::GetCacheFileExtension().native();
+				if (result.CacheFile.Open(cachePath) && ObjectLoader::LoadMeshCache(result.CacheFile, manifest.SourceHash, result.Cache))
+				{
+					// source was only touched, new write time is stored so source is not hashed on every load
+					if (manifest.SourceWriteTime != cookedWriteTime && GlobalConfig::HasCookAssetsOnLoad())
+						AssetCooker::SaveManifest(filepath, manifest);
+					return result;
+				}
+				result.CacheFile.Close();
 			}
 		}
 
-		// dump all material to let user retrieve them for MeshRenderer component
-		FilePath materialLibPath = filepath.native() + MeshRenderer::GetMaterialFileExtenstion().native();
-		ObjectLoader::DumpMaterials(objectInfo.materials, materialLibPath);
+		// cooking produces material library, textures and mesh cache once, so next loads only read them
+		if (GlobalConfig::HasCookAssetsOnLoad())
+		{
+			AssetCooker::CookMesh(filepath, result);
+			return result;
+		}
+
+		// assets are deployed without cooked files, import object into memory without writing anything to disk
+		MXLOG_WARNING("MxEngine::Mesh", "object is not cooked and will be imported on each load: " + ToMxString(filepath));
+		bool allowFileWrites = false;
+		ObjectLoader::MergeMeshes(ObjectLoader::Load(filepath, allowFileWrites), result);
+		return result;
+	}
+
+	void Mesh::Upload(const FilePath& filepath, const MeshImportData& data)
+	{
+		MAKE_SCOPE_PROFILER("Mesh::Upload()");
+		MemoryTagScope memoryTag(MemoryTag::ASSETS);
+
+		this->filepath = ToMxString(filepath);
+		std::replace(this->filepath.begin(), this->filepath.end(), '\\', '/');
+
+		// mapped cache and freshly imported data have the same layout, only storage differs
+		bool isCached = data.Cache.Header != nullptr;
+		const MeshCacheSubMesh* submeshes = isCached ? data.Cache.SubMeshes : data.SubMeshes.data();
+		const Vertex* vertecies = isCached ? data.Cache.Vertecies : data.Vertecies.data();
+		const uint32_t* indicies = isCached ? data.Cache.Indicies : data.Indicies.data();
+		size_t submeshCount = isCached ? (size_t)data.Cache.Header->SubMeshCount : data.SubMeshes.size();
+		size_t vertexCount = isCached ? (size_t)data.Cache.Header->VertexCount : data.Vertecies.size();
+		size_t indexCount = isCached ? (size_t)data.Cache.Header->IndexCount : data.Indicies.size();
 
 		// optimize transform additions
-		this->subMeshTransforms.reserve(objectInfo.meshes.size());
+		this->subMeshTransforms.reserve(submeshCount);
+		this->ReserveData(vertexCount, indexCount);
 
-		// precompute and allocate size for per-mesh Vertex Buffer and Index Buffer
-		size_t totalVerticies = 0;
-		size_t totalIndicies = 0;
-		for (const auto& meshInfo : objectInfo.meshes)
-		{
-			totalVerticies += meshInfo.vertecies.size();
-			totalIndicies += meshInfo.indicies.size();
-		}
-		// create CPU-side array for verticies and indicies, and GPU-size VBO/IBO
-		MxVector<Vertex> verticies;
-		MxVector<IndexBuffer::IndexType> indicies;
-		verticies.reserve(totalVerticies);
-		indicies.reserve(totalIndicies);
-		this->ReserveData(totalVerticies, totalIndicies);
-
-		// insert all verticies and indicies into single VBO/IBO
-		for (size_t i = 0; i < objectInfo.meshes.size(); i++)
+		for (size_t i = 0; i < submeshCount; i++)
 		{
-			auto& meshInfo = objectInfo.meshes[i];
-			auto& materialId = materialIds[i];
-			
-			MeshData meshData{ 
-				this->VBO, meshInfo.vertecies.size(), verticies.size(),
-				this->IBO, meshInfo.indicies.size(), indicies.size()
+			const auto& entry = submeshes[i];
+			MeshData meshData{
+				this->VBO, (size_t)entry.VertexCount, (size_t)entry.VertexOffset,
+				this->IBO, (size_t)entry.IndexCount, (size_t)entry.IndexOffset
 			};
-			meshData.UpdateBoundingGeometry(meshInfo.vertecies);
-
-			// apply vertex offset to each index
-			for (const auto& index : meshInfo.indicies)
-				indicies.push_back(index + verticies.size());
-			// no additional operations for verticies
-			verticies.insert(verticies.end(), meshInfo.vertecies.begin(), meshInfo.vertecies.end());
-
-			this->AddSubMesh(materialId, std::move(meshData));
+			meshData.SetBoundingGeometry(AABB{ entry.AABBMin, entry.AABBMax }, BoundingSphere(entry.SphereCenter, entry.SphereRadius));
+			this->AddSubMesh((SubMesh::MaterialId)entry.MaterialId, std::move(meshData));
 		}
-		// load verticies and indicies to GPU
-		this->VBO->BufferSubData((float*)verticies.data(), verticies.size() * Vertex::Size);
-		this->IBO->BufferSubData(indicies.data(), indicies.size());
+		// load verticies and indicies to GPU. Cached blobs are uploaded directly from mapped memory
+		this->VBO->BufferSubData((const float*)vertecies, vertexCount * Vertex::Size);
+		this->IBO->BufferSubData(indicies, indexCount);
 
 		this->UpdateBoundingGeometry(); // use submeshes boundings to update mesh boundings
 	}
 
+	template<>
+	void Mesh::LoadFromFile(const std::filesystem::path& filepath)
+	{
+		auto data = Mesh::Import(filepath);
+		this->Upload(filepath, data);
+	}
+
 	Mesh::Mesh()
 	{
 		this->filepath = MXENGINE_MAKE_INTERNAL_TAG("empty");
@@ -147,6 +160,12 @@ namespace MxEngine
 		this->Load(ToFilePath(filepath));
 	}
 
+	const FilePath& Mesh::GetCacheFileExtension()
+	{
+		const static FilePath cacheFileExtension = ".mx_meshcache";
+		return cacheFileExtension;
+	}
+
 	void Mesh::ReserveData(size_t vertexCount, size_t indexCount)
 	{
 		this->VBO->Load(nullptr, vertexCount * Vertex::Size, UsageType::STATIC_DRAW);
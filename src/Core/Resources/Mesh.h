@@ -37,6 +37,7 @@
 namespace MxEngine
 {
 	class MeshRenderer;
+	struct MeshImportData;
 	
 	class Mesh
 	{
@@ -70,6 +71,7 @@ namespace MxEngine
 		void Load(const MxString& filepath);
 		template<typename FilePath> void Load(const FilePath& filepath);
 
+		void Upload(const FilePath& filepath, const MeshImportData& data);
 		void ReserveData(size_t vertexCount, size_t indexCount);
 		void UpdateBoundingGeometry();
 		size_t AddInstancedBuffer(VertexBufferHandle vbo, ArrayView<VertexLayout> layout);
@@ -92,5 +94,8 @@ namespace MxEngine
 		const MxString& GetFilePath() const;
 		void SetInternalEngineTag(const MxString& tag);
 		bool IsInternalEngineResource() const;
+
+		static MeshImportData Import(const FilePath& filepath);
+		static const FilePath& GetCacheFileExtension();
 	};
 }
\ No newline at end of file
@@ -87,46 +87,71 @@ namespace MxEngine
 
     void MeshData::BufferIndicies(const IndexData& indicies)
     {
-        this->IBO->BufferSubData(indicies.data(), this->indexCount, this->indexOffset);
+        MX_ASSERT(indicies.size() == this->indexCount);
+        if (this->vertexOffset == 0)
+        {
+            this->IBO->BufferSubData(indicies.data(), this->indexCount, this->indexOffset);
+            return;
+        }
+
+        // indicies are local to submesh vertecies, but index buffer is shared and addresses whole vertex buffer
+        IndexData offsetIndicies(indicies.size());
+        for (size_t i = 0; i < indicies.size(); i++)
+            offsetIndicies[i] = indicies[i] + (uint32_t)this->vertexOffset;
+        this->IBO->BufferSubData(offsetIndicies.data(), this->indexCount, this->indexOffset);
     }
 
     void MeshData::UpdateBoundingGeometry(const VertexData& vertecies)
     {
-        this->boundingBox = { MakeVector3(0.0f), MakeVector3(0.0f) };
-        if (vertecies.size() > 0)
-        {
-            this->boundingBox = { vertecies[0].Position, vertecies[0].Position };
-            for (const auto& vertex : vertecies)
-            {
-                this->boundingBox.Min = VectorMin(this->boundingBox.Min, vertex.Position);
-                this->boundingBox.Max = VectorMax(this->boundingBox.Max, vertex.Position);
-            }
-        }
+        MeshData::ComputeBoundingGeometry(vertecies, this->boundingBox, this->boundingSphere);
+    }
 
-        auto center = this->boundingBox.GetCenter();
-        float maxRadius = 0.0f;
-        for (const auto& vertex : vertecies)
-        {
-            auto distance = vertex.Position - center;
-            maxRadius = Max(maxRadius, Length2(distance));
-        }
-        this->boundingSphere = BoundingSphere(center, std::sqrt(maxRadius));
+    void MeshData::SetBoundingGeometry(const AABB& boundingBox, const BoundingSphere& boundingSphere)
+    {
+        this->boundingBox = boundingBox;
+        this->boundingSphere = boundingSphere;
     }
 
     MeshData::VertexData MeshData::GetVerteciesFromGPU() const
     {
         VertexData vertecies(this->GetVerteciesCount());
-        this->VBO->GetBufferData((float*)vertecies.data(), vertecies.size() * Vertex::Size);
+        this->VBO->GetBufferData((float*)vertecies.data(), vertecies.size() * Vertex::Size, this->vertexOffset * Vertex::Size);
         return vertecies;
     }
 
     MeshData::IndexData MeshData::GetIndiciesFromGPU() const
     {
         IndexData indicies(this->GetIndiciesCount());
-        this->IBO->GetBufferData(indicies.data(), indicies.size());
+        this->IBO->GetBufferData(indicies.data(), indicies.size(), this->indexOffset);
+        // returned indicies address vertecies returned by GetVerteciesFromGPU()
+        for (auto& index : indicies)
+            index -= (uint32_t)this->vertexOffset;
         return indicies;
     }
 
+    void MeshData::ComputeBoundingGeometry(const VertexData& vertecies, AABB& boundingBox, BoundingSphere& boundingSphere)
+    {
+        boundingBox = { MakeVector3(0.0f), MakeVector3(0.0f) };
+        if (vertecies.size() > 0)
+        {
+            boundingBox = { vertecies[0].Position, vertecies[0].Position };
+            for (const auto& vertex : vertecies)
+            {
+                boundingBox.Min = VectorMin(boundingBox.Min, vertex.Position);
+                boundingBox.Max = VectorMax(boundingBox.Max, vertex.Position);
+            }
+        }
+
+        auto center = boundingBox.GetCenter();
+        float maxRadius = 0.0f;
+        for (const auto& vertex : vertecies)
+        {
+            auto distance = vertex.Position - center;
+            maxRadius = Max(maxRadius, Length2(distance));
+        }
+        boundingSphere = BoundingSphere(center, std::sqrt(maxRadius));
+    }
+
     void MeshData::RegenerateNormals(VertexData& vertecies, const IndexData& indicies)
     {
         // first set all normal-space vectors to 0
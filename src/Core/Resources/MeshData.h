@@ -63,10 +63,12 @@ namespace MxEngine
         void BufferVertecies(const VertexData& vertecies);
         void BufferIndicies(const IndexData& indicies);
         void UpdateBoundingGeometry(const VertexData& vertecies);
+        void SetBoundingGeometry(const AABB& boundingBox, const BoundingSphere& boundingSphere);
 
         VertexData GetVerteciesFromGPU() const;
         IndexData GetIndiciesFromGPU() const;
 
+        static void ComputeBoundingGeometry(const VertexData& vertecies, AABB& boundingBox, BoundingSphere& boundingSphere);
         static void RegenerateNormals(VertexData& vertecies, const IndexData& indicies);
         static void RegenerateTangentSpace(VertexData& vertecies, const IndexData& indicies);
     };
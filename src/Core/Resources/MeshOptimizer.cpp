@@ -0,0 +1,368 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "MeshOptimizer.h"
+#include "Utilities/Profiler/Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace MxEngine
+{
+    constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+    constexpr size_t ForsythCacheSize = 32;
+
+    float ComputeForsythVertexScore(int cachePosition, uint32_t remainingTriangles)
+    {
+        // vertex with no triangles left is never needed again
+        if (remainingTriangles == 0) return -1.0f;
+
+        float score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            // vertecies of last emitted triangle get fixed score, so next triangle does not reuse all of them in a strip-like order
+            if (cachePosition < 3)
+                score = 0.75f;
+            else
+                score = std::pow(1.0f - float(cachePosition - 3) / float(ForsythCacheSize - 3), 1.5f);
+        }
+        // boost vertecies with few triangles left, so they are finished and leave cache early
+        score += 2.0f / std::sqrt(float(remainingTriangles));
+        return score;
+    }
+
+    // FIFO cache emulation: vertex is in cache if it was shaded less than cacheSize misses ago
+    size_t UpdateVertexCache(const uint32_t* triangle, size_t cacheSize, MxVector<size_t>& timestamps, size_t& timestamp)
+    {
+        size_t misses = 0;
+        for (size_t i = 0; i < 3; i++)
+        {
+            uint32_t vertex = triangle[i];
+            if (timestamp - timestamps[vertex] > cacheSize)
+            {
+                timestamps[vertex] = timestamp++;
+                misses++;
+            }
+        }
+        return misses;
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(MeshData::IndexData& indicies, size_t vertexCount)
+    {
+        MAKE_SCOPE_PROFILER("MeshOptimizer::OptimizeVertexCache()");
+
+        size_t triangleCount = indicies.size() / 3;
+        if (triangleCount == 0) return;
+
+        // build vertex -> triangles adjacency as one array with per-vertex ranges
+        MxVector<uint32_t> triangleOffsets(vertexCount + 1, 0);
+        MxVector<uint32_t> remainingTriangles(vertexCount, 0);
+        for (size_t i = 0; i < triangleCount * 3; i++)
+        {
+            MX_ASSERT(indicies[i] < vertexCount);
+            remainingTriangles[indicies[i]]++;
+        }
+        for (size_t i = 0; i < vertexCount; i++)
+            triangleOffsets[i + 1] = triangleOffsets[i] + remainingTriangles[i];
+
+        MxVector<uint32_t> adjacency(triangleCount * 3);
+        MxVector<uint32_t> adjacencyCursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; i++)
+            adjacency[adjacencyCursor[indicies[i]]++] = uint32_t(i / 3);
+
+        MxVector<float> vertexScores(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++)
+            vertexScores[i] = ComputeForsythVertexScore(-1, remainingTriangles[i]);
+
+        MxVector<float> triangleScores(triangleCount);
+        MxVector<uint8_t> isEmitted(triangleCount, 0);
+        for (size_t i = 0; i < triangleCount; i++)
+        {
+            triangleScores[i] = vertexScores[indicies[3 * i + 0]] + vertexScores[indicies[3 * i + 1]] + vertexScores[indicies[3 * i + 2]];
+        }
+
+        std::array<uint32_t, ForsythCacheSize + 3> cache;
+        std::array<uint32_t, ForsythCacheSize + 3> newCache;
+        size_t cacheCount = 0;
+
+        MeshData::IndexData result;
+        result.reserve(triangleCount * 3);
+
+        size_t nextUnemitted = 0;
+        uint32_t bestTriangle = uint32_t(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+        while (bestTriangle != InvalidIndex)
+        {
+            isEmitted[bestTriangle] = 1;
+
+            // emitted triangle goes to the front of LRU cache, other entries are shifted back
+            size_t newCacheCount = 0;
+            for (size_t i = 0; i < 3; i++)
+            {
+                uint32_t vertex = indicies[3 * bestTriangle + i];
+                result.push_back(vertex);
+
+                auto begin = adjacency.begin() + triangleOffsets[vertex];
+                auto end = begin + remainingTriangles[vertex];
+                auto it = std::find(begin, end, bestTriangle);
+                MX_ASSERT(it != end);
+                std::swap(*it, *(end - 1));
+                remainingTriangles[vertex]--;
+
+                if (std::find(newCache.begin(), newCache.begin() + newCacheCount, vertex) == newCache.begin() + newCacheCount)
+                    newCache[newCacheCount++] = vertex;
+            }
+            size_t emittedCount = newCacheCount;
+            for (size_t i = 0; i < cacheCount; i++)
+            {
+                uint32_t vertex = cache[i];
+                if (std::find(newCache.begin(), newCache.begin() + emittedCount, vertex) == newCache.begin() + emittedCount)
+                    newCache[newCacheCount++] = vertex;
+            }
+
+            // vertecies pushed out of cache lose their cache score
+            for (size_t i = ForsythCacheSize; i < newCacheCount; i++)
+            {
+                uint32_t vertex = newCache[i];
+                float score = ComputeForsythVertexScore(-1, remainingTriangles[vertex]);
+                float delta = score - vertexScores[vertex];
+                vertexScores[vertex] = score;
+                for (uint32_t j = 0; j < remainingTriangles[vertex]; j++)
+                    triangleScores[adjacency[triangleOffsets[vertex] + j]] += delta;
+            }
+            cacheCount = Min(newCacheCount, ForsythCacheSize);
+            std::copy(newCache.begin(), newCache.begin() + cacheCount, cache.begin());
+
+            // only triangles of cached vertecies changed score, so next triangle is searched among them
+            for (size_t i = 0; i < cacheCount; i++)
+            {
+                uint32_t vertex = cache[i];
+                float score = ComputeForsythVertexScore(int(i), remainingTriangles[vertex]);
+                float delta = score - vertexScores[vertex];
+                vertexScores[vertex] = score;
+                for (uint32_t j = 0; j < remainingTriangles[vertex]; j++)
+                    triangleScores[adjacency[triangleOffsets[vertex] + j]] += delta;
+            }
+
+            bestTriangle = InvalidIndex;
+            float bestScore = -std::numeric_limits<float>::max();
+            for (size_t i = 0; i < cacheCount; i++)
+            {
+                uint32_t vertex = cache[i];
+                for (uint32_t j = 0; j < remainingTriangles[vertex]; j++)
+                {
+                    uint32_t triangle = adjacency[triangleOffsets[vertex] + j];
+                    if (triangleScores[triangle] > bestScore)
+                    {
+                        bestScore = triangleScores[triangle];
+                        bestTriangle = triangle;
+                    }
+                }
+            }
+
+            // cache has no connected triangles left, continue with next disconnected part of mesh
+            if (bestTriangle == InvalidIndex)
+            {
+                while (nextUnemitted < triangleCount && isEmitted[nextUnemitted]) nextUnemitted++;
+                if (nextUnemitted < triangleCount) bestTriangle = uint32_t(nextUnemitted);
+            }
+        }
+
+        // index count may be not divisible by three, keep tail as is
+        result.insert(result.end(), indicies.begin() + triangleCount * 3, indicies.end());
+        indicies = std::move(result);
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(MeshData::IndexData& indicies, const MeshData::VertexData& vertecies, float threshold)
+    {
+        MAKE_SCOPE_PROFILER("MeshOptimizer::OptimizeOverdraw()");
+
+        size_t triangleCount = indicies.size() / 3;
+        if (triangleCount == 0) return;
+
+        MxVector<size_t> timestamps(vertecies.size(), 0);
+        size_t timestamp = CacheSize + 1;
+        auto FlushCache = [&timestamp]() { timestamp += CacheSize + 1; };
+
+        // triangle which misses all three vertecies usually starts new patch of mesh. Such patches can be reordered freely
+        MxVector<size_t> hardBoundaries;
+        for (size_t i = 0; i < triangleCount; i++)
+        {
+            size_t misses = UpdateVertexCache(indicies.data() + 3 * i, CacheSize, timestamps, timestamp);
+            if (i == 0 || misses == 3) hardBoundaries.push_back(i);
+        }
+        hardBoundaries.push_back(triangleCount);
+
+        // patches are split further while ACMR of each part stays within threshold of the whole patch ACMR
+        MxVector<size_t> clusters;
+        for (size_t c = 0; c + 1 < hardBoundaries.size(); c++)
+        {
+            size_t begin = hardBoundaries[c];
+            size_t end = hardBoundaries[c + 1];
+
+            FlushCache();
+            size_t clusterMisses = 0;
+            for (size_t i = begin; i < end; i++)
+                clusterMisses += UpdateVertexCache(indicies.data() + 3 * i, CacheSize, timestamps, timestamp);
+            float clusterThreshold = threshold * float(clusterMisses) / float(end - begin);
+
+            clusters.push_back(begin);
+            FlushCache();
+            size_t runningMisses = 0;
+            size_t runningTriangles = 0;
+            for (size_t i = begin; i < end; i++)
+            {
+                runningMisses += UpdateVertexCache(indicies.data() + 3 * i, CacheSize, timestamps, timestamp);
+                runningTriangles++;
+
+                if (float(runningMisses) / float(runningTriangles) <= clusterThreshold && i + 1 < end)
+                {
+                    clusters.push_back(i + 1);
+                    FlushCache();
+                    runningMisses = 0;
+                    runningTriangles = 0;
+                }
+            }
+        }
+        clusters.push_back(triangleCount);
+
+        // clusters facing away from mesh center are likely to occlude others, so they are drawn first
+        size_t clusterCount = clusters.size() - 1;
+        MxVector<Vector3> clusterCentroids(clusterCount, MakeVector3(0.0f));
+        MxVector<Vector3> clusterNormals(clusterCount, MakeVector3(0.0f));
+        Vector3 meshCentroid = MakeVector3(0.0f);
+        float meshArea = 0.0f;
+        for (size_t c = 0; c < clusterCount; c++)
+        {
+            float clusterArea = 0.0f;
+            for (size_t i = clusters[c]; i < clusters[c + 1]; i++)
+            {
+                const auto& p0 = vertecies[indicies[3 * i + 0]].Position;
+                const auto& p1 = vertecies[indicies[3 * i + 1]].Position;
+                const auto& p2 = vertecies[indicies[3 * i + 2]].Position;
+
+                Vector3 normal = Cross(p1 - p0, p2 - p0); // length is doubled area of triangle
+                float area = Length(normal);
+                Vector3 centroid = (p0 + p1 + p2) / 3.0f;
+
+                clusterCentroids[c] += centroid * area;
+                clusterNormals[c] += normal;
+                clusterArea += area;
+            }
+            meshCentroid += clusterCentroids[c];
+            meshArea += clusterArea;
+
+            if (clusterArea > 0.0f) clusterCentroids[c] /= clusterArea;
+        }
+        if (meshArea > 0.0f) meshCentroid /= meshArea;
+
+        MxVector<float> sortKeys(clusterCount);
+        for (size_t c = 0; c < clusterCount; c++)
+        {
+            float normalLength = Length(clusterNormals[c]);
+            Vector3 normal = normalLength > 0.0f ? clusterNormals[c] / normalLength : MakeVector3(0.0f);
+            sortKeys[c] = Dot(clusterCentroids[c] - meshCentroid, normal);
+        }
+
+        MxVector<uint32_t> order(clusterCount);
+        for (size_t c = 0; c < clusterCount; c++) order[c] = uint32_t(c);
+        std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t c1, uint32_t c2) { return sortKeys[c1] > sortKeys[c2]; });
+
+        MeshData::IndexData result;
+        result.reserve(indicies.size());
+        for (uint32_t c : order)
+        {
+            result.insert(result.end(), indicies.begin() + 3 * clusters[c], indicies.begin() + 3 * clusters[c + 1]);
+        }
+        result.insert(result.end(), indicies.begin() + triangleCount * 3, indicies.end());
+        indicies = std::move(result);
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(MeshData::VertexData& vertecies, MeshData::IndexData& indicies)
+    {
+        MAKE_SCOPE_PROFILER("MeshOptimizer::OptimizeVertexFetch()");
+
+        MxVector<uint32_t> remap(vertecies.size(), InvalidIndex);
+        MeshData::VertexData result;
+        result.reserve(vertecies.size());
+
+        for (auto& index : indicies)
+        {
+            MX_ASSERT(index < vertecies.size());
+            if (remap[index] == InvalidIndex)
+            {
+                remap[index] = uint32_t(result.size());
+                result.push_back(vertecies[index]);
+            }
+            index = remap[index];
+        }
+        vertecies = std::move(result);
+    }
+
+    VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const MeshData::IndexData& indicies, size_t vertexCount, size_t cacheSize)
+    {
+        VertexCacheStatistics statistics;
+        size_t triangleCount = indicies.size() / 3;
+        if (triangleCount == 0) return statistics;
+
+        MxVector<size_t> timestamps(vertexCount, 0);
+        size_t timestamp = cacheSize + 1;
+        for (size_t i = 0; i < triangleCount; i++)
+        {
+            statistics.VertexShaded += UpdateVertexCache(indicies.data() + 3 * i, cacheSize, timestamps, timestamp);
+        }
+
+        size_t referencedCount = 0;
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            if (timestamps[i] != 0) referencedCount++;
+        }
+
+        statistics.ACMR = float(statistics.VertexShaded) / float(triangleCount);
+        statistics.ATVR = float(statistics.VertexShaded) / float(referencedCount);
+        return statistics;
+    }
+
+    void MeshOptimizer::Optimize(MeshData::VertexData& vertecies, MeshData::IndexData& indicies, VertexCacheStatistics& before, VertexCacheStatistics& after)
+    {
+        MAKE_SCOPE_PROFILER("MeshOptimizer::Optimize()");
+
+        before = MeshOptimizer::AnalyzeVertexCache(indicies, vertecies.size());
+        MeshOptimizer::OptimizeVertexCache(indicies, vertecies.size());
+        MeshOptimizer::OptimizeOverdraw(indicies, vertecies);
+        MeshOptimizer::OptimizeVertexFetch(vertecies, indicies);
+        after = MeshOptimizer::AnalyzeVertexCache(indicies, vertecies.size());
+    }
+
+    void MeshOptimizer::Optimize(MeshData::VertexData& vertecies, MeshData::IndexData& indicies)
+    {
+        VertexCacheStatistics before, after;
+        MeshOptimizer::Optimize(vertecies, indicies, before, after);
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/Resources/MeshData.h"
+
+namespace MxEngine
+{
+    /*!
+    statistics of post-transform vertex cache simulated for index buffer
+    */
+    struct VertexCacheStatistics
+    {
+        /*!
+        number of vertex shader invocations (cache misses)
+        */
+        size_t VertexShaded = 0;
+        /*!
+        average cache miss ratio: shaded vertecies per triangle. Lies in [0.5; 3.0], lower is better
+        */
+        float ACMR = 0.0f;
+        /*!
+        average transform to vertex ratio: shaded vertecies per referenced vertex. Equals 1.0 for perfect cache usage
+        */
+        float ATVR = 0.0f;
+    };
+
+    /*!
+    mesh optimizer reorders index and vertex buffers so GPU does less work to draw the same geometry:
+    triangles are sorted to reuse post-transform vertex cache (Forsyth algorithm), then clusters of triangles are
+    sorted to draw outer geometry first and reduce overdraw, at last vertecies are placed in order of first use
+    */
+    class MeshOptimizer
+    {
+    public:
+        /*!
+        size of vertex cache used for simulation. Modern GPUs do not have strict FIFO cache, but 16 entries is close to what they reuse in practice
+        */
+        static constexpr size_t CacheSize = 16;
+        /*!
+        max ACMR increase which is allowed to trade for lower overdraw
+        */
+        static constexpr float DefaultOverdrawThreshold = 1.05f;
+
+        /*!
+        reorders triangles to minimize vertex cache misses
+        \param indicies triangle list to reorder
+        \param vertexCount number of vertecies referenced by indicies
+        */
+        static void OptimizeVertexCache(MeshData::IndexData& indicies, size_t vertexCount);
+        /*!
+        reorders clusters of triangles so front-facing outer triangles are drawn first. Must be called after OptimizeVertexCache()
+        \param indicies triangle list to reorder
+        \param vertecies vertecies referenced by indicies
+        \param threshold max allowed ACMR increase relative to current index order
+        */
+        static void OptimizeOverdraw(MeshData::IndexData& indicies, const MeshData::VertexData& vertecies, float threshold = DefaultOverdrawThreshold);
+        /*!
+        reorders vertecies in order in which they are referenced by indicies. Unreferenced vertecies are removed
+        \param vertecies vertecies to reorder
+        \param indicies triangle list which is remapped to new vertex order
+        */
+        static void OptimizeVertexFetch(MeshData::VertexData& vertecies, MeshData::IndexData& indicies);
+        /*!
+        simulates FIFO vertex cache for triangle list
+        \param indicies triangle list to analyze
+        \param vertexCount number of vertecies referenced by indicies
+        \param cacheSize number of entries in simulated cache
+        \returns cache statistics of index buffer
+        */
+        static VertexCacheStatistics AnalyzeVertexCache(const MeshData::IndexData& indicies, size_t vertexCount, size_t cacheSize = CacheSize);
+        /*!
+        applies vertex cache, overdraw and vertex fetch optimizations to mesh
+        \param vertecies vertecies of mesh
+        \param indicies triangle list of mesh
+        \param before cache statistics of mesh before optimization
+        \param after cache statistics of mesh after optimization
+        */
+        static void Optimize(MeshData::VertexData& vertecies, MeshData::IndexData& indicies, VertexCacheStatistics& before, VertexCacheStatistics& after);
+        /*!
+        applies vertex cache, overdraw and vertex fetch optimizations to mesh
+        \param vertecies vertecies of mesh
+        \param indicies triangle list of mesh
+        */
+        static void Optimize(MeshData::VertexData& vertecies, MeshData::IndexData& indicies);
+    };
+}
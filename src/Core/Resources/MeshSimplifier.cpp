@@ -0,0 +1,470 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "MeshSimplifier.h"
+#include "Utilities/Profiler/Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace MxEngine
+{
+    constexpr uint32_t InvalidSimplifierIndex = std::numeric_limits<uint32_t>::max();
+    constexpr uint8_t SimplifierEdgeOpen = 1;
+    constexpr uint8_t SimplifierEdgeSeam = 2;
+    // border planes get higher weight than triangle planes, so border is not pulled inside mesh
+    constexpr float SimplifierBorderWeight = 10.0f;
+
+    enum class SimplifierVertexKind : uint8_t
+    {
+        MANIFOLD,
+        BORDER,
+        SEAM,
+        LOCKED,
+    };
+
+    struct SimplifierQuadric
+    {
+        float A00 = 0.0f, A11 = 0.0f, A22 = 0.0f;
+        float A01 = 0.0f, A02 = 0.0f, A12 = 0.0f;
+        float B0 = 0.0f, B1 = 0.0f, B2 = 0.0f;
+        float C = 0.0f;
+        float Weight = 0.0f;
+    };
+
+    struct SimplifierEdge
+    {
+        uint32_t TargetPosition;
+        uint32_t From;
+        uint32_t To;
+    };
+
+    struct SimplifierCollapse
+    {
+        uint32_t Source;
+        uint32_t Target;
+        float Cost;
+    };
+
+    SimplifierQuadric MakePlaneQuadric(const Vector3& normal, const Vector3& point, float weight)
+    {
+        float distance = -Dot(normal, point);
+        SimplifierQuadric quadric;
+        quadric.A00 = weight * normal.x * normal.x;
+        quadric.A11 = weight * normal.y * normal.y;
+        quadric.A22 = weight * normal.z * normal.z;
+        quadric.A01 = weight * normal.x * normal.y;
+        quadric.A02 = weight * normal.x * normal.z;
+        quadric.A12 = weight * normal.y * normal.z;
+        quadric.B0 = weight * normal.x * distance;
+        quadric.B1 = weight * normal.y * distance;
+        quadric.B2 = weight * normal.z * distance;
+        quadric.C = weight * distance * distance;
+        quadric.Weight = weight;
+        return quadric;
+    }
+
+    void AddQuadric(SimplifierQuadric& quadric, const SimplifierQuadric& other)
+    {
+        quadric.A00 += other.A00; quadric.A11 += other.A11; quadric.A22 += other.A22;
+        quadric.A01 += other.A01; quadric.A02 += other.A02; quadric.A12 += other.A12;
+        quadric.B0 += other.B0; quadric.B1 += other.B1; quadric.B2 += other.B2;
+        quadric.C += other.C;
+        quadric.Weight += other.Weight;
+    }
+
+    float EvaluateQuadric(const SimplifierQuadric& q, const Vector3& v)
+    {
+        // weighted sum of squared distances to planes, divided by total weight gives mean squared distance
+        float result =
+            q.A00 * v.x * v.x + q.A11 * v.y * v.y + q.A22 * v.z * v.z +
+            2.0f * (q.A01 * v.x * v.y + q.A02 * v.x * v.z + q.A12 * v.y * v.z) +
+            2.0f * (q.B0 * v.x + q.B1 * v.y + q.B2 * v.z) + q.C;
+        return q.Weight > 0.0f ? std::abs(result) / q.Weight : 0.0f;
+    }
+
+    size_t NextTriangleCorner(size_t index)
+    {
+        return index - index % 3 + (index % 3 + 1) % 3;
+    }
+
+    void BuildVertexTriangles(const MeshData::IndexData& indicies, size_t vertexCount, MxVector<uint32_t>& offsets, MxVector<uint32_t>& triangles)
+    {
+        offsets.assign(vertexCount + 1, 0);
+        for (uint32_t index : indicies)
+            offsets[index + 1]++;
+        for (size_t i = 0; i < vertexCount; i++)
+            offsets[i + 1] += offsets[i];
+
+        triangles.resize(indicies.size());
+        MxVector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indicies.size(); i++)
+            triangles[cursor[indicies[i]]++] = uint32_t(i / 3);
+    }
+
+    void BuildEdgeFlags(const MeshData::IndexData& indicies, const MxVector<uint32_t>& positionIds, MxVector<uint32_t>& offsets,
+        MxVector<SimplifierEdge>& edges, MxVector<uint8_t>& flags)
+    {
+        // directed edges are grouped by position of their start, so opposite edge is searched among few neighbours
+        size_t vertexCount = positionIds.size();
+        offsets.assign(vertexCount + 1, 0);
+        for (uint32_t index : indicies)
+            offsets[positionIds[index] + 1]++;
+        for (size_t i = 0; i < vertexCount; i++)
+            offsets[i + 1] += offsets[i];
+
+        edges.resize(indicies.size());
+        MxVector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indicies.size(); i++)
+        {
+            uint32_t from = indicies[i];
+            uint32_t to = indicies[NextTriangleCorner(i)];
+            edges[cursor[positionIds[from]]++] = SimplifierEdge{ positionIds[to], from, to };
+        }
+
+        // edge without opposite is open border. Edge which has opposite only between other vertecies at same positions is attribute seam
+        flags.assign(indicies.size(), 0);
+        for (size_t i = 0; i < indicies.size(); i++)
+        {
+            uint32_t from = indicies[i];
+            uint32_t to = indicies[NextTriangleCorner(i)];
+            uint32_t fromPosition = positionIds[from];
+            uint32_t toPosition = positionIds[to];
+
+            bool hasOpposite = false;
+            bool hasExactOpposite = false;
+            for (size_t e = offsets[toPosition]; e < offsets[toPosition + 1]; e++)
+            {
+                const auto& edge = edges[e];
+                if (edge.TargetPosition != fromPosition) continue;
+                hasOpposite = true;
+                hasExactOpposite |= edge.From == to && edge.To == from;
+            }
+
+            if (!hasOpposite)
+                flags[i] = SimplifierEdgeOpen;
+            else if (!hasExactOpposite)
+                flags[i] = SimplifierEdgeSeam;
+        }
+    }
+
+    float MeshSimplifier::Simplify(const MeshData::VertexData& vertecies, const MeshData::IndexData& indicies, MeshData::IndexData& result,
+        size_t targetIndexCount, float targetError, float attributeWeight)
+    {
+        MAKE_SCOPE_PROFILER("MeshSimplifier::Simplify()");
+
+        result.assign(indicies.begin(), indicies.begin() + indicies.size() / 3 * 3);
+        size_t vertexCount = vertecies.size();
+        size_t triangleCount = result.size() / 3;
+        size_t targetTriangleCount = targetIndexCount / 3;
+        if (triangleCount <= targetTriangleCount || vertexCount == 0) return 0.0f;
+
+        // positions are normalized, so error does not depend on mesh scale
+        AABB boundingBox;
+        BoundingSphere boundingSphere;
+        MeshData::ComputeBoundingGeometry(vertecies, boundingBox, boundingSphere);
+        float extent = ComponentMax(boundingBox.Length());
+        float scale = extent > 0.0f ? 1.0f / extent : 1.0f;
+
+        MxVector<Vector3> positions(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++)
+            positions[i] = (vertecies[i].Position - boundingBox.Min) * scale;
+
+        // vertecies with same position are wedges which differ only by attributes. Each position is identified by one of its vertecies
+        MxVector<uint32_t> sortedVertecies(vertexCount);
+        std::iota(sortedVertecies.begin(), sortedVertecies.end(), 0);
+        std::sort(sortedVertecies.begin(), sortedVertecies.end(), [&vertecies](uint32_t v1, uint32_t v2)
+        {
+            const auto& p1 = vertecies[v1].Position;
+            const auto& p2 = vertecies[v2].Position;
+            if (p1.x != p2.x) return p1.x < p2.x;
+            if (p1.y != p2.y) return p1.y < p2.y;
+            return p1.z < p2.z;
+        });
+
+        MxVector<uint32_t> positionIds(vertexCount);
+        MxVector<uint32_t> nextWedges(vertexCount);
+        for (size_t begin = 0, end = 0; begin < vertexCount; begin = end)
+        {
+            const auto& position = vertecies[sortedVertecies[begin]].Position;
+            while (end < vertexCount && vertecies[sortedVertecies[end]].Position == position) end++;
+
+            for (size_t i = begin; i < end; i++)
+            {
+                positionIds[sortedVertecies[i]] = sortedVertecies[begin];
+                nextWedges[sortedVertecies[i]] = sortedVertecies[i + 1 < end ? i + 1 : begin];
+            }
+        }
+
+        MxVector<uint32_t> triangleOffsets, vertexTriangles;
+        MxVector<uint32_t> edgeOffsets;
+        MxVector<SimplifierEdge> edges;
+        MxVector<uint8_t> edgeFlags;
+        BuildVertexTriangles(result, vertexCount, triangleOffsets, vertexTriangles);
+        BuildEdgeFlags(result, positionIds, edgeOffsets, edges, edgeFlags);
+
+        // classify positions by their topology. Kinds are computed once, so borders and seams stay in place as mesh becomes coarser
+        MxVector<SimplifierVertexKind> kinds(vertexCount, SimplifierVertexKind::MANIFOLD);
+        {
+            MxVector<uint32_t> openOut(vertexCount, 0), openIn(vertexCount, 0);
+            MxVector<uint32_t> seamOut(vertexCount, 0), seamIn(vertexCount, 0);
+            MxVector<uint32_t> wedgeCount(vertexCount, 0);
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                if (triangleOffsets[i + 1] > triangleOffsets[i]) wedgeCount[positionIds[i]]++;
+            }
+            for (size_t i = 0; i < result.size(); i++)
+            {
+                uint32_t from = positionIds[result[i]];
+                uint32_t to = positionIds[result[NextTriangleCorner(i)]];
+                if (edgeFlags[i] & SimplifierEdgeOpen) { openOut[from]++; openIn[to]++; }
+                if (edgeFlags[i] & SimplifierEdgeSeam) { seamOut[from]++; seamIn[to]++; }
+            }
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                if (positionIds[i] != i) continue;
+                if (openOut[i] > 0 || openIn[i] > 0)
+                {
+                    bool isSimpleBorder = wedgeCount[i] == 1 && openOut[i] == 1 && openIn[i] == 1;
+                    kinds[i] = isSimpleBorder ? SimplifierVertexKind::BORDER : SimplifierVertexKind::LOCKED;
+                }
+                else if (seamOut[i] > 0 || seamIn[i] > 0 || wedgeCount[i] > 1)
+                {
+                    bool isSimpleSeam = wedgeCount[i] == 2 && seamOut[i] == 2 && seamIn[i] == 2;
+                    kinds[i] = isSimpleSeam ? SimplifierVertexKind::SEAM : SimplifierVertexKind::LOCKED;
+                }
+            }
+        }
+
+        // each position accumulates planes of its triangles and planes perpendicular to its border edges
+        MxVector<SimplifierQuadric> quadrics(vertexCount);
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            const auto& p0 = positions[result[i + 0]];
+            const auto& p1 = positions[result[i + 1]];
+            const auto& p2 = positions[result[i + 2]];
+            Vector3 normal = Cross(p1 - p0, p2 - p0);
+            float length = Length(normal);
+            if (length == 0.0f) continue;
+            normal /= length;
+
+            auto quadric = MakePlaneQuadric(normal, p0, 0.5f * length);
+            for (size_t k = 0; k < 3; k++)
+                AddQuadric(quadrics[positionIds[result[i + k]]], quadric);
+
+            for (size_t k = 0; k < 3; k++)
+            {
+                if ((edgeFlags[i + k] & SimplifierEdgeOpen) == 0) continue;
+                uint32_t from = result[i + k];
+                uint32_t to = result[NextTriangleCorner(i + k)];
+                Vector3 edge = positions[to] - positions[from];
+                float edgeLength = Length(edge);
+                if (edgeLength == 0.0f) continue;
+
+                Vector3 borderNormal = Normalize(Cross(edge, normal));
+                auto borderQuadric = MakePlaneQuadric(borderNormal, positions[from], SimplifierBorderWeight * edgeLength * edgeLength);
+                AddQuadric(quadrics[positionIds[from]], borderQuadric);
+                AddQuadric(quadrics[positionIds[to]], borderQuadric);
+            }
+        }
+
+        // wedge of collapsed position moves to the wedge of target position which shares triangle with it
+        auto FindWedgeTarget = [&](uint32_t wedge, uint32_t targetPosition)
+        {
+            uint32_t found = InvalidSimplifierIndex;
+            for (uint32_t t = triangleOffsets[wedge]; t < triangleOffsets[wedge + 1]; t++)
+            {
+                uint32_t triangle = vertexTriangles[t];
+                for (size_t k = 0; k < 3; k++)
+                {
+                    uint32_t vertex = result[3 * triangle + k];
+                    if (positionIds[vertex] != targetPosition) continue;
+                    if (found != InvalidSimplifierIndex && found != vertex) return InvalidSimplifierIndex; // ambiguous, wedge touches both sides of seam
+                    found = vertex;
+                }
+            }
+            return found;
+        };
+
+        auto HasTriangles = [&](uint32_t vertex)
+        {
+            return triangleOffsets[vertex + 1] > triangleOffsets[vertex];
+        };
+
+        auto EvaluateCollapse = [&](uint32_t source, uint32_t target, uint8_t flags)
+        {
+            constexpr float InvalidCost = -1.0f;
+            auto sourceKind = kinds[source];
+            auto targetKind = kinds[target];
+            switch (sourceKind)
+            {
+            case SimplifierVertexKind::LOCKED:
+                return InvalidCost;
+            case SimplifierVertexKind::BORDER:
+                if ((flags & SimplifierEdgeOpen) == 0) return InvalidCost;
+                if (targetKind != SimplifierVertexKind::BORDER && targetKind != SimplifierVertexKind::LOCKED) return InvalidCost;
+                break;
+            case SimplifierVertexKind::SEAM:
+                if ((flags & SimplifierEdgeSeam) == 0) return InvalidCost;
+                if (targetKind != SimplifierVertexKind::SEAM && targetKind != SimplifierVertexKind::LOCKED) return InvalidCost;
+                break;
+            case SimplifierVertexKind::MANIFOLD:
+                if ((flags & SimplifierEdgeOpen) != 0) return InvalidCost;
+                break;
+            }
+
+            float attributeError = 0.0f;
+            uint32_t wedge = source;
+            do
+            {
+                if (HasTriangles(wedge))
+                {
+                    uint32_t wedgeTarget = FindWedgeTarget(wedge, target);
+                    if (wedgeTarget == InvalidSimplifierIndex) return InvalidCost;
+
+                    const auto& v0 = vertecies[wedge];
+                    const auto& v1 = vertecies[wedgeTarget];
+                    attributeError += Length2(v0.TexCoord - v1.TexCoord) + 0.25f * Length2(v0.Normal - v1.Normal);
+
+                    // triangles which stay after collapse must not flip or degenerate
+                    for (uint32_t t = triangleOffsets[wedge]; t < triangleOffsets[wedge + 1]; t++)
+                    {
+                        uint32_t triangle = vertexTriangles[t];
+                        std::array<Vector3, 3> corners;
+                        std::array<Vector3, 3> movedCorners;
+                        bool isCollapsed = false;
+                        for (size_t k = 0; k < 3; k++)
+                        {
+                            uint32_t position = positionIds[result[3 * triangle + k]];
+                            isCollapsed |= position == target;
+                            corners[k] = positions[position];
+                            movedCorners[k] = position == source ? positions[target] : corners[k];
+                        }
+                        if (isCollapsed) continue;
+
+                        Vector3 normal = Cross(corners[1] - corners[0], corners[2] - corners[0]);
+                        Vector3 movedNormal = Cross(movedCorners[1] - movedCorners[0], movedCorners[2] - movedCorners[0]);
+                        float length = Length(normal);
+                        if (length == 0.0f) continue;
+                        if (Dot(normal, movedNormal) <= 0.25f * length * Length(movedNormal)) return InvalidCost;
+                    }
+                }
+                wedge = nextWedges[wedge];
+            } while (wedge != source);
+
+            return EvaluateQuadric(quadrics[source], positions[target]) + attributeWeight * attributeError;
+        };
+
+        MxVector<SimplifierCollapse> collapses;
+        MxVector<uint32_t> collapseRemap(vertexCount);
+        MxVector<uint8_t> isLocked(vertexCount);
+        float errorLimit = targetError * targetError;
+        float maxError = 0.0f;
+
+        while (triangleCount > targetTriangleCount)
+        {
+            collapses.clear();
+            for (size_t i = 0; i < result.size(); i++)
+            {
+                uint32_t from = positionIds[result[i]];
+                uint32_t to = positionIds[result[NextTriangleCorner(i)]];
+                uint8_t flags = edgeFlags[i];
+                if (from == to) continue;
+                // interior edges and seams are listed by both adjacent triangles, open edges only by one
+                if ((flags & SimplifierEdgeOpen) == 0 && from > to) continue;
+
+                float cost = EvaluateCollapse(from, to, flags);
+                if (cost >= 0.0f) collapses.push_back(SimplifierCollapse{ from, to, cost });
+                cost = EvaluateCollapse(to, from, flags);
+                if (cost >= 0.0f) collapses.push_back(SimplifierCollapse{ to, from, cost });
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const SimplifierCollapse& c1, const SimplifierCollapse& c2) { return c1.Cost < c2.Cost; });
+
+            std::iota(collapseRemap.begin(), collapseRemap.end(), 0);
+            std::fill(isLocked.begin(), isLocked.end(), 0);
+
+            // cheapest collapses are applied first. Neighbourhood of each collapse is locked until next pass, so adjacency stays valid
+            size_t collapseCount = 0;
+            size_t remainingTriangles = triangleCount;
+            for (const auto& collapse : collapses)
+            {
+                if (collapse.Cost > errorLimit || remainingTriangles <= targetTriangleCount) break;
+                if (isLocked[collapse.Source] || isLocked[collapse.Target]) continue;
+
+                uint32_t wedge = collapse.Source;
+                do
+                {
+                    for (uint32_t t = triangleOffsets[wedge]; t < triangleOffsets[wedge + 1]; t++)
+                    {
+                        uint32_t triangle = vertexTriangles[t];
+                        bool isCollapsed = false;
+                        for (size_t k = 0; k < 3; k++)
+                        {
+                            uint32_t position = positionIds[result[3 * triangle + k]];
+                            isLocked[position] = 1;
+                            isCollapsed |= position == collapse.Target;
+                        }
+                        if (isCollapsed) remainingTriangles--;
+                    }
+                    if (HasTriangles(wedge)) collapseRemap[wedge] = FindWedgeTarget(wedge, collapse.Target);
+                    wedge = nextWedges[wedge];
+                } while (wedge != collapse.Source);
+
+                AddQuadric(quadrics[collapse.Target], quadrics[collapse.Source]);
+                maxError = Max(maxError, collapse.Cost);
+                collapseCount++;
+            }
+            if (collapseCount == 0) break;
+
+            // apply collapses and remove triangles which became degenerate
+            size_t writeIndex = 0;
+            for (size_t i = 0; i < result.size(); i += 3)
+            {
+                uint32_t v0 = collapseRemap[result[i + 0]];
+                uint32_t v1 = collapseRemap[result[i + 1]];
+                uint32_t v2 = collapseRemap[result[i + 2]];
+                uint32_t p0 = positionIds[v0], p1 = positionIds[v1], p2 = positionIds[v2];
+                if (p0 == p1 || p1 == p2 || p0 == p2) continue;
+
+                result[writeIndex++] = v0;
+                result[writeIndex++] = v1;
+                result[writeIndex++] = v2;
+            }
+            result.resize(writeIndex);
+            triangleCount = result.size() / 3;
+
+            BuildVertexTriangles(result, vertexCount, triangleOffsets, vertexTriangles);
+            BuildEdgeFlags(result, positionIds, edgeOffsets, edges, edgeFlags);
+        }
+
+        return std::sqrt(maxError);
+    }
+}
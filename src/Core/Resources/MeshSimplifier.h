@@ -0,0 +1,62 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/Resources/MeshData.h"
+
+namespace MxEngine
+{
+    /*!
+    mesh simplifier reduces triangle count of mesh by collapsing edges in order of quadric error (Garland-Heckbert).
+    Vertecies are only moved onto their neighbours, so all vertex attributes are preserved and resulting index buffer
+    references original vertex buffer. Open borders and attribute seams are collapsed only along themselves, and vertecies
+    where several borders or seams meet are never moved, so silhouette and texture layout of mesh are kept
+    */
+    class MeshSimplifier
+    {
+    public:
+        /*!
+        default weight of texture coordinate and normal difference relative to geometric error
+        */
+        static constexpr float DefaultAttributeWeight = 0.01f;
+
+        /*!
+        simplifies triangle list until target index count or target error is reached
+        \param vertecies vertecies of mesh
+        \param indicies triangle list of mesh
+        \param result simplified triangle list, which references the same vertecies. Unreferenced vertecies can be removed by MeshOptimizer::OptimizeVertexFetch()
+        \param targetIndexCount index count at which simplification stops
+        \param targetError max allowed error, measured relative to largest mesh extent (0.01 means one percent)
+        \param attributeWeight weight of attribute difference in collapse cost, zero to simplify by geometry only
+        \returns relative error of simplified mesh
+        */
+        static float Simplify(const MeshData::VertexData& vertecies, const MeshData::IndexData& indicies, MeshData::IndexData& result,
+            size_t targetIndexCount, float targetError, float attributeWeight = DefaultAttributeWeight);
+    };
+}
@@ -39,8 +39,10 @@
 
 #if defined MXENGINE_WINDOWS
     #define MXENGINE_RCCPP_STANDARD_COMPILER_OPTION "/std:c++17"
+    #define MXENGINE_RCCPP_DEFINE_OPTION(definition) " /D" definition
 #else
     #define MXENGINE_RCCPP_STANDARD_COMPILER_OPTION "-std=c++17"
+    #define MXENGINE_RCCPP_DEFINE_OPTION(definition) " -D" definition
 #endif
 
 // WinAPI
@@ -224,6 +226,15 @@ namespace MxEngine
     auto GetStandardCompilerOption()
     {
         MxString standard = MXENGINE_RCCPP_STANDARD_COMPILER_OPTION;
+        #if defined(MXENGINE_USE_SMALL_OBJECT_ALLOCATOR)
+        // scripts must use the same EASTL allocator implementation as engine, as containers are passed between them
+        standard += MXENGINE_RCCPP_DEFINE_OPTION("MXENGINE_USE_SMALL_OBJECT_ALLOCATOR");
+        standard += MXENGINE_RCCPP_DEFINE_OPTION("EASTL_USER_DEFINED_ALLOCATOR=1");
+        #endif
+        #if defined(MXENGINE_USE_CHUNKED_POOL)
+        // factory pools are accessed from script headers, so their layout must match engine one
+        standard += MXENGINE_RCCPP_DEFINE_OPTION("MXENGINE_USE_CHUNKED_POOL");
+        #endif
         return standard;
     }
 
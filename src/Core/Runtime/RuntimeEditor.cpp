@@ -33,6 +33,7 @@
 #include "Utilities/ImGui/ImGuiUtils.h"
 #include "Utilities/Format/Format.h"
 #include "Utilities/Logging/Logger.h"
+#include "Utilities/Memory/SmallObjectAllocator.h"
 #include "Utilities/FileSystem/FileManager.h"
 #include "Core/Events/WindowResizeEvent.h"
 #include "Core/Events/UpdateEvent.h"
@@ -115,6 +116,7 @@ namespace MxEngine
 		if (this->shouldRender)
 		{
 			MAKE_SCOPE_PROFILER("RuntimeEditor::OnUpdate()");
+			MemoryTagScope memoryTag(MemoryTag::EDITOR);
 			auto dockspaceID = ImGui::DockSpaceOverViewport();
 			InitDockspace(dockspaceID);
 
@@ -129,6 +129,9 @@ namespace MxEngine
 
         // remove attached viewport
         Rendering::SetViewport(CameraControllerHandle{ });
+
+        // drop cached render units and bounding volume hierarchy of destroyed objects
+        Rendering::GetController().GetRenderScene().Clear();
     }
 
     HandleMappings SceneSerializer::DeserializeResources(const JsonFile& json)
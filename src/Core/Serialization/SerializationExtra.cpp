@@ -104,6 +104,18 @@ namespace MxEngine
                 json.push_back(SceneSerializer::SerializeMxObject(*instance));
             }
         }
+
+        const auto& records = instanceFactory.GetRecords();
+        for (size_t i = 0; i < records.Positions.size(); i++)
+        {
+            JsonFile entry;
+            auto& record = entry["record"];
+            record["position"] = records.Positions[i];
+            record["rotation"] = records.Rotations[i];
+            record["scale"] = records.Scales[i];
+            record["color"] = records.Colors[i];
+            json.push_back(std::move(entry));
+        }
     }
 
     template<>
@@ -114,6 +126,18 @@ namespace MxEngine
 
         for (const auto& entry : json)
         {
+            if (entry.contains("record"))
+            {
+                const auto& record = entry["record"];
+                instanceFactory.AddInstance(
+                    record["position"].get<Vector3>(),
+                    record["rotation"].get<Quaternion>(),
+                    record["scale"].get<Vector3>(),
+                    record["color"].get<Vector3>()
+                );
+                continue;
+            }
+
             auto instance = instanceFactory.Instanciate();
             SceneSerializer::DeserializeMxObject(entry, instance, mappings);
             DeserializeComponent(entry["Instance"], instance->GetComponent<Instance>(), mappings);
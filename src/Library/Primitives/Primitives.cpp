@@ -31,6 +31,8 @@
 #include "Utilities/FileSystem/FileManager.h"
 #include "Utilities/ObjectLoading/ObjectSaver.h"
 #include "Core/Config/GlobalConfig.h"
+#include "Core/Resources/MeshOptimizer.h"
+#include "Utilities/Logging/Logger.h"
 
 namespace MxEngine
 {
@@ -71,6 +73,17 @@ namespace MxEngine
         return mesh;
     }
 
+    MeshHandle CreateOptimizedMesh(MeshData::VertexData& vertecies, MeshData::IndexData& indicies, const MxString& filename)
+    {
+        // generated meshes are emitted row by row, which wastes most of vertex cache. User meshes passed to
+        // Primitives::CreateMesh() are kept as is, as caller may rely on order of its vertecies
+        VertexCacheStatistics before, after;
+        MeshOptimizer::Optimize(vertecies, indicies, before, after);
+        MXLOG_DEBUG("MxEngine::Primitives", MxFormat("optimized mesh {0}: ACMR {1:.3f} -> {2:.3f}, ATVR {3:.3f} -> {4:.3f}",
+            filename, before.ACMR, after.ACMR, before.ATVR, after.ATVR));
+        return Primitives::CreateMesh(vertecies, indicies, filename);
+    }
+
     MeshHandle Primitives::CreateMesh(const MeshData::VertexData& vertecies, const MeshData::IndexData& indicies)
     {
         return Primitives::CreateMesh(vertecies, indicies, UUIDGenerator::Get());
@@ -148,7 +161,7 @@ namespace MxEngine
         }
 
         MeshData::RegenerateNormals(vertecies, indicies);
-        return Primitives::CreateMesh(vertecies, indicies, filename);
+        return CreateOptimizedMesh(vertecies, indicies, filename);
     }
 
     MeshHandle Primitives::CreateSurface2Side(const Array2D<float>& heights, const MxString& filename)
@@ -185,7 +198,7 @@ namespace MxEngine
         }
 
         MeshData::RegenerateNormals(vertecies, indicies);
-        return Primitives::CreateMesh(vertecies, indicies, filename);
+        return CreateOptimizedMesh(vertecies, indicies, filename);
     }
 
     MeshHandle Primitives::CreateCube(size_t polygons)
@@ -327,7 +340,7 @@ namespace MxEngine
         }
 
         MeshData::RegenerateTangentSpace(vertecies, indicies);
-        return Primitives::CreateMesh(vertecies, indicies, MxFormat("cube_{}", polygons));
+        return CreateOptimizedMesh(vertecies, indicies, MxFormat("cube_{}", polygons));
     }
 
     MeshHandle Primitives::CreatePlane(size_t polygons)
@@ -402,7 +415,7 @@ namespace MxEngine
                 }
             }
         }
-        return Primitives::CreateMesh(vertecies, indicies, MxFormat("sphere_{}", polygons));
+        return CreateOptimizedMesh(vertecies, indicies, MxFormat("sphere_{}", polygons));
     }
 
     MeshHandle Primitives::CreateCylinder(size_t polygons)
@@ -514,7 +527,7 @@ namespace MxEngine
         indicies.push_back(uint32_t(lowerR));
 
         MeshData::RegenerateNormals(vertecies, indicies);
-        return Primitives::CreateMesh(vertecies, indicies, MxFormat("cylinder_{}", polygons));
+        return CreateOptimizedMesh(vertecies, indicies, MxFormat("cylinder_{}", polygons));
     }
 
     MeshHandle Primitives::CreatePyramid(size_t)
@@ -544,7 +557,7 @@ namespace MxEngine
         };
 
         MeshData::RegenerateNormals(vertecies, indicies);
-        return Primitives::CreateMesh(vertecies, indicies, MxFormat("pyramid_1"));
+        return CreateOptimizedMesh(vertecies, indicies, MxFormat("pyramid_1"));
     }
 
     TextureHandle Primitives::CreateGridTexture(size_t textureSize, float borderScale)
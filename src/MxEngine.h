@@ -34,6 +34,8 @@
 #include "Core/Application/Runtime.h"
 #include "Core/Application/Physics.h"
 #include "Core/Application/Timer.h"
+#include "Core/Application/Jobs.h"
+#include "Core/Application/Hierarchy.h"
 #include "Core/Application/Scene.h"
 #include "Core/MxObject/MxObject.h"
 #include "Core/Config/GlobalConfig.h"
@@ -48,6 +50,8 @@
 #include "Core/BoundingObjects/Cone.h"
 #include "Core/BoundingObjects/Rectangle.h"
 #include "Core/BoundingObjects/Circle.h"
+#include "Core/Resources/MeshOptimizer.h"
+#include "Core/Resources/MeshSimplifier.h"
 #include "Platform/GraphicAPI.h"
 #include "Platform/Compute/Compute.h"
 #include "Platform/Window/Input.h"
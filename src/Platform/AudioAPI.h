@@ -37,6 +37,10 @@
 
 namespace MxEngine
 {
+    // audio sources are updated from worker threads, so handles to audio objects may be shared between them
+    MXENGINE_ATOMIC_RESOURCE_REFCOUNT(AudioPlayer);
+    MXENGINE_ATOMIC_RESOURCE_REFCOUNT(AudioBuffer);
+
     using AudioFactory = AbstractFactoryImpl<AudioPlayer, AudioBuffer>;
 
     template<typename T>
@@ -39,6 +39,7 @@
 #include "Platform/OpenGL/VertexArray.h"
 #include "Platform/OpenGL/VertexBuffer.h"
 #include "Platform/OpenGL/ShaderStorageBuffer.h"
+#include "Platform/OpenGL/UniformBuffer.h"
 #include "Platform/OpenGL/ComputeShader.h"
 #include "Platform/OpenGL/VertexLayout.h"
 
@@ -56,6 +57,7 @@ namespace MxEngine
         VertexArray,
         VertexBuffer,
         ShaderStorageBuffer,
+        UniformBuffer,
         ComputeShader
     >;
 
@@ -73,6 +75,7 @@ namespace MxEngine
     CREATE_HANDLE(VertexArray)
     CREATE_HANDLE(VertexBuffer)
     CREATE_HANDLE(ShaderStorageBuffer)
+    CREATE_HANDLE(UniformBuffer)
     CREATE_HANDLE(ComputeShader)
     #undef CREATE_HANDLE
 
@@ -98,18 +98,7 @@ namespace MxEngine
                 audio = AudioLoader::ConvertToMono(audio);
                 AudioLoader::Free(copy);
             }
-
-            this->filepath = ToMxString(std::filesystem::proximate(path));
-            std::replace(this->filepath.begin(), this->filepath.end(), '\\', '/');
-
-            this->nativeFormat = AL_FORMAT_MONO16;
-            this->channels = (uint8_t)audio.channels;
-            this->frequency = audio.frequency;
-            this->type = audio.type;
-            this->sampleCount = audio.sampleCount;
-
-            ALCALL(alBufferData(id, (ALenum) this->nativeFormat, audio.data, ALsizei(audio.sampleCount * sizeof(int16_t)), (ALsizei) audio.frequency));
-
+            this->Load(audio, path);
             AudioLoader::Free(audio);
         }
         else
@@ -118,6 +107,20 @@ namespace MxEngine
         }
     }
 
+    void AudioBuffer::Load(const AudioData& monoAudio, const std::filesystem::path& path)
+    {
+        this->filepath = ToMxString(std::filesystem::proximate(path));
+        std::replace(this->filepath.begin(), this->filepath.end(), '\\', '/');
+
+        this->nativeFormat = AL_FORMAT_MONO16;
+        this->channels = (uint8_t)monoAudio.channels;
+        this->frequency = monoAudio.frequency;
+        this->type = monoAudio.type;
+        this->sampleCount = monoAudio.sampleCount;
+
+        ALCALL(alBufferData(id, (ALenum) this->nativeFormat, monoAudio.data, ALsizei(monoAudio.sampleCount * sizeof(int16_t)), (ALsizei) monoAudio.frequency));
+    }
+
     void AudioBuffer::Load(const MxString& path)
     {
         this->Load(ToFilePath(path));
@@ -28,11 +28,15 @@
 
 #pragma once
 
+#include <filesystem>
+
 #include "Utilities/Audio/SupportedAudioTypes.h"
 #include "Utilities/STL/MxString.h"
 
 namespace MxEngine
 {
+    struct AudioData;
+
     class AudioBuffer
     {
         using BindableId = unsigned int;
@@ -56,6 +60,7 @@ namespace MxEngine
 
         void Load(const MxString& path);
         template<typename FilePath> void Load(const FilePath& path);
+        void Load(const AudioData& monoAudio, const std::filesystem::path& path);
 
         BindableId GetNativeHandle() const;
         size_t GetChannelCount() const;
@@ -37,6 +37,7 @@ namespace MxEngine
         GL_ARRAY_BUFFER,
         GL_ELEMENT_ARRAY_BUFFER,
         GL_SHADER_STORAGE_BUFFER,
+        GL_UNIFORM_BUFFER,
     };
 
     GLenum UsageTypeToEnum[] = {
@@ -117,6 +118,27 @@ namespace MxEngine
         GLCALL(glBindBufferBase(BufferTypeToEnum[(size_t)this->type], index, this->id));
     }
 
+    void BufferBase::BindBaseRange(size_t index, size_t offset, size_t byteSize) const
+    {
+        MX_ASSERT(byteSize + offset <= this->byteSize);
+        GLCALL(glBindBufferRange(BufferTypeToEnum[(size_t)this->type], index, this->id, offset, byteSize));
+    }
+
+    size_t BufferBase::GetBindRangeAlignment() const
+    {
+        // offsets passed to BindBaseRange() must be multiple of implementation-defined value
+        GLint alignment = 1;
+        if (this->type == BufferType::UNIFORM)
+        {
+            GLCALL(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment));
+        }
+        else if (this->type == BufferType::SHADER_STORAGE)
+        {
+            GLCALL(glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment));
+        }
+        return (size_t)alignment;
+    }
+
     BufferBase::BindableId BufferBase::GetNativeHandle() const
     {
         return this->id;
@@ -52,6 +52,7 @@ namespace MxEngine
 		ARRAY,
 		ELEMENT_ARRAY,
 		SHADER_STORAGE,
+		UNIFORM,
 	};
 
 	class BufferBase
@@ -75,6 +76,8 @@ namespace MxEngine
 		void Bind() const;
 		void Unbind() const;
 		void BindBase(size_t index) const;
+		void BindBaseRange(size_t index, size_t offset, size_t byteSize) const;
+		size_t GetBindRangeAlignment() const;
 		BindableId GetNativeHandle() const;
 		BufferType GetBufferType() const;
 		UsageType GetUsageType() const;
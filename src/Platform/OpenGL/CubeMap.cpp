@@ -58,6 +58,11 @@ namespace MxEngine
 		// TODO: support floating point textures
 		bool flipImage = false;
 		Image img = ImageLoader::LoadImage(filepath, flipImage);
+		this->Load(img, filepath);
+	}
+
+	void CubeMap::Load(const Image& img, const std::filesystem::path& filepath)
+	{
 		if (img.GetRawData() == nullptr)
 		{
 			MXLOG_WARNING("OpenGL::CubeMap", "file with name '" + ToMxString(filepath) + "' was not found");
@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <filesystem>
+
 #include "Utilities/STL/MxString.h"
 #include "Utilities/Image/Image.h"
 
@@ -70,6 +72,7 @@ namespace MxEngine
             const FilePath& bottom, const FilePath& front, const FilePath& back
         );
 
+        void Load(const Image& scan, const std::filesystem::path& filepath);
         void Load(const std::array<Image, 6>& images, bool genMipmaps = true);
         void Load(const std::array<uint8_t*, 6>& RawDataRGB, size_t width, size_t height);
         void LoadDepth(int width, int height);
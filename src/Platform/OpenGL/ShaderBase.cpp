@@ -32,6 +32,8 @@
 #include "Core/Config/GlobalConfig.h"
 #include "Utilities/Parsing/ShaderPreprocessor.h"
 
+#include <cstring>
+
 namespace MxEngine
 {
     ShaderBase::BindableId ShaderBase::CurrentlyAttachedShader = 0;
@@ -39,9 +41,9 @@ namespace MxEngine
     ShaderBase::UniformCache::UniformCache(BindableId shaderId)
         : shaderId(shaderId) { }
 
-    ShaderBase::UniformIdType ShaderBase::UniformCache::GetUniformLocation(const char* uniformName)
+    ShaderBase::UniformIdType ShaderBase::UniformCache::GetUniformLocation(StringId uniformId, const char* uniformName)
     {
-        auto it = cache.find_as(uniformName);
+        auto it = cache.find(uniformId);
         if (it != cache.end())
             return it->second;
 
@@ -52,18 +54,18 @@ namespace MxEngine
             MXLOG_WARNING("OpenGL::Shader", "uniform was not found: " + MxString(uniformName));
         }
 
-        cache[uniformName] = location;
+        cache[uniformId] = location;
         return location;
     }
 
-    ShaderBase::UniformIdType ShaderBase::UniformCache::GetUniformLocationSilent(const char* uniformName)
+    ShaderBase::UniformIdType ShaderBase::UniformCache::GetUniformLocationSilent(StringId uniformId, const char* uniformName)
     {
-        auto it = cache.find_as(uniformName);
+        auto it = cache.find(uniformId);
         if (it != cache.end())
             return it->second;
 
         GLCALL(ShaderBase::UniformIdType location = glGetUniformLocation(this->shaderId, uniformName));
-        cache[uniformName] = location;
+        cache[uniformId] = location;
         return location;
     }
 
@@ -242,115 +244,104 @@ namespace MxEngine
         return this->id;
     }
 
-    void ShaderBase::SetUniform(const MxString& name, int i) const
+    void ShaderBase::SetUniform(UniformIdType location, int i) const
     {
         MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
-        auto location = this->GetUniformLocation(name);
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
         GLCALL(glUniform1i(location, i));
     }
 
-    void ShaderBase::SetUniform(const MxString& name, bool b) const
+    void ShaderBase::SetUniform(UniformIdType location, bool b) const
     {
-        this->SetUniform(name, (int)b);
+        this->SetUniform(location, (int)b);
     }
 
-    void ShaderBase::SetUniform(const MxString& name, float f) const
+    void ShaderBase::SetUniform(UniformIdType location, float f) const
     {
         MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
-        auto location = this->GetUniformLocation(name);
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
         GLCALL(glUniform1f(location, f));
     }
 
-    void ShaderBase::SetUniform(const MxString& name, const Vector2& v) const
+    void ShaderBase::SetUniform(UniformIdType location, const Vector2& v) const
     {
         MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
-        auto location = this->GetUniformLocation(name);
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
         GLCALL(glUniform2f(location, v[0], v[1]));
     }
 
-    void ShaderBase::SetUniform(const MxString& name, const Vector3& v) const
+    void ShaderBase::SetUniform(UniformIdType location, const Vector3& v) const
     {
         MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
-        auto location = this->GetUniformLocation(name);
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
         GLCALL(glUniform3f(location, v[0], v[1], v[2]));
     }
 
-    void ShaderBase::SetUniform(const MxString& name, const Vector4& v) const
+    void ShaderBase::SetUniform(UniformIdType location, const Vector4& v) const
     {
         MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
-        auto location = this->GetUniformLocation(name);
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
         GLCALL(glUniform4f(location, v[0], v[1], v[2], v[3]));
     }
 
-    void ShaderBase::SetUniform(const MxString& name, const VectorInt2& v) const
+    void ShaderBase::SetUniform(UniformIdType location, const VectorInt2& v) const
     {
         MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
-        auto location = this->GetUniformLocation(name);
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
         GLCALL(glUniform2i(location, v[0], v[1]));
     }
 
-    void ShaderBase::SetUniform(const MxString& name, const VectorInt3& v) const
+    void ShaderBase::SetUniform(UniformIdType location, const VectorInt3& v) const
     {
         MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
-        auto location = this->GetUniformLocation(name);
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
         GLCALL(glUniform3i(location, v[0], v[1], v[2]));
     }
 
-    void ShaderBase::SetUniform(const MxString& name, const VectorInt4& v) const
+    void ShaderBase::SetUniform(UniformIdType location, const VectorInt4& v) const
     {
         MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
-        auto location = this->GetUniformLocation(name);
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
         GLCALL(glUniform4i(location, v[0], v[1], v[2], v[3]));
     }
 
-    void ShaderBase::SetUniform(const MxString& name, const Matrix2x2& m) const
+    void ShaderBase::SetUniform(UniformIdType location, const Matrix2x2& m) const
     {
         MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
-        auto location = this->GetUniformLocation(name);
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
         GLCALL(glUniformMatrix2fv(location, 1, false, &m[0][0]));
     }
 
-    void ShaderBase::SetUniform(const MxString& name, const Matrix3x3& m) const
+    void ShaderBase::SetUniform(UniformIdType location, const Matrix3x3& m) const
     {
         MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
-        auto location = this->GetUniformLocation(name);
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
         GLCALL(glUniformMatrix3fv(location, 1, false, &m[0][0]));
     }
 
-    void ShaderBase::SetUniform(const MxString& name, const Matrix4x4& m) const
+    void ShaderBase::SetUniform(UniformIdType location, const Matrix4x4& m) const
     {
         MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
-        auto location = this->GetUniformLocation(name);
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
@@ -359,22 +350,32 @@ namespace MxEngine
 
     void ShaderBase::IgnoreNonExistingUniform(const MxString& name) const
     {
-        this->GetUniformLocation(name.c_str());
+        this->IgnoreNonExistingUniform(name.c_str());
     }
 
     void ShaderBase::IgnoreNonExistingUniform(const char* name) const
     {
-        (void)this->uniformCache.GetUniformLocationSilent(name);
+        (void)this->uniformCache.GetUniformLocationSilent(crc32(name, std::strlen(name)), name);
+    }
+
+    void ShaderBase::IgnoreNonExistingUniform(const UniformHandle& uniform) const
+    {
+        (void)this->uniformCache.GetUniformLocationSilent(uniform.Id, uniform.Name);
     }
 
     ShaderBase::UniformIdType ShaderBase::GetUniformLocation(const MxString& name) const
     {
-        return this->GetUniformLocation(name.c_str());
+        return this->uniformCache.GetUniformLocation(MakeStringId(name), name.c_str());
     }
 
     ShaderBase::UniformIdType ShaderBase::GetUniformLocation(const char* name) const
     {
-        return this->uniformCache.GetUniformLocation(name);
+        return this->uniformCache.GetUniformLocation(crc32(name, std::strlen(name)), name);
+    }
+
+    ShaderBase::UniformIdType ShaderBase::GetUniformLocation(const UniformHandle& uniform) const
+    {
+        return this->uniformCache.GetUniformLocation(uniform.Id, uniform.Name);
     }
 
     void ShaderBase::InvalidateUniformCache()
@@ -33,6 +33,7 @@
 #include "Utilities/STL/MxString.h"
 #include "Utilities/STL/MxVector.h"
 #include "Utilities/STL/MxHashMap.h"
+#include "Utilities/String/String.h"
 
 namespace MxEngine
 {
@@ -44,9 +45,18 @@ namespace MxEngine
 		using BindableId = unsigned int;
 		using ShaderTypeEnum = int;
 
+		/*!
+		uniform name together with its hash, computed at compile time by MAKE_UNIFORM_HANDLE() macro
+		*/
+		struct UniformHandle
+		{
+			StringId Id;
+			const char* Name;
+		};
+
 		class UniformCache
 		{
-			MxHashMap<MxString, UniformIdType> cache;
+			MxHashMap<StringId, UniformIdType> cache;
 			BindableId shaderId;
 
 		public:
@@ -54,8 +64,8 @@ namespace MxEngine
 
 			UniformCache(BindableId shaderId);
 
-			UniformIdType GetUniformLocation(const char* uniformName);
-			UniformIdType GetUniformLocationSilent(const char* uniformName);
+			UniformIdType GetUniformLocation(StringId uniformId, const char* uniformName);
+			UniformIdType GetUniformLocationSilent(StringId uniformId, const char* uniformName);
 		};
 	private:
 		static BindableId CurrentlyAttachedShader;
@@ -88,20 +98,43 @@ namespace MxEngine
 		void InvalidateUniformCache();
 		void IgnoreNonExistingUniform(const MxString& name) const;
 		void IgnoreNonExistingUniform(const char* name) const;
+		void IgnoreNonExistingUniform(const UniformHandle& uniform) const;
 		UniformIdType GetUniformLocation(const MxString& name) const;
 		UniformIdType GetUniformLocation(const char* name) const;
+		UniformIdType GetUniformLocation(const UniformHandle& uniform) const;
+
+		template<typename T>
+		void SetUniform(const MxString& name, const T& value) const
+		{
+			this->SetUniform(this->GetUniformLocation(name.c_str()), value);
+		}
 
-		void SetUniform(const MxString& name, float             f) const;
-		void SetUniform(const MxString& name, const Vector2&    v) const;
-		void SetUniform(const MxString& name, const Vector3&    v) const;
-		void SetUniform(const MxString& name, const Vector4&    v) const;
-		void SetUniform(const MxString& name, const VectorInt2& v) const;
-		void SetUniform(const MxString& name, const VectorInt3& v) const;
-		void SetUniform(const MxString& name, const VectorInt4& v) const;
-		void SetUniform(const MxString& name, const Matrix2x2&  m) const;
-		void SetUniform(const MxString& name, const Matrix3x3&  m) const;
-		void SetUniform(const MxString& name, const Matrix4x4&  m) const;
-		void SetUniform(const MxString& name, int               i) const;
-		void SetUniform(const MxString& name, bool              b) const;
+		template<typename T>
+		void SetUniform(const char* name, const T& value) const
+		{
+			this->SetUniform(this->GetUniformLocation(name), value);
+		}
+
+		template<typename T>
+		void SetUniform(const UniformHandle& uniform, const T& value) const
+		{
+			this->SetUniform(this->GetUniformLocation(uniform), value);
+		}
+
+		void SetUniform(UniformIdType location, float             f) const;
+		void SetUniform(UniformIdType location, const Vector2&    v) const;
+		void SetUniform(UniformIdType location, const Vector3&    v) const;
+		void SetUniform(UniformIdType location, const Vector4&    v) const;
+		void SetUniform(UniformIdType location, const VectorInt2& v) const;
+		void SetUniform(UniformIdType location, const VectorInt3& v) const;
+		void SetUniform(UniformIdType location, const VectorInt4& v) const;
+		void SetUniform(UniformIdType location, const Matrix2x2&  m) const;
+		void SetUniform(UniformIdType location, const Matrix3x3&  m) const;
+		void SetUniform(UniformIdType location, const Matrix4x4&  m) const;
+		void SetUniform(UniformIdType location, int               i) const;
+		void SetUniform(UniformIdType location, bool              b) const;
 	};
+
+	// creates uniform handle from string literal, so uniform can be looked up in shader cache without hashing its name at runtime
+	#define MAKE_UNIFORM_HANDLE(name) ::MxEngine::ShaderBase::UniformHandle{ STRING_ID(name), name }
 }
@@ -0,0 +1,9 @@
+layout(std140, binding = 0) uniform CameraBuffer
+{
+	mat4 viewProjMatrix;
+	mat4 invViewProjMatrix;
+	vec3 position;
+	float fogDistance;
+	vec3 fogColor;
+	float fogDensity;
+} camera;
@@ -10,6 +10,12 @@ struct DirLight
 	vec3 direction;
 };
 
+layout(std140, binding = 2) uniform DirLightBuffer
+{
+	DirLight lights[MaxDirLightCount];
+	int lightCount;
+};
+
 float calcShadowFactorCascade(vec4 position, DirLight light, sampler2D shadowMap)
 {
 	vec3 projectedPositions[DirLightCascadeMapCount];
@@ -0,0 +1,9 @@
+layout(std140, binding = 1) uniform MaterialBuffer
+{
+	vec3 color;
+	float emmisive;
+	vec2 uvMultipliers;
+	float roughness;
+	float metallic;
+	float transparency;
+} material;
@@ -1,22 +1,14 @@
 #include "Library/shader_utils.glsl"
+#include "Library/camera.glsl"
 
 in vec2 TexCoord;
 out vec4 OutColor;
 
-struct Camera
-{
-    vec3 position;
-    mat4 viewProjMatrix;
-    mat4 invViewProjMatrix;
-};
-
 uniform sampler2D albedoTex;
 uniform sampler2D normalTex;
 uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 
-uniform Camera camera;
-
 uniform sampler2D SSRTex;
 uniform sampler2D HDRTex;
 
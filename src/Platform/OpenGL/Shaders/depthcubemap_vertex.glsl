@@ -1,4 +1,5 @@
 #include "Library/displacement.glsl"
+#include "Library/material.glsl"
 
 layout(location = 0)  in vec4 position;
 layout(location = 1)  in vec2 texCoord;
@@ -7,17 +8,16 @@ layout(location = 5)  in mat4 model;
 layout(location = 9)  in mat3 normalMatrix;
 
 uniform float displacement;
-uniform vec2 uvMultipliers;
 uniform sampler2D map_height;
 
 out vec2 VertexTexCoord;
 
 void main()
 {
-    VertexTexCoord = texCoord * uvMultipliers;
+    VertexTexCoord = texCoord * material.uvMultipliers;
 
     vec4 modelPos = model * position;
     vec3 normalObjectSpace = normalMatrix * normal;
-    modelPos.xyz += normalObjectSpace * getDisplacement(uvMultipliers * texCoord, uvMultipliers, map_height, displacement);
+    modelPos.xyz += normalObjectSpace * getDisplacement(material.uvMultipliers * texCoord, material.uvMultipliers, map_height, displacement);
     gl_Position = modelPos;
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Library/displacement.glsl"
+#include "Library/material.glsl"
 
 layout(location = 0)  in vec4 position;
 layout(location = 1)  in vec2 texCoord;
@@ -8,17 +9,16 @@ layout(location = 9)  in mat3 normalMatrix;
 
 uniform mat4 LightProjMatrix;
 uniform float displacement;
-uniform vec2 uvMultipliers;
 uniform sampler2D map_height;
 
 out vec2 TexCoord;
 
 void main()
 {
-    TexCoord = texCoord * uvMultipliers;
+    TexCoord = texCoord * material.uvMultipliers;
 
     vec4 modelPos = model * position;
     vec3 normalObjectSpace = normalMatrix * normal;
-    modelPos.xyz += normalObjectSpace * getDisplacement(TexCoord, uvMultipliers, map_height, displacement);
+    modelPos.xyz += normalObjectSpace * getDisplacement(TexCoord, material.uvMultipliers, map_height, displacement);
     gl_Position = LightProjMatrix * modelPos;
 }
\ No newline at end of file
@@ -1,24 +1,14 @@
 #include "Library/directional_light.glsl"
+#include "Library/camera.glsl"
 
 out vec4 OutColor;
 in vec2 TexCoord;
 
-struct Camera
-{
-	vec3 position;
-	mat4 invViewProjMatrix;
-	mat4 viewProjMatrix;
-};
-
 uniform sampler2D albedoTex;
 uniform sampler2D normalTex;
 uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 
-uniform int lightCount;
-uniform Camera camera;
-
-uniform DirLight lights[MaxDirLightCount];
 uniform sampler2D lightDepthMaps[MaxDirLightCount];
 
 void main()
@@ -1,5 +1,6 @@
 #include "Library/shader_utils.glsl"
 #include "Library/fog.glsl"
+#include "Library/camera.glsl"
 
 in vec2 TexCoord;
 out vec4 OutColor;
@@ -9,19 +10,11 @@ uniform sampler2D normalTex;
 uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 
-struct Camera
-{
-	vec3 position;
-	mat4 invViewProjMatrix;
-	mat4 viewProjMatrix;
-};
-
 uniform sampler2D cameraOutput;
-uniform Fog fog;
-uniform Camera camera;
 
 void main()
 {
+	Fog fog = Fog(camera.fogDistance, camera.fogDensity, camera.fogColor);
 	FragmentInfo fragment = getFragmentInfo(TexCoord, albedoTex, normalTex, materialTex, depthTex, camera.invViewProjMatrix);
 	float fragDistance = length(camera.position - fragment.position);
 
@@ -1,4 +1,6 @@
 #include "Library/displacement.glsl"
+#include "Library/camera.glsl"
+#include "Library/material.glsl"
 
 in VSout
 {
@@ -13,21 +15,6 @@ layout(location = 0) out vec4 OutAlbedo;
 layout(location = 1) out vec4 OutNormal;
 layout(location = 2) out vec4 OutMaterial;
 
-struct Material
-{
-	float emmisive;
-	float roughness;
-	float metallic;
-	float transparency;
-};
-
-struct Camera
-{
-	vec3 position;
-	mat4 viewProjMatrix;
-	mat4 invViewProjMatrix;
-};
-
 uniform sampler2D map_albedo;
 uniform sampler2D map_roughness;
 uniform sampler2D map_metallic;
@@ -35,11 +22,8 @@ uniform sampler2D map_emmisive;
 uniform sampler2D map_normal;
 uniform sampler2D map_occlusion;
 uniform sampler2D map_height;
-uniform Material material;
-uniform vec2 uvMultipliers;
 uniform float displacement;
 uniform float gamma;
-uniform Camera camera;
 
 vec3 calcNormal(vec2 texcoord, mat3 TBN, sampler2D normalMap)
 {
@@ -52,7 +36,7 @@ vec3 calcNormal(vec2 texcoord, mat3 TBN, sampler2D normalMap)
 
 void main()
 {
-	vec2 TexCoord = uvMultipliers * fsin.TexCoord;
+	vec2 TexCoord = material.uvMultipliers * fsin.TexCoord;
 	vec3 viewDirection = fsin.Position - camera.position;
 	float parallaxOcclusion = 1.0;
 	//TexCoord = applyParallaxMapping(TexCoord, fsin.TBN * viewDirection, map_height, displacement, parallaxOcclusion);
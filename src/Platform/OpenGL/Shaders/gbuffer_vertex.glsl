@@ -1,4 +1,6 @@
 #include "Library/displacement.glsl"
+#include "Library/camera.glsl"
+#include "Library/material.glsl"
 
 layout(location = 0)  in vec4 position;
 layout(location = 1)  in vec2 texCoord;
@@ -9,18 +11,8 @@ layout(location = 5)  in mat4 model;
 layout(location = 9)  in mat3 normalMatrix;
 layout(location = 12) in vec3 renderColor;
 
-struct Camera
-{
-	vec3 position;
-	mat4 viewProjMatrix;
-	mat4 invViewProjMatrix;
-};
-
-uniform Camera camera;
 uniform float displacement;
-uniform vec2 uvMultipliers;
 uniform sampler2D map_height;
-uniform vec3 color;
 
 out VSout
 {
@@ -40,9 +32,9 @@ void main()
 
 	vsout.TBN = mat3(T, B, N);
 	vsout.Normal = N;
-	vsout.RenderColor = color * renderColor;
+	vsout.RenderColor = material.color * renderColor;
 
-	float displacementFactor = getDisplacement(uvMultipliers * texCoord, uvMultipliers, map_height, displacement);
+	float displacementFactor = getDisplacement(material.uvMultipliers * texCoord, material.uvMultipliers, map_height, displacement);
 
 	modelPos.xyz += vsout.Normal * displacementFactor;
 	vsout.Position = modelPos.xyz;
@@ -1,4 +1,5 @@
 #include "Library/ibl_lighting.glsl"
+#include "Library/camera.glsl"
 
 in vec2 TexCoord;
 out vec4 OutColor;
@@ -9,14 +10,6 @@ uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 uniform float gamma;
 
-struct Camera
-{
-    vec3 position;
-    mat4 invViewProjMatrix;
-    mat4 viewProjMatrix;
-};
-
-uniform Camera camera;
 uniform EnvironmentInfo environment;
 
 void main()
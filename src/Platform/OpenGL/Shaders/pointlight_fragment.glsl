@@ -1,4 +1,5 @@
 #include "Library/lighting.glsl"
+#include "Library/camera.glsl"
 
 out vec4 OutColor;
 
@@ -21,16 +22,8 @@ struct PointLight
 	vec4 color;
 };
 
-struct Camera
-{
-	vec3 position;
-	mat4 invViewProjMatrix;
-	mat4 viewProjMatrix;
-};
-
 uniform samplerCube lightDepthMap;
 uniform bool castsShadows;
-uniform Camera camera;
 uniform int pcfDistance;
 uniform vec2 viewportSize;
 
@@ -1,3 +1,5 @@
+#include "Library/camera.glsl"
+
 layout(location = 0)  in vec4 position;
 layout(location = 5)  in mat4 transform;
 layout(location = 9)  in vec4 sphereParameters;
@@ -10,15 +12,6 @@ out PointLightInfo
 	vec4 color;
 } pointLight;
 
-struct Camera
-{
-	vec3 position;
-	mat4 invViewProjMatrix;
-	mat4 viewProjMatrix;
-};
-
-uniform Camera camera;
-
 void main()
 {
 	vec4 position = camera.viewProjMatrix * transform * position;
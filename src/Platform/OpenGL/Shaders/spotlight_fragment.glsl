@@ -1,4 +1,5 @@
 #include "Library/lighting.glsl"
+#include "Library/camera.glsl"
 
 out vec4 OutColor;
 
@@ -27,17 +28,9 @@ struct SpotLight
 	float maxDistance;
 };
 
-struct Camera
-{
-	vec3 position;
-	mat4 invViewProjMatrix;
-	mat4 viewProjMatrix;
-};
-
 uniform mat4 worldToLightTransform;
 uniform bool castsShadows;
 uniform sampler2D lightDepthMap;
-uniform Camera camera;
 uniform vec2 viewportSize;
 
 vec3 calcColorUnderSpotLight(FragmentInfo fragment, SpotLight light, vec3 viewDirection, vec3 fragLightSpace, sampler2D map_shadow, bool computeShadow)
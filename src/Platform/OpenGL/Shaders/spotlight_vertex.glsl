@@ -1,3 +1,5 @@
+#include "Library/camera.glsl"
+
 layout(location = 0)  in vec4 position;
 layout(location = 5)  in mat4 transform;
 layout(location = 9)  in vec4 lightPosition;
@@ -14,14 +16,6 @@ out SpotLightInfo
 	float maxDistance;
 } spotLight;
 
-struct Camera
-{
-	vec3 position;
-	mat4 invViewProjMatrix;
-	mat4 viewProjMatrix;
-};
-
-uniform Camera camera;
 uniform mat4 worldToLightTransform;
 
 void main()
@@ -1,4 +1,5 @@
 #include "Library/shader_utils.glsl"
+#include "Library/camera.glsl"
 
 in vec2 TexCoord;
 out vec4 OutColor;
@@ -8,14 +9,6 @@ uniform sampler2D normalTex;
 uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 
-struct Camera
-{
-    mat4 invViewProjMatrix;
-    mat4 viewProjMatrix;
-    vec3 position;
-};
-uniform Camera camera;
-
 uniform sampler2D noiseTex;
 uniform int sampleCount;
 uniform float radius;
@@ -1,4 +1,5 @@
 #include "Library/lighting.glsl"
+#include "Library/camera.glsl"
 
 in vec2 TexCoord;
 out vec4 OutColor;
@@ -8,14 +9,6 @@ uniform sampler2D normalTex;
 uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 
-struct Camera
-{
-    mat4 viewProjMatrix;
-    mat4 invViewProjMatrix;
-    vec3 position;
-};
-uniform Camera camera;
-
 uniform sampler2D inputTex;
 uniform int raySteps;
 uniform float intensity;
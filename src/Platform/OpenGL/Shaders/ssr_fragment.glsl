@@ -1,23 +1,15 @@
 #include "Library/shader_utils.glsl"
+#include "Library/camera.glsl"
 
 in vec2 TexCoord;
 out vec4 OutColor;
 
-struct Camera
-{
-    vec3 position;
-    mat4 viewProjMatrix;
-    mat4 invViewProjMatrix;
-};
-
-
 uniform sampler2D albedoTex;
 uniform sampler2D normalTex;
 uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 uniform sampler2D HDRTex;
 
-uniform Camera camera;
 uniform EnvironmentInfo environment;
 
 uniform int   steps;
@@ -1,4 +1,6 @@
 #include "Library/directional_light.glsl"
+#include "Library/camera.glsl"
+#include "Library/material.glsl"
 
 out vec4 OutColor;
 
@@ -11,14 +13,6 @@ in VSout
 	vec3 Position;
 } fsin;
 
-struct Material
-{
-	float emmisive;
-	float roughness;
-	float metallic;
-	float transparency;
-};
-
 uniform sampler2D map_albedo;
 uniform sampler2D map_metallic;
 uniform sampler2D map_roughness;
@@ -26,27 +20,13 @@ uniform sampler2D map_emmisive;
 uniform sampler2D map_normal;
 uniform sampler2D map_transparency;
 uniform sampler2D map_occlusion;
-uniform Material material;
-uniform vec2 uvMultipliers;
 uniform float gamma;
 
-struct Camera
-{
-	vec3 position;
-	mat4 invProjMatrix;
-	mat4 invViewMatrix;
-	mat4 viewProjMatrix;
-};
-
-uniform int lightCount;
-uniform vec3 viewportPosition;
 uniform sampler2D envBRDFLUT;
 
 uniform EnvironmentInfo environment;
 
-const int MaxLightCount = 4;
-uniform DirLight lights[MaxLightCount];
-uniform sampler2D lightDepthMaps[MaxLightCount];
+uniform sampler2D lightDepthMaps[MaxDirLightCount];
 
 vec3 calcNormal(vec2 texcoord, mat3 TBN, sampler2D normalMap)
 {
@@ -57,7 +37,7 @@ vec3 calcNormal(vec2 texcoord, mat3 TBN, sampler2D normalMap)
 
 void main()
 {
-	vec2 TexCoord = uvMultipliers * fsin.TexCoord;
+	vec2 TexCoord = material.uvMultipliers * fsin.TexCoord;
 	vec4 albedoAlphaTex = texture(map_albedo, TexCoord).rgba;
 
 	FragmentInfo fragment;
@@ -71,7 +51,7 @@ void main()
 	fragment.position = fsin.Position;
 	
 	float transparency = material.transparency * albedoAlphaTex.a;
-	vec3 viewDirection = normalize(viewportPosition - fragment.position);
+	vec3 viewDirection = normalize(camera.position - fragment.position);
 	
 	vec3 IBLColor = calculateIBL(fragment, viewDirection, environment, gamma);
 
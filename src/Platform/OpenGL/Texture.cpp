@@ -139,7 +139,11 @@ namespace MxEngine
 		{
 			MXLOG_ERROR("Texture", "file with name '" + ToMxString(filepath) + "' was not found or cannot be loaded");
 		}
+		this->Load(image, filepath, format);
+	}
 
+	void Texture::Load(const Image& image, const std::filesystem::path& filepath, TextureFormat format)
+	{
 		this->filepath = ToMxString(std::filesystem::proximate(filepath));
 		std::replace(this->filepath.begin(), this->filepath.end(), '\\', '/');
 
@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <filesystem>
+
 #include "Utilities/STL/MxString.h"
 #include "Utilities/STL/MxVector.h"
 #include "Utilities/Math/Math.h"
@@ -110,6 +112,7 @@ namespace MxEngine
 
 		void Load(RawDataPointer data, int width, int height, int channels, bool isFloating, TextureFormat format = TextureFormat::RGB);
 		void Load(const Image& image, TextureFormat format = TextureFormat::RGB);
+		void Load(const Image& image, const std::filesystem::path& filepath, TextureFormat format);
 		void LoadDepth(int width, int height, TextureFormat format = TextureFormat::DEPTH);
 		void SetMaxLOD(size_t lod);
 		void SetMinLOD(size_t lod);
@@ -166,35 +166,29 @@ namespace MxEngine
 			Vector2 prevSize(this->width, this->height);
 			if (currentSize != prevSize)
 			{
-				this->dispatcher->AddEvent(MakeUnique<WindowResizeEvent>(prevSize, currentSize));
+				this->dispatcher->AddEvent<WindowResizeEvent>(prevSize, currentSize);
 				this->width =  (int)currentSize.x;
 				this->height = (int)currentSize.y;
 			}
 
-			auto keyEvent = MakeUnique<KeyEvent>(&this->keyHeld, &this->keyPressed, &this->keyReleased);
-			this->dispatcher->AddEvent(std::move(keyEvent));
-			auto mousePress = MakeUnique<MouseButtonEvent>(&this->mouseHeld, &this->mousePressed, &this->mouseReleased);
-			this->dispatcher->AddEvent(std::move(mousePress));
+			this->dispatcher->AddEvent<KeyEvent>(&this->keyHeld, &this->keyPressed, &this->keyReleased);
+			this->dispatcher->AddEvent<MouseButtonEvent>(&this->mouseHeld, &this->mousePressed, &this->mouseReleased);
 
 			if (this->mousePressed.test(GLFW_MOUSE_BUTTON_1))
 			{
-				auto lbmEvent = MakeUnique<LeftMouseButtonPressedEvent>();
-				this->dispatcher->AddEvent(std::move(lbmEvent));
+				this->dispatcher->AddEvent<LeftMouseButtonPressedEvent>();
 			}
 			if (this->mousePressed.test(GLFW_MOUSE_BUTTON_2))
 			{
-				auto rbmEvent = MakeUnique<RightMouseButtonPressedEvent>();
-				this->dispatcher->AddEvent(std::move(rbmEvent));
+				this->dispatcher->AddEvent<RightMouseButtonPressedEvent>();
 			}
 			if (this->mousePressed.test(GLFW_MOUSE_BUTTON_3))
 			{
-				auto mbmEvent = MakeUnique<MiddleMouseButtonPressedEvent>();
-				this->dispatcher->AddEvent(std::move(mbmEvent));
+				this->dispatcher->AddEvent<MiddleMouseButtonPressedEvent>();
 			}
 
 			auto cursor = this->GetCursorPosition();
-			auto mouseMoveEvent = MakeUnique<MouseMoveEvent>(cursor.x, cursor.y);
-			this->dispatcher->AddEvent(std::move(mouseMoveEvent));
+			this->dispatcher->AddEvent<MouseMoveEvent>(cursor.x, cursor.y);
 		}
 		else // do not store key and mouse states if dispatcher is nullptr
 		{
@@ -432,8 +426,7 @@ namespace MxEngine
 		{
 			glfwSetWindowSize(this->window, width, height);
 			if (this->dispatcher != nullptr)
-				this->dispatcher->AddEvent(
-					MakeUnique<WindowResizeEvent>(MakeVector2((float)this->width, (float)this->height), MakeVector2((float)width, (float)height)));
+				this->dispatcher->AddEvent<WindowResizeEvent>(MakeVector2((float)this->width, (float)this->height), MakeVector2((float)width, (float)height));
 		}
 		this->width = width;
 		this->height = height;
@@ -30,15 +30,66 @@
 
 #include "Utilities/UUID/UUID.h"
 #include "Utilities/VectorPool/VectorPool.h"
+#include "Utilities/VectorPool/ChunkedPool.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace MxEngine
 {
+    /*!
+    reference counter for resources which handles are copied only from one thread at a time
+    */
+    class PlainRefCounter
+    {
+        size_t value = 0;
+    public:
+        PlainRefCounter() = default;
+
+        size_t operator++() { return ++this->value; }
+        size_t operator--() { return --this->value; }
+        operator size_t() const { return this->value; }
+    };
+
+    /*!
+    reference counter for resources which handles can be copied and destroyed from different threads simultaneously
+    */
+    class AtomicRefCounter
+    {
+        std::atomic<size_t> value{ 0 };
+    public:
+        AtomicRefCounter() = default;
+        AtomicRefCounter(AtomicRefCounter&& other) noexcept : value(other.value.load(std::memory_order_relaxed)) { }
+        AtomicRefCounter& operator=(AtomicRefCounter&& other) noexcept
+        {
+            this->value.store(other.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+
+        size_t operator++() { return this->value.fetch_add(1, std::memory_order_relaxed) + 1; }
+        size_t operator--() { return this->value.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+        operator size_t() const { return this->value.load(std::memory_order_acquire); }
+    };
+
+    /*!
+    resource traits select reference counting policy of resource type. By default reference counter is not thread-safe.
+    Use MXENGINE_ATOMIC_RESOURCE_REFCOUNT macro for types which handles are shared between threads
+    */
+    template<typename T>
+    struct ResourceTraits
+    {
+        using RefCounter = PlainRefCounter;
+    };
+
+    #define MXENGINE_ATOMIC_RESOURCE_REFCOUNT(class_name) \
+        template<> struct ResourceTraits<class_name> { using RefCounter = AtomicRefCounter; }
+
     template<typename T>
     struct ManagedResource
     {
         UUID uuid;
         T value;
-        size_t refCount = 0;
+        typename ResourceTraits<T>::RefCounter refCount;
 
         template<typename... Args>
         ManagedResource(UUID uuid, Args&&... value)
@@ -57,17 +108,33 @@ namespace MxEngine
         }
     };
 
+    /*!
+    pool type used by factories to store resources. Chunked pool grows by pages and never relocates objects,
+    vector pool stores all objects contiguously, but copies them on each growth
+    */
+    #if defined(MXENGINE_USE_CHUNKED_POOL)
+    template<typename T>
+    using ResourcePool = ChunkedPool<ManagedResource<T>>;
+    #else
+    template<typename T>
+    using ResourcePool = VectorPool<ManagedResource<T>>;
+    #endif
+
+    /*!
+    resource is a reference-counted handle to object stored in factory pool. Handle consists of pool index and generation of pool block,
+    so validation requires only one integer compare. UUID of object is stored inside pool and is used only for serialization
+    */
     template<typename T, typename F>
     class Resource
     {
-        UUID uuid;
-        size_t handle;
+        uint32_t handle;
+        uint32_t generation;
 
         #if defined(MXENGINE_DEBUG)
         mutable ManagedResource<T>* _resourcePtr = nullptr;
         #endif
 
-        static constexpr size_t InvalidHandle = std::numeric_limits<size_t>::max();
+        static constexpr uint32_t InvalidHandle = std::numeric_limits<uint32_t>::max();
 
         void IncRef()
         {
@@ -81,7 +148,7 @@ namespace MxEngine
             {
                 auto& resource = this->Dereference();
                 if ((--resource.refCount) == 0)
-                    DestroyThis(*this);
+                    ReleaseThis(*this);
             }
         }
 
@@ -96,9 +163,9 @@ namespace MxEngine
             return resource;
         }
 
-        void DestroyThis(Resource<T, F>& resource)
+        void ReleaseThis(Resource<T, F>& resource)
         {
-            Factory::Destroy(resource);
+            Factory::Release(resource);
         }
 
         ManagedResource<T>& AccessThis(size_t handle) const
@@ -110,19 +177,20 @@ namespace MxEngine
         using Factory = F;
 
         Resource()
-            : uuid(UUIDGenerator::GetNull()), handle(InvalidHandle)
+            : handle(InvalidHandle), generation(0)
         {
 
         }
 
-        Resource(UUID uuid, size_t handle)
-            : uuid(uuid), handle(handle)
+        Resource(size_t handle, uint32_t generation)
+            : handle((uint32_t)handle), generation(generation)
         {
+            MX_ASSERT(handle < InvalidHandle);
             this->IncRef();
         }
 
         Resource(const Resource& wrapper)
-            : uuid(wrapper.uuid), handle(wrapper.handle)
+            : handle(wrapper.handle), generation(wrapper.generation)
         {
             this->IncRef();
             #if defined(MXENGINE_DEBUG)
@@ -138,15 +206,15 @@ namespace MxEngine
             this->_resourcePtr = wrapper._resourcePtr;
             #endif
 
-            this->uuid = wrapper.uuid;
             this->handle = wrapper.handle;
+            this->generation = wrapper.generation;
             this->IncRef();
 
             return *this;
         }
 
         Resource(Resource&& wrapper) noexcept
-            : uuid(wrapper.uuid), handle(wrapper.handle)
+            : handle(wrapper.handle), generation(wrapper.generation)
         {
             #if defined(MXENGINE_DEBUG)
             this->_resourcePtr = wrapper._resourcePtr;
@@ -157,8 +225,8 @@ namespace MxEngine
         Resource& operator=(Resource&& wrapper) noexcept
         {
             this->DecRef();
-            this->uuid = wrapper.uuid;
             this->handle = wrapper.handle;
+            this->generation = wrapper.generation;
             wrapper.handle = InvalidHandle;
 
             #if defined(MXENGINE_DEBUG)
@@ -169,7 +237,9 @@ namespace MxEngine
 
         [[nodiscard]] bool IsValid() const
         {
-            return handle != InvalidHandle && Dereference().uuid == uuid;
+            // pool may be cleared or not yet grown to the handle, so its capacity is checked before accessing the block
+            const auto& pool = F::template Get<T>();
+            return handle != InvalidHandle && handle < pool.Capacity() && pool.GetGeneration(handle) == generation;
         }
 
         void MakeStatic()
@@ -217,19 +287,24 @@ namespace MxEngine
             return &this->Dereference().value;
         }
 
-        [[nodiscard]] auto GetHandle() const
+        [[nodiscard]] size_t GetHandle() const
         {
-            return this->handle;
+            return this->handle == InvalidHandle ? std::numeric_limits<size_t>::max() : (size_t)this->handle;
         }
 
-        [[nodiscard]] const auto& GetUUID() const
+        [[nodiscard]] uint32_t GetGeneration() const
         {
-            return this->uuid;
+            return this->generation;
+        }
+
+        [[nodiscard]] UUID GetUUID() const
+        {
+            return this->IsValid() ? this->Dereference().uuid : UUIDGenerator::GetNull();
         }
 
         [[nodiscard]] bool operator==(const Resource& wrapper) const
         {
-            return this->handle == wrapper.handle && this->uuid == wrapper.uuid;
+            return this->handle == wrapper.handle && this->generation == wrapper.generation;
         }
 
         [[nodiscard]] bool operator!=(const Resource& wrapper) const
@@ -239,7 +314,7 @@ namespace MxEngine
 
         [[nodiscard]] bool operator<(const Resource& wrapper) const
         {
-            return (this->handle != wrapper.handle) ? (this->handle < wrapper.handle) : (this->uuid < wrapper.uuid);
+            return (this->handle != wrapper.handle) ? (this->handle < wrapper.handle) : (this->generation < wrapper.generation);
         }
 
         [[nodiscard]] bool operator>(const Resource& wrapper) const
@@ -267,7 +342,7 @@ namespace MxEngine
     struct FactoryImpl : FactoryImpl<Args...>
     {
         using Base = FactoryImpl<Args...>;
-        using Pool = VectorPool<ManagedResource<T>>;
+        using Pool = ResourcePool<T>;
         Pool pool;
 
         template<typename U>
@@ -290,7 +365,7 @@ namespace MxEngine
     template<typename T>
     struct FactoryImpl<T>
     {
-        using FactoryPool = VectorPool<ManagedResource<T>>;
+        using FactoryPool = ResourcePool<T>;
         FactoryPool Pool;
 
         template<typename U>
@@ -307,17 +382,81 @@ namespace MxEngine
         }
     };
 
+    /*!
+    queue of resources which reference count reached zero. Resources are destroyed in batch when queue is flushed,
+    which is done once per frame by application. Queue can be safely filled from multiple threads
+    */
+    class ResourceDestructionQueue
+    {
+        using Deleter = void(*)(size_t handle, uint32_t generation);
+
+        struct Entry
+        {
+            Deleter Destroy;
+            uint32_t Handle;
+            uint32_t Generation;
+        };
+
+        MxVector<Entry> entries;
+        MxVector<Entry> processing;
+        std::mutex mutex;
+    public:
+        void Push(Deleter deleter, size_t handle, uint32_t generation)
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->entries.push_back(Entry{ deleter, (uint32_t)handle, generation });
+        }
+
+        /*!
+        destroys all queued resources. Resources released during flush (i.e. owned by destroyed ones) are destroyed too
+        \returns number of processed queue entries
+        */
+        size_t Flush()
+        {
+            size_t processed = 0;
+            while (true)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    if (this->entries.empty()) break;
+                    std::swap(this->entries, this->processing);
+                }
+                for (const auto& entry : this->processing)
+                {
+                    entry.Destroy(entry.Handle, entry.Generation);
+                }
+                processed += this->processing.size();
+                this->processing.clear();
+            }
+            return processed;
+        }
+    };
+
     template<typename... Args>
     class AbstractFactoryImpl
     {
     public:
         using Factory = FactoryImpl<Args...>;
         using ThisType = AbstractFactoryImpl<Args...>;
+
+        struct FactoryStorage : Factory
+        {
+            ResourceDestructionQueue DestructionQueue;
+        };
     private:
-        inline static Factory* factory = nullptr;
+        inline static FactoryStorage* factory = nullptr;
+
+        template<typename T>
+        static void DestroyReleased(size_t handle, uint32_t generation)
+        {
+            auto& pool = factory->template GetPool<T>();
+            // resource could be destroyed explicitly or acquired again by GetHandle() after it was queued
+            if (pool.IsAllocated(handle) && pool.GetGeneration(handle) == generation && pool[handle].refCount == 0)
+                pool.Deallocate(handle);
+        }
     public:
 
-        static Factory* GetImpl()
+        static FactoryStorage* GetImpl()
         {
             return factory;
         }
@@ -325,7 +464,7 @@ namespace MxEngine
         static void Init()
         {
             if (factory == nullptr)
-                factory = new Factory(); // not deleted, but its static member, so it does not matter
+                factory = new FactoryStorage(); // not deleted, but its static member, so it does not matter
         }
 
         static void Destroy()
@@ -335,7 +474,7 @@ namespace MxEngine
             factory = nullptr;
         }
 
-        static void Clone(Factory* other)
+        static void Clone(FactoryStorage* other)
         {
             factory = other;
         }
@@ -353,7 +492,7 @@ namespace MxEngine
             UUID uuid = UUIDGenerator::Get();
             auto& pool = factory->template GetPool<T>();
             size_t index = pool.Allocate(uuid, std::forward<ConstructArgs>(args)...);
-            return Resource<T, ThisType>(uuid, index);
+            return Resource<T, ThisType>(index, pool.GetGeneration(index));
         }
 
         template<typename T>
@@ -361,7 +500,7 @@ namespace MxEngine
         {
             auto& pool = factory->template GetPool<T>();
             size_t index = pool.IndexOf(object);
-            return Resource<T, ThisType>(pool[index].uuid, index);
+            return Resource<T, ThisType>(index, pool.GetGeneration(index));
         }
 
         template<typename T>
@@ -372,6 +511,26 @@ namespace MxEngine
             return GetHandle(*resourcePtr);
         }
 
+        /*!
+        called when last handle to resource is destroyed. Resource is not destroyed immediately, but queued until FlushReleased() call
+        \param resource handle to released resource
+        */
+        template<typename T>
+        static void Release(Resource<T, ThisType>& resource)
+        {
+            factory->DestructionQueue.Push(DestroyReleased<T>, resource.GetHandle(), resource.GetGeneration());
+        }
+
+        /*!
+        destroys all resources which were released since last call
+        \returns number of destroyed resources
+        */
+        static size_t FlushReleased()
+        {
+            MX_ASSERT(factory != nullptr);
+            return factory->DestructionQueue.Flush();
+        }
+
         template<typename T>
         static void Destroy(Resource<T, ThisType>& resource)
         {
@@ -34,9 +34,42 @@ namespace MxEngine
 {
     class ComponentManager;
 
+    /*!
+    list of component types which must finish their updates before update of other component type starts
+    */
+    template<typename... Components>
+    struct ComponentUpdateDependencies { };
+
+    /*!
+    update policy tells engine how OnUpdate() methods of component type can be scheduled. By default all components are updated
+    sequentially on main thread. Use MXENGINE_COMPONENT_UPDATE_POLICY macro to specialize it for component
+    */
+    template<typename T>
+    struct ComponentUpdatePolicy
+    {
+        /*!
+        OnUpdate() of different components of type T can be invoked simultaneously from different threads
+        */
+        static constexpr bool IsThreadSafe = false;
+        /*!
+        OnUpdate() does not access graphic context and does not modify state of other component types (except listed in dependencies),
+        so update can be performed by worker thread concurrently with updates of other independent component types.
+        Independent updates start after all main thread updates, so they can safely read object transforms
+        */
+        static constexpr bool IsIndependent = false;
+        /*!
+        minimal number of pool slots updated by one job if component update is thread safe
+        */
+        static constexpr size_t ChunkSize = 256;
+        /*!
+        component types which must be updated before T
+        */
+        using Dependencies = ComponentUpdateDependencies<>;
+    };
+
     struct Component
     {
-        using Deleter = void (*)(void*);
+        using Deleter = void (*)(void*, size_t);
 
         std::aligned_storage_t<sizeof(CResource<char>)> resource;
         size_t type;
@@ -48,12 +81,20 @@ namespace MxEngine
             static_assert(sizeof(CResource<T>) == sizeof(Component::resource), "storage must fit resource size");
 
             this->type = type;
-            this->deleter = [](void* ptr) { ComponentFactory::Destroy(*std::launder(reinterpret_cast<CResource<T>*>(ptr))); };
+            this->deleter = [](void* ptr, size_t owner) 
+            { 
+                ComponentFactory::GetStorage<T>().Owners.Remove(owner);
+                ComponentFactory::Destroy(*std::launder(reinterpret_cast<CResource<T>*>(ptr))); 
+            };
             auto* replace = new (&resource) CResource<T>();
             *replace = std::move(component);
         }
     };
 
+    /*!
+    component manager stores list of components attached to an object. Lookup by component type is performed in O(1) through
+    sparse sets of component storage, which map object index to component index. The list itself is used only for bulk removal
+    */
     class ComponentManager
     {
         template<typename T>
@@ -65,36 +106,39 @@ namespace MxEngine
         ComponentManager(const ComponentManager&) = delete;
         ComponentManager(ComponentManager&&) = default;
         ComponentManager& operator=(const ComponentManager&) = delete;
-        ComponentManager& operator=(ComponentManager&&) = default;
+        // components of overwritten manager would leak, as manager does not know their owner to destroy them
+        ComponentManager& operator=(ComponentManager&&) = delete;
 
         template<typename T, typename... Args>
-        CResource<T> AddComponent(Args&&... args)
+        CResource<T> AddComponent(size_t owner, Args&&... args)
         {
-            this->RemoveComponent<T>();
+            this->RemoveComponent<T>(owner);
             
             auto component = ComponentFactory::CreateComponent<T>(std::forward<Args>(args)...);
+            ComponentFactory::GetStorage<T>().Owners.Set(owner, component.GetHandle());
             auto& data = components.emplace_back();
             Component* result = new (&data) Component(T::ComponentId, std::move(component));
             return *std::launder(reinterpret_cast<CResource<T>*>(&result->resource));
         }
 
         template<typename T>
-        CResource<T> GetComponent() const
+        CResource<T> GetComponent(size_t owner) const
         {
-            for (const auto& component : components)
-            {
-                const auto& componentRef = *reinterpret_cast<const Component*>(&component);
-                if (componentRef.type == T::ComponentId)
-                {
-                    return *std::launder(reinterpret_cast<const CResource<T>*>(&componentRef.resource));
-                }
-            }
-            return CResource<T>{ };
+            auto& storage = ComponentFactory::GetStorage<T>();
+            size_t index = storage.Owners.Get(owner);
+            if (index == ComponentSparseSet::InvalidIndex) return CResource<T>{ };
+
+            auto& pool = storage.Factory.template GetPool<T>();
+            return CResource<T>{ index, pool.GetGeneration(index) };
         }
 
         template<typename T>
-        void RemoveComponent()
+        void RemoveComponent(size_t owner)
         {
+            auto& storage = ComponentFactory::GetStorage<T>();
+            if (storage.Owners.Get(owner) == ComponentSparseSet::InvalidIndex) return;
+            storage.Owners.Remove(owner);
+
             for (auto it = components.begin(); it != components.end(); it++)
             {
                 auto& componentRef = *reinterpret_cast<Component*>(&*it);
@@ -112,24 +156,24 @@ namespace MxEngine
         }
 
         template<typename T>
-        bool HasComponent() const
+        bool HasComponent(size_t owner) const
         {
-            return this->GetComponent<T>().IsValid();
+            return ComponentFactory::GetStorage<T>().Owners.Get(owner) != ComponentSparseSet::InvalidIndex;
         }
 
-        void RemoveAllComponents()
+        void RemoveAllComponents(size_t owner)
         {
             for (auto& component : components)
             {
                 auto& componentRef = *std::launder(reinterpret_cast<Component*>(&component));
-                componentRef.deleter(static_cast<void*>(&componentRef.resource));
+                componentRef.deleter(static_cast<void*>(&componentRef.resource), owner);
             }
             components.clear();
         }
 
         ~ComponentManager()
         {
-            this->RemoveAllComponents();
+            MX_ASSERT(this->components.empty()); // owner must remove all components before destruction
         }
     };
 
@@ -145,4 +189,12 @@ namespace MxEngine
                 friend class MxObject;\
                 friend class ComponentManager; \
                 friend class ComponentFactory
+
+    // marks component update as independent from other component types. Note that components must not be created or destroyed inside such update
+    #define MXENGINE_COMPONENT_UPDATE_POLICY(class_name, is_thread_safe, ...) namespace MxEngine {\
+        template<> struct ComponentUpdatePolicy<class_name> {\
+            static constexpr bool IsThreadSafe = is_thread_safe;\
+            static constexpr bool IsIndependent = true;\
+            static constexpr size_t ChunkSize = 256;\
+            using Dependencies = ComponentUpdateDependencies<__VA_ARGS__>; }; }
 }
@@ -29,29 +29,105 @@
 #pragma once
 
 #include "Utilities/STL/MxHashMap.h"
+#include "Utilities/Memory/Memory.h"
 #include "Utilities/String/String.h"
 #include "Utilities/AbstractFactory/AbstractFactory.h"
 #include "Utilities/ECS/ComponentView.h"
 
+#include <array>
+#include <limits>
+#include <tuple>
+
 namespace MxEngine
 {
+    /*!
+    sparse set maps index of component owner to index of component in its pool. Indicies are stored in pages,
+    which are allocated only when owner with index inside page range receives component
+    */
+    class ComponentSparseSet
+    {
+        static constexpr size_t PageSize = 1024;
+        using Page = std::array<uint32_t, PageSize>;
+
+        MxVector<UniqueRef<Page>> pages;
+    public:
+        static constexpr size_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        size_t Get(size_t owner) const
+        {
+            size_t page = owner / PageSize;
+            if (page >= this->pages.size() || this->pages[page] == nullptr) return InvalidIndex;
+            return (*this->pages[page])[owner % PageSize];
+        }
+
+        void Set(size_t owner, size_t index)
+        {
+            MX_ASSERT(index < InvalidIndex);
+            size_t page = owner / PageSize;
+            if (page >= this->pages.size()) this->pages.resize(page + 1);
+            if (this->pages[page] == nullptr)
+            {
+                this->pages[page] = MakeUnique<Page>();
+                this->pages[page]->fill((uint32_t)InvalidIndex);
+            }
+            (*this->pages[page])[owner % PageSize] = (uint32_t)index;
+        }
+
+        void Remove(size_t owner)
+        {
+            size_t page = owner / PageSize;
+            if (page < this->pages.size() && this->pages[page] != nullptr)
+                (*this->pages[page])[owner % PageSize] = (uint32_t)InvalidIndex;
+        }
+    };
+
+    template<typename T>
+    struct ComponentStorage
+    {
+        FactoryImpl<T> Factory;
+        ComponentSparseSet Owners;
+    };
+
+    template<typename T, typename... Others>
+    class MultiComponentView;
+
     class ComponentFactory
     {
-        static constexpr size_t FactorySize = sizeof(FactoryImpl<char>);
+        static constexpr size_t FactorySize = sizeof(ComponentStorage<char>);
     public:
         using FactoryMap = MxHashMap<StringId, std::aligned_storage_t<FactorySize>>;
     private:
         inline static FactoryMap* factories = nullptr;
     public:
         template<typename T>
-        static FactoryImpl<T>& GetFactory()
+        static ComponentStorage<T>& GetStorage()
         {
-            if (factories->find(T::ComponentId) == factories->end())
+            auto it = factories->find(T::ComponentId);
+            if (it == factories->end())
             {
-                new (&(*factories)[T::ComponentId]) FactoryImpl<T>();
+                auto& storage = (*factories)[T::ComponentId];
+                new (&storage) ComponentStorage<T>();
+                return *std::launder(reinterpret_cast<ComponentStorage<T>*>(&storage));
             }
-            auto factory = std::launder(reinterpret_cast<FactoryImpl<T>*>(&(*factories)[T::ComponentId]));
-            return *factory;
+            return *std::launder(reinterpret_cast<ComponentStorage<T>*>(&it->second));
+        }
+
+        template<typename T>
+        static FactoryImpl<T>& GetFactory()
+        {
+            return GetStorage<T>().Factory;
+        }
+
+        template<typename T>
+        static StringId GetComponentId()
+        {
+            return T::ComponentId;
+        }
+
+        template<typename T>
+        static size_t GetOwnerIndex(const T& component)
+        {
+            return reinterpret_cast<size_t>(component.UserData);
         }
 
         template<typename T>
@@ -66,13 +142,23 @@ namespace MxEngine
             return ComponentView{ Get<T>() };
         }
 
+        /*!
+        creates view over all owners which have all listed components. Iteration is performed over pool of first component type,
+        so it is better to place the rarest component first
+        */
+        template<typename T, typename U, typename... Rest>
+        static MultiComponentView<T, U, Rest...> GetView()
+        {
+            return MultiComponentView<T, U, Rest...>{ };
+        }
+
         template<typename T, typename... Args>
         static auto CreateComponent(Args&&... args)
         {
             UUID uuid = UUIDGenerator::Get();
             auto& pool = Get<T>();
             size_t index = pool.Allocate(uuid, std::forward<Args>(args)...);
-            return Resource<T, ComponentFactory>(uuid, index);
+            return Resource<T, ComponentFactory>(index, pool.GetGeneration(index));
         }
 
         template<typename T>
@@ -81,6 +167,15 @@ namespace MxEngine
             Get<T>().Deallocate(resource.GetHandle());
         }
 
+        /*!
+        components lifetime is controlled by component manager of owner object, so they are destroyed immediately
+        */
+        template<typename T>
+        static void Release(Resource<T, ComponentFactory>& resource)
+        {
+            Destroy(resource);
+        }
+
         static void Init()
         {
             factories = new FactoryMap(); // static data, so dont care about freeing
@@ -99,4 +194,101 @@ namespace MxEngine
 
     template<typename T>
     using CResource = Resource<T, ComponentFactory>;
+
+    /*!
+    multi component view iterates over all owners which have each of listed components,
+    providing tuple of component references. Other components are found through sparse sets in O(1)
+    */
+    template<typename T, typename... Others>
+    class MultiComponentView
+    {
+        using Pool = typename FactoryImpl<T>::FactoryPool;
+        using Reference = std::tuple<T&, Others&...>;
+
+        Pool* pool;
+        std::tuple<ComponentStorage<Others>*...> others;
+
+        template<typename U>
+        size_t IndexOf(size_t owner) const
+        {
+            return std::get<ComponentStorage<U>*>(this->others)->Owners.Get(owner);
+        }
+
+        template<typename U>
+        U& Access(size_t owner) const
+        {
+            auto& storage = *std::get<ComponentStorage<U>*>(this->others);
+            return storage.Factory.template GetPool<U>()[storage.Owners.Get(owner)].value;
+        }
+
+        bool IsMatch(size_t index) const
+        {
+            size_t owner = ComponentFactory::GetOwnerIndex((*this->pool)[index].value);
+            return ((this->IndexOf<Others>(owner) != ComponentSparseSet::InvalidIndex) && ...);
+        }
+    public:
+        class Iterator
+        {
+            const MultiComponentView* view;
+            size_t index;
+
+            void SkipNotMatching()
+            {
+                auto& pool = *this->view->pool;
+                this->index = pool.NextAllocated(this->index);
+                while (this->index < pool.Capacity() && !this->view->IsMatch(this->index))
+                    this->index = pool.NextAllocated(this->index + 1);
+            }
+        public:
+            Iterator(const MultiComponentView* view, size_t index)
+                : view(view), index(index)
+            {
+                this->SkipNotMatching();
+            }
+
+            Iterator& operator++()
+            {
+                this->index++;
+                this->SkipNotMatching();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator copy = *this;
+                ++(*this);
+                return copy;
+            }
+
+            Reference operator*() const
+            {
+                auto& component = (*this->view->pool)[this->index].value;
+                size_t owner = ComponentFactory::GetOwnerIndex(component);
+                return Reference{ component, this->view->template Access<Others>(owner)... };
+            }
+
+            bool operator==(const Iterator& other) const
+            {
+                return this->index == other.index && this->view == other.view;
+            }
+
+            bool operator!=(const Iterator& other) const
+            {
+                return !(*this == other);
+            }
+        };
+
+        MultiComponentView()
+            : pool(&ComponentFactory::Get<T>()), others(&ComponentFactory::GetStorage<Others>()...) { }
+
+        Iterator begin() const
+        {
+            return Iterator{ this, 0 };
+        }
+
+        Iterator end() const
+        {
+            return Iterator{ this, this->pool->Capacity() };
+        }
+    };
 }
\ No newline at end of file
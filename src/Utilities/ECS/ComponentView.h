@@ -42,7 +42,7 @@ namespace MxEngine
     class ComponentView
     {
     public:
-        using Pool = VectorPool<ManagedResource<T>>;
+        using Pool = ResourcePool<T>;
 
         /*!
         wrapper around vector Pool iterator. Actually does nothing more than forwards all methods to wrapped iterator
@@ -33,28 +33,37 @@
 
 #include "Utilities/Profiler/Profiler.h"
 #include "Utilities/Memory/Memory.h"
+#include "Utilities/EventDispatcher/EventDispatcherFwd.h"
+#include "Utilities/EventDispatcher/EventQueue.h"
 #include "Utilities/STL/MxHashMap.h"
+#include "Utilities/STL/MxHashSet.h"
 #include "Utilities/STL/MxVector.h"
 
 namespace MxEngine
 {
 	/*!
 	EventDispatcher class is used to handle all events inside MxEngine. Events can either be dispatch for Application (global) or
-	for currently active scene. Note that events are NOT dispatched when developer console is opened and instead sheduled until it close
+	for currently active scene. Note that events are NOT dispatched when developer console is opened and instead sheduled until it close.
+	Events can be scheduled from any thread, but listeners can be added, removed and invoked only from main thread
 	*/
 	template<typename EventBase>
 	class EventDispatcherImpl
 	{
 		using CallbackBaseFunction = std::function<void(EventBase&)>;
-		using NamedCallback = std::pair<MxString, CallbackBaseFunction>;
-		using CallbackList = MxVector<NamedCallback>;
-		using EventList = MxVector<UniqueRef<EventBase>>;
 		using EventTypeIndex = uint32_t;
 
+		struct Listener
+		{
+			EventListenerId Id;
+			CallbackBaseFunction Callback;
+		};
+
+		using CallbackList = MxVector<Listener>;
+
 		/*!
-		list of scheduled all events
+		queue of scheduled events. Events are constructed inside queue ring buffer
 		*/
-		EventList events;
+		EventQueue<EventBase> events;
 		/*!
 		maps event id to list of event listeners of that id 
 		*/
@@ -68,7 +77,19 @@ namespace MxEngine
 		shedules listeners which will be removed next frame. 
 		This cache exists to prevent crushes when user wants to remove event listener inside other listener callback (or even perform self-removal).
 		*/
-		MxVector<MxString> toRemoveCache;
+		MxHashSet<EventListenerId> toRemoveCache;
+		/*!
+		maps listener name to ids of all listeners added with that name
+		*/
+		MxHashMap<MxString, MxVector<EventListenerId>> namedListeners;
+		/*!
+		maps listener id to its name
+		*/
+		MxHashMap<EventListenerId, MxString> listenerNames;
+		/*!
+		id which will be given to next added listener
+		*/
+		EventListenerId nextListenerId = 1;
 
 		/*!
 		immediately invokes all listeners of event, if any exists
@@ -77,10 +98,12 @@ namespace MxEngine
 		inline void ProcessEvent(EventBase& event)
 		{
 			MAKE_SCOPE_PROFILER(typeid(event).name());
-			auto& eventCallbacks = this->callbacks[event.GetEventType()];
-			for (const auto& [name, callback] : eventCallbacks)
+			auto eventCallbacks = this->callbacks.find(event.GetEventType());
+			if (eventCallbacks == this->callbacks.end()) return;
+
+			for (const auto& [id, callback] : eventCallbacks->second)
 			{
-				if (std::find(this->toRemoveCache.begin(), this->toRemoveCache.end(), name) == this->toRemoveCache.end())
+				if (this->toRemoveCache.empty() || this->toRemoveCache.find(id) == this->toRemoveCache.end())
 				{
 					callback(event);
 				}
@@ -91,23 +114,27 @@ namespace MxEngine
 		adds new listener callback to cache queue
 		\param name callback name (used for removal)
 		\param func callback functor
+		\returns id of added listener
 		*/
 		template<typename EventType>
-		inline void AddCallbackImpl(MxString name, CallbackBaseFunction&& func)
+		inline EventListenerId AddCallbackImpl(const MxString& name, CallbackBaseFunction&& func)
 		{
-			this->toAddCache[EventType::eventType].emplace_back(std::move(name), std::move(func));
+			EventListenerId id = this->nextListenerId++;
+			this->toAddCache[EventType::eventType].push_back(Listener{ id, std::move(func) });
+			this->namedListeners[name].push_back(id);
+			this->listenerNames.emplace(id, name);
+			return id;
 		}
 
 		/*!
-		immediately removes all listeners with same name from list
+		immediately removes all listeners which are in toRemoveCache from list
 		\param callbacks list of listeners callbacks
-		\param name name of listeners to search for
 		*/
-		inline void RemoveEventByName(CallbackList& callbacks, const MxString& name)
+		inline void RemoveScheduledListeners(CallbackList& callbacks)
 		{
-			auto it = std::remove_if(callbacks.begin(), callbacks.end(), [&name](const auto& p)
+			auto it = std::remove_if(callbacks.begin(), callbacks.end(), [this](const Listener& listener)
 			{
-				return p.first == name;
+				return this->toRemoveCache.find(listener.Id) != this->toRemoveCache.end();
 			});
 			callbacks.erase(it, callbacks.end());
 		}
@@ -116,11 +143,12 @@ namespace MxEngine
 		wraps event listener into callback with base event as argument. Actual type is retrieved inside callback
 		\param name name of listener to add
 		\param func listener callback function
+		\returns id of added listener
 		*/
 		template<typename EventType>
-		void AddEventListenerImpl(const MxString& name, std::function<void(EventType&)> func)
+		EventListenerId AddEventListenerImpl(const MxString& name, std::function<void(EventType&)> func)
 		{
-			this->template AddCallbackImpl<EventType>(name, [func = std::move(func)](EventBase& e)
+			return this->template AddCallbackImpl<EventType>(name, [func = std::move(func)](EventBase& e)
 			{
 				if (e.GetEventType() == EventType::eventType)
 					func(static_cast<EventType&>(e));
@@ -132,14 +160,14 @@ namespace MxEngine
 		*/
 		inline void FlushEvents()
 		{
-			for (auto it = this->toRemoveCache.begin(); it != this->toRemoveCache.end(); it++)
+			if (!this->toRemoveCache.empty())
 			{
 				for (auto& [event, callbacks] : this->callbacks)
 				{
-					RemoveEventByName(callbacks, *it);
+					RemoveScheduledListeners(callbacks);
 				}
+				this->toRemoveCache.clear();
 			}
-			this->toRemoveCache.clear();
 
 			for (auto it = this->toAddCache.begin(); it != this->toAddCache.end(); it++)
 			{
@@ -157,11 +185,12 @@ namespace MxEngine
 		Note that multiple listeners may have same name. If so, deleting by name will result in removing all of them
 		\param name name of listener (used for deleting listener)
 		\param func listener callback functor
+		\returns unique id of listener
 		*/
 		template<typename EventType>
-		void AddEventListener(const MxString& name, std::function<void(EventType&)> func)
+		EventListenerId AddEventListener(const MxString& name, std::function<void(EventType&)> func)
 		{
-			this->AddEventListenerImpl(name, std::move(func));
+			return this->AddEventListenerImpl(name, std::move(func));
 		}
 
 		/*!
@@ -169,11 +198,33 @@ namespace MxEngine
 		Note that multiple listeners may have same name. If so, deleting by name will result in removing all of them
 		\param name name of listener (used for deleting listener)
 		\param func listener callback functor
+		\returns unique id of listener
 		*/
 		template<typename T, typename FunctionType>
-		void AddEventListener(const MxString& name, FunctionType&& func)
+		EventListenerId AddEventListener(const MxString& name, FunctionType&& func)
 		{
-			this->AddEventListenerImpl(name, std::function<void(T&)>{ std::forward<FunctionType>(func) });
+			return this->AddEventListenerImpl(name, std::function<void(T&)>{ std::forward<FunctionType>(func) });
+		}
+
+		/*!
+		removes event listener by its id
+		\param id id returned when listener was added
+		*/
+		void RemoveEventListener(EventListenerId id)
+		{
+			auto name = this->listenerNames.find(id);
+			if (name == this->listenerNames.end()) return;
+
+			auto& ids = this->namedListeners[name->second];
+			ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+			if (ids.empty()) this->namedListeners.erase(name->second);
+			this->listenerNames.erase(name);
+			this->toRemoveCache.insert(id);
+
+			for (auto& [event, callbacks] : this->toAddCache)
+			{
+				RemoveScheduledListeners(callbacks);
+			}
 		}
 
 		/*!
@@ -182,11 +233,19 @@ namespace MxEngine
 		*/
 		void RemoveEventListener(const MxString& name)
 		{
-			this->toRemoveCache.push_back(name);
-			
+			auto it = this->namedListeners.find(name);
+			if (it == this->namedListeners.end()) return;
+
+			for (EventListenerId id : it->second)
+			{
+				this->toRemoveCache.insert(id);
+				this->listenerNames.erase(id);
+			}
+			this->namedListeners.erase(it);
+
 			for (auto& [event, callbacks] : this->toAddCache)
 			{
-				RemoveEventByName(callbacks, name);
+				RemoveScheduledListeners(callbacks);
 			}
 		}
 		
@@ -202,12 +261,22 @@ namespace MxEngine
 		}
 
 		/*!
-		Adds event to event queue.
+		Adds event to event queue. Can be called from any thread
 		\param event event to shedule dispatch
 		*/
 		void AddEvent(UniqueRef<EventBase> event)
 		{
-			this->events.push_back(std::move(event));
+			this->events.Push(event.release(), [](EventBase* e) { delete e; });
+		}
+
+		/*!
+		Constructs event in dispatcher queue and adds it to event queue. Prefer it over heap-allocated events. Can be called from any thread
+		\param args arguments for event constructor
+		*/
+		template<typename EventType, typename... Args>
+		void AddEvent(Args&&... args)
+		{
+			this->events.template Emplace<EventType>(std::forward<Args>(args)...);
 		}
 
 		/*!
@@ -216,12 +285,7 @@ namespace MxEngine
 		void InvokeAll()
 		{
 			this->FlushEvents();
-
-			for (size_t i = 0; i < this->events.size(); i++)
-			{
-				this->ProcessEvent(*this->events[i]);
-			}
-			this->events.clear();
+			this->events.ConsumeAll([this](EventBase& event) { this->ProcessEvent(event); });
 		}
 
 		/*!
@@ -229,18 +293,10 @@ namespace MxEngine
 		\param name name of event
 		\returns true if event listener present, false otherwise
 		*/
-		bool HasEventListenerWithName(const MxString& name) 
+		bool HasEventListenerWithName(const MxString& name) const
 		{
-			this->FlushEvents();
-			for (const auto& [event, callbacks] : this->callbacks)
-			{
-				for (const auto& [callbackName, func] : callbacks)
-				{
-					if (callbackName == name)
-						return true;
-				}
-			}
-			return false;
+			auto it = this->namedListeners.find(name);
+			return it != this->namedListeners.end() && !it->second.empty();
 		}
 	};
 }
\ No newline at end of file
@@ -43,6 +43,11 @@ namespace MxEngine
 	public: inline virtual uint32_t GetEventType() const override { return eventType; } private:\
 	constexpr static uint32_t eventType = STRING_ID(#class_name)
 
+	/*!
+	unique identifier of event listener, returned when listener is added and used to remove it
+	*/
+	using EventListenerId = uint64_t;
+
 	template<typename EventBase>
 	class EventDispatcherImpl;
 }
\ No newline at end of file
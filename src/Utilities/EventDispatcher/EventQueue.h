@@ -0,0 +1,225 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <cstddef>
+
+#include "Utilities/Memory/Memory.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+	/*!
+	EventQueue is a multi-producer single-consumer queue of polymorphic events. Events are constructed inline in slots of bounded
+	ring buffer (Vyukov algorithm), so posting event from any thread requires neither lock nor heap allocation.
+	Events which do not fit into slot or are posted while ring is full are placed into locked overflow list. Once overflow is used,
+	all producers post into it until consumer drains queue, so events of each producer are always consumed in order they were posted
+	*/
+	template<typename EventBase, size_t Capacity = 1024, size_t SlotSize = 128>
+	class EventQueue
+	{
+		static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "event queue capacity must be power of 2");
+
+		using EventDeleter = void(*)(EventBase*);
+
+		static constexpr size_t Mask = Capacity - 1;
+
+		struct Slot
+		{
+			/*!
+			equals to position for free slot and to position + 1 for slot with published event
+			*/
+			std::atomic<size_t> Sequence;
+			EventBase* Event;
+			EventDeleter Deleter;
+			alignas(std::max_align_t) uint8_t Storage[SlotSize];
+		};
+
+		struct OverflowEvent
+		{
+			EventBase* Event;
+			EventDeleter Deleter;
+		};
+
+		UniqueRef<Slot[]> slots;
+		alignas(64) std::atomic<size_t> enqueuePosition{ 0 };
+		alignas(64) size_t dequeuePosition = 0;
+		std::atomic<bool> hasOverflow{ false };
+		std::mutex overflowMutex;
+		MxVector<OverflowEvent> overflow;
+		/*!
+		overflow events taken by consumer. Kept as member to reuse its storage
+		*/
+		MxVector<OverflowEvent> overflowProcessing;
+
+		Slot* AcquireSlot(size_t& position)
+		{
+			if (this->hasOverflow.load(std::memory_order_acquire)) return nullptr;
+
+			position = this->enqueuePosition.load(std::memory_order_relaxed);
+			while (true)
+			{
+				Slot& slot = this->slots[position & Mask];
+				size_t sequence = slot.Sequence.load(std::memory_order_acquire);
+				auto difference = (std::ptrdiff_t)sequence - (std::ptrdiff_t)position;
+				if (difference == 0)
+				{
+					if (this->enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						return &slot;
+				}
+				else if (difference < 0)
+				{
+					return nullptr; // ring is full
+				}
+				else
+				{
+					position = this->enqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		void PushOverflow(EventBase* event, EventDeleter deleter)
+		{
+			std::lock_guard<std::mutex> lock(this->overflowMutex);
+			this->overflow.push_back(OverflowEvent{ event, deleter });
+			this->hasOverflow.store(true, std::memory_order_release);
+		}
+	public:
+		EventQueue()
+			: slots(new Slot[Capacity])
+		{
+			for (size_t i = 0; i < Capacity; i++)
+				this->slots[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+
+		EventQueue(const EventQueue&) = delete;
+		EventQueue& operator=(const EventQueue&) = delete;
+
+		~EventQueue()
+		{
+			this->ConsumeAll([](EventBase&) { });
+		}
+
+		/*!
+		constructs event inside queue. Can be called from any thread
+		\param args arguments for event constructor
+		*/
+		template<typename EventType, typename... Args>
+		void Emplace(Args&&... args)
+		{
+			static_assert(std::is_base_of_v<EventBase, EventType>, "event type must be derived from event base");
+
+			if constexpr (sizeof(EventType) <= SlotSize && alignof(EventType) <= alignof(std::max_align_t))
+			{
+				size_t position = 0;
+				Slot* slot = this->AcquireSlot(position);
+				if (slot != nullptr)
+				{
+					slot->Event = new(slot->Storage) EventType(std::forward<Args>(args)...);
+					slot->Deleter = [](EventBase* event) { event->~EventBase(); };
+					slot->Sequence.store(position + 1, std::memory_order_release);
+					return;
+				}
+			}
+			this->PushOverflow(Alloc<EventType>(std::forward<Args>(args)...), [](EventBase* event) { Free(event); });
+		}
+
+		/*!
+		adds already constructed event to queue. Can be called from any thread
+		\param event event to add
+		\param deleter function which is called to destroy event after it is consumed
+		*/
+		void Push(EventBase* event, EventDeleter deleter)
+		{
+			size_t position = 0;
+			Slot* slot = this->AcquireSlot(position);
+			if (slot != nullptr)
+			{
+				slot->Event = event;
+				slot->Deleter = deleter;
+				slot->Sequence.store(position + 1, std::memory_order_release);
+			}
+			else
+			{
+				this->PushOverflow(event, deleter);
+			}
+		}
+
+		/*!
+		invokes functor for each event in queue and destroys consumed events. Events posted by functor itself are consumed too.
+		Can be called only from consumer thread
+		\param func functor with signature `void(EventBase&)`
+		\returns number of consumed events
+		*/
+		template<typename F>
+		size_t ConsumeAll(F&& func)
+		{
+			size_t consumed = 0;
+			while (true)
+			{
+				size_t consumedBefore = consumed;
+				while (true)
+				{
+					Slot& slot = this->slots[this->dequeuePosition & Mask];
+					if (slot.Sequence.load(std::memory_order_acquire) != this->dequeuePosition + 1)
+						break; // queue is empty or next event is not published yet
+
+					func(*slot.Event);
+					slot.Deleter(slot.Event);
+					slot.Sequence.store(this->dequeuePosition + Capacity, std::memory_order_release);
+					this->dequeuePosition++;
+					consumed++;
+				}
+
+				if (this->hasOverflow.load(std::memory_order_acquire))
+				{
+					{
+						std::lock_guard<std::mutex> lock(this->overflowMutex);
+						this->overflow.swap(this->overflowProcessing);
+						this->hasOverflow.store(false, std::memory_order_release);
+					}
+					for (auto& [event, deleter] : this->overflowProcessing)
+					{
+						func(*event);
+						deleter(event);
+						consumed++;
+					}
+					this->overflowProcessing.clear();
+				}
+
+				if (consumed == consumedBefore) break;
+			}
+			return consumed;
+		}
+	};
+}
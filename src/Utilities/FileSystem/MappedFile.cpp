@@ -0,0 +1,169 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "MappedFile.h"
+#include "Utilities/Logging/Logger.h"
+#include "Core/Macro/Macro.h"
+
+#include <utility>
+
+#if defined(MXENGINE_WINDOWS)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MxEngine
+{
+    MappedFile::MappedFile(const FilePath& path)
+    {
+        this->Open(path);
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            this->Close();
+            std::swap(this->data, other.data);
+            std::swap(this->size, other.size);
+            std::swap(this->fileHandle, other.fileHandle);
+            std::swap(this->mappingHandle, other.mappingHandle);
+        }
+        return *this;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        this->Close();
+    }
+
+    bool MappedFile::Open(const FilePath& path)
+    {
+        this->Close();
+
+        #if defined(MXENGINE_WINDOWS)
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            MXLOG_WARNING("MxEngine::MappedFile", "cannot open file: " + ToMxString(path));
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            MXLOG_WARNING("MxEngine::MappedFile", "cannot map file: " + ToMxString(path));
+            CloseHandle(file);
+            return false;
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr)
+        {
+            MXLOG_WARNING("MxEngine::MappedFile", "cannot map file: " + ToMxString(path));
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+        this->fileHandle = file;
+        this->mappingHandle = mapping;
+        this->data = (const uint8_t*)view;
+        this->size = (size_t)fileSize.QuadPart;
+        #else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file == -1)
+        {
+            MXLOG_WARNING("MxEngine::MappedFile", "cannot open file: " + ToMxString(path));
+            return false;
+        }
+        struct stat fileStat;
+        if (fstat(file, &fileStat) == -1 || fileStat.st_size == 0)
+        {
+            close(file);
+            return false;
+        }
+        void* view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        // mapping keeps its own reference to the file, so descriptor is not needed anymore
+        close(file);
+        if (view == MAP_FAILED)
+        {
+            MXLOG_WARNING("MxEngine::MappedFile", "cannot map file: " + ToMxString(path));
+            return false;
+        }
+        this->data = (const uint8_t*)view;
+        this->size = (size_t)fileStat.st_size;
+        #endif
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (this->data == nullptr) return;
+
+        #if defined(MXENGINE_WINDOWS)
+        UnmapViewOfFile(this->data);
+        CloseHandle((HANDLE)this->mappingHandle);
+        CloseHandle((HANDLE)this->fileHandle);
+        #else
+        munmap((void*)this->data, this->size);
+        #endif
+
+        this->data = nullptr;
+        this->size = 0;
+        this->fileHandle = nullptr;
+        this->mappingHandle = nullptr;
+    }
+
+    bool MappedFile::IsOpen() const
+    {
+        return this->data != nullptr;
+    }
+
+    const uint8_t* MappedFile::GetData() const
+    {
+        return this->data;
+    }
+
+    size_t MappedFile::GetSize() const
+    {
+        return this->size;
+    }
+}
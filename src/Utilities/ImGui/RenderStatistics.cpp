@@ -29,6 +29,8 @@
 #include "ImGuiBase.h"
 #include "RenderStatistics.h"
 #include "Core/Application/Rendering.h"
+#include "Utilities/Memory/SmallObjectAllocator.h"
+#include "Utilities/Memory/Memory.h"
 
 namespace MxEngine::GUI
 {
@@ -40,5 +42,15 @@ namespace MxEngine::GUI
         {
             ImGui::Text("%s: %d", entry->first, int(entry->second));
         }
+
+        ImGui::Separator();
+        ImGui::Text("small object slabs: %d KB", int(SmallObjectAllocator::GetReservedBytes() / KB));
+        for (size_t i = 0; i < (size_t)MemoryTag::COUNT; i++)
+        {
+            auto tag = (MemoryTag)i;
+            auto memory = SmallObjectAllocator::GetStatistics(tag);
+            ImGui::Text("%s memory: %d KB in %d allocations (%d total)", GetMemoryTagName(tag),
+                int(memory.LiveBytes / KB), int(memory.LiveAllocations), int(memory.TotalAllocations));
+        }
     }
 }
\ No newline at end of file
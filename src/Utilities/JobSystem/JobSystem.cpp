@@ -0,0 +1,289 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "JobSystem.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Format/Format.h"
+
+namespace MxEngine
+{
+	JobQueue::JobQueue()
+	{
+		for (auto& job : this->buffer)
+			job.store(nullptr, std::memory_order_relaxed);
+	}
+
+	bool JobQueue::Push(Job* job)
+	{
+		int64_t b = this->bottom.load(std::memory_order_relaxed);
+		int64_t t = this->top.load(std::memory_order_acquire);
+		if (b - t >= Capacity) return false;
+
+		this->buffer[b & Mask].store(job, std::memory_order_relaxed);
+		this->bottom.store(b + 1, std::memory_order_release);
+		return true;
+	}
+
+	Job* JobQueue::Pop()
+	{
+		int64_t b = this->bottom.load(std::memory_order_relaxed) - 1;
+		this->bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = this->top.load(std::memory_order_relaxed);
+
+		Job* job = nullptr;
+		if (t <= b)
+		{
+			job = this->buffer[b & Mask].load(std::memory_order_relaxed);
+			if (t == b)
+			{
+				// last job in queue, race against stealing threads
+				if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					job = nullptr;
+				this->bottom.store(b + 1, std::memory_order_relaxed);
+			}
+		}
+		else
+		{
+			this->bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return job;
+	}
+
+	Job* JobQueue::Steal()
+	{
+		int64_t t = this->top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = this->bottom.load(std::memory_order_acquire);
+
+		if (t < b)
+		{
+			Job* job = this->buffer[t & Mask].load(std::memory_order_relaxed);
+			if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+			return job;
+		}
+		return nullptr;
+	}
+
+	JobSystemImpl::~JobSystemImpl()
+	{
+		this->Destroy();
+	}
+
+	void JobSystemImpl::Init(size_t workerCount)
+	{
+		if (this->isRunning.load()) return;
+
+		if (workerCount == 0)
+		{
+			size_t hardwareThreads = (size_t)std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		JobSystemImpl::threadIndex = 0;
+		this->queues.resize(workerCount + 1);
+		for (auto& queue : this->queues)
+			queue = MakeUnique<JobQueue>();
+
+		this->isRunning.store(true);
+		this->workers.reserve(workerCount);
+		for (size_t i = 1; i <= workerCount; i++)
+		{
+			this->workers.emplace_back([this, i]() { this->WorkerLoop(i); });
+		}
+		MXLOG_INFO("MxEngine::JobSystem", MxFormat("started {0} worker threads", workerCount));
+	}
+
+	void JobSystemImpl::Destroy()
+	{
+		if (!this->isRunning.load()) return;
+
+		// finish all pending work before shutting down workers
+		while (this->pendingJobs.load() > 0)
+		{
+			Job* job = this->FindJob();
+			if (job != nullptr) this->RunJob(job);
+			else std::this_thread::yield();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(this->sleepMutex);
+			this->isRunning.store(false);
+		}
+		this->wakeCondition.notify_all();
+
+		for (auto& worker : this->workers)
+		{
+			if (worker.joinable()) worker.join();
+		}
+		this->workers.clear();
+		this->queues.clear();
+	}
+
+	void JobSystemImpl::Execute(std::function<void()> func, JobCounter* counter)
+	{
+		if (counter != nullptr) counter->value.fetch_add(1, std::memory_order_relaxed);
+
+		if (!this->isRunning.load(std::memory_order_relaxed))
+		{
+			// job system is not started yet, execute job immediately
+			func();
+			if (counter != nullptr) counter->value.fetch_sub(1, std::memory_order_release);
+			return;
+		}
+
+		auto job = Alloc<Job>();
+		job->Function = std::move(func);
+		job->Counter = counter;
+		job->Tag = SmallObjectAllocator::GetCurrentTag();
+		this->Schedule(job);
+	}
+
+	void JobSystemImpl::Schedule(Job* job)
+	{
+		this->pendingJobs.fetch_add(1, std::memory_order_seq_cst);
+
+		bool pushed = false;
+		if (this->HasQueue())
+		{
+			pushed = this->queues[JobSystemImpl::threadIndex]->Push(job);
+		}
+		if (!pushed)
+		{
+			std::lock_guard<std::mutex> lock(this->externalMutex);
+			this->externalQueue.push_back(job);
+		}
+
+		if (this->sleepingWorkers.load(std::memory_order_seq_cst) > 0)
+		{
+			{ std::lock_guard<std::mutex> lock(this->sleepMutex); }
+			this->wakeCondition.notify_one();
+		}
+	}
+
+	void JobSystemImpl::RunJob(Job* job)
+	{
+		this->pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+		{
+			MemoryTagScope memoryTag(job->Tag);
+			job->Function();
+		}
+		if (job->Counter != nullptr) job->Counter->value.fetch_sub(1, std::memory_order_release);
+		Free(job);
+	}
+
+	Job* JobSystemImpl::FindJob()
+	{
+		size_t queueCount = this->queues.size();
+		size_t index = this->HasQueue() ? JobSystemImpl::threadIndex : 0;
+
+		if (this->HasQueue())
+		{
+			Job* job = this->queues[index]->Pop();
+			if (job != nullptr) return job;
+		}
+
+		if (this->pendingJobs.load(std::memory_order_relaxed) == 0) return nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock(this->externalMutex);
+			if (!this->externalQueue.empty())
+			{
+				Job* job = this->externalQueue.back();
+				this->externalQueue.pop_back();
+				return job;
+			}
+		}
+
+		for (size_t i = 1; i < queueCount; i++)
+		{
+			Job* job = this->queues[(index + i) % queueCount]->Steal();
+			if (job != nullptr) return job;
+		}
+		return nullptr;
+	}
+
+	bool JobSystemImpl::HasQueue() const
+	{
+		return JobSystemImpl::threadIndex < this->queues.size();
+	}
+
+	void JobSystemImpl::WorkerLoop(size_t index)
+	{
+		JobSystemImpl::threadIndex = index;
+		constexpr size_t SpinCount = 64;
+		size_t spins = 0;
+
+		while (this->isRunning.load(std::memory_order_relaxed))
+		{
+			Job* job = this->FindJob();
+			if (job != nullptr)
+			{
+				this->RunJob(job);
+				spins = 0;
+				continue;
+			}
+
+			if (spins++ < SpinCount)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(this->sleepMutex);
+			this->sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+			this->wakeCondition.wait(lock, [this]()
+			{
+				return this->pendingJobs.load(std::memory_order_seq_cst) > 0 || !this->isRunning.load();
+			});
+			this->sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+			spins = 0;
+		}
+	}
+
+	void JobSystemImpl::Wait(const JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			Job* job = this->FindJob();
+			if (job != nullptr) this->RunJob(job);
+			else std::this_thread::yield();
+		}
+	}
+
+	size_t JobSystemImpl::GetWorkerCount() const
+	{
+		return this->queues.empty() ? 1 : this->queues.size();
+	}
+
+	size_t JobSystemImpl::GetCurrentWorkerIndex()
+	{
+		return JobSystemImpl::threadIndex;
+	}
+}
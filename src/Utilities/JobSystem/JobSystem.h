@@ -0,0 +1,221 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+
+#include "Utilities/Memory/Memory.h"
+#include "Utilities/Memory/SmallObjectAllocator.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+	/*!
+	job counter is used to implement fork/join semantics: each job scheduled with counter increments it and decrements on completion.
+	Waiting on counter blocks until all jobs attached to it are finished
+	*/
+	class JobCounter
+	{
+		std::atomic<size_t> value{ 0 };
+
+		friend class JobSystemImpl;
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		/*!
+		checks if all jobs attached to counter are finished
+		\returns true if no pending jobs left, false otherwise
+		*/
+		bool IsDone() const { return this->value.load(std::memory_order_acquire) == 0; }
+		/*!
+		getter for number of pending jobs
+		\returns number of jobs which are not finished yet
+		*/
+		size_t GetPendingCount() const { return this->value.load(std::memory_order_acquire); }
+	};
+
+	/*!
+	job is a unit of work which can be executed by any worker thread
+	*/
+	struct Job
+	{
+		std::function<void()> Function;
+		JobCounter* Counter = nullptr;
+		MemoryTag Tag = MemoryTag::GENERAL; // memory tag of thread which scheduled job
+	};
+
+	/*!
+	work-stealing deque (Chase-Lev). Only owning thread can push and pop from the bottom, other threads are allowed only to steal from the top
+	*/
+	class JobQueue
+	{
+		static constexpr int64_t Capacity = 4096;
+		static constexpr int64_t Mask = Capacity - 1;
+
+		alignas(64) std::atomic<int64_t> top{ 0 };
+		alignas(64) std::atomic<int64_t> bottom{ 0 };
+		std::atomic<Job*> buffer[Capacity];
+	public:
+		JobQueue();
+
+		/*!
+		pushes job to the bottom of the queue. Can be called only by owning thread
+		\param job job to push
+		\returns false if queue is full, true otherwise
+		*/
+		bool Push(Job* job);
+		/*!
+		pops job from the bottom of the queue. Can be called only by owning thread
+		\returns job or nullptr if queue is empty
+		*/
+		Job* Pop();
+		/*!
+		steals job from the top of the queue. Can be called from any thread
+		\returns job or nullptr if queue is empty or other thread won the race
+		*/
+		Job* Steal();
+	};
+
+	/*!
+	job system manages pool of worker threads, each having its own work-stealing queue. Thread which initialized job system
+	is treated as worker with index 0 and can execute jobs while waiting on counters
+	*/
+	class JobSystemImpl
+	{
+		MxVector<UniqueRef<JobQueue>> queues;
+		MxVector<std::thread> workers;
+		MxVector<Job*> externalQueue;
+		std::mutex externalMutex;
+		std::mutex sleepMutex;
+		std::condition_variable wakeCondition;
+		std::atomic<size_t> pendingJobs{ 0 };
+		std::atomic<size_t> sleepingWorkers{ 0 };
+		std::atomic<bool> isRunning{ false };
+
+		inline static thread_local size_t threadIndex = std::numeric_limits<size_t>::max();
+
+		void WorkerLoop(size_t index);
+		void Schedule(Job* job);
+		void RunJob(Job* job);
+		Job* FindJob();
+		bool HasQueue() const;
+	public:
+		JobSystemImpl() = default;
+		JobSystemImpl(const JobSystemImpl&) = delete;
+		JobSystemImpl& operator=(const JobSystemImpl&) = delete;
+		~JobSystemImpl();
+
+		/*!
+		starts worker threads. Calling thread becomes worker with index 0
+		\param workerCount number of additional worker threads. If zero, hardware concurrency - 1 is used
+		*/
+		void Init(size_t workerCount);
+		/*!
+		stops and joins all worker threads. All pending jobs are executed before return
+		*/
+		void Destroy();
+		/*!
+		schedules job for execution
+		\param func functor to invoke
+		\param counter optional counter which is incremented now and decremented when job is finished
+		*/
+		void Execute(std::function<void()> func, JobCounter* counter = nullptr);
+		/*!
+		blocks until all jobs attached to counter are finished. Calling thread executes pending jobs while waiting
+		\param counter counter to wait on
+		*/
+		void Wait(const JobCounter& counter);
+		/*!
+		getter for total thread count which execute jobs (including thread which initialized job system)
+		\returns worker count
+		*/
+		size_t GetWorkerCount() const;
+		/*!
+		getter for index of worker which executes current code
+		\returns worker index or max size_t value if current thread is not part of job system
+		*/
+		static size_t GetCurrentWorkerIndex();
+
+		/*!
+		splits range [0, count) into chunks and invokes functor for each chunk in parallel. Blocks until all chunks are processed
+		\param count number of elements in range
+		\param grainSize minimal number of elements processed by one job
+		\param func functor with signature `void(size_t begin, size_t end)`
+		*/
+		template<typename F>
+		void ParallelForRange(size_t count, size_t grainSize, F&& func)
+		{
+			if (count == 0) return;
+			grainSize = grainSize == 0 ? 1 : grainSize;
+
+			size_t jobCount = this->GetWorkerCount() * 4;
+			size_t chunkSize = (count + jobCount - 1) / jobCount;
+			chunkSize = chunkSize < grainSize ? grainSize : chunkSize;
+
+			if (chunkSize >= count || !this->isRunning.load(std::memory_order_relaxed))
+			{
+				func(size_t(0), count);
+				return;
+			}
+
+			JobCounter counter;
+			size_t begin = chunkSize; // first chunk is processed by calling thread
+			for (; begin < count; begin += chunkSize)
+			{
+				size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+				this->Execute([&func, begin, end]() { func(begin, end); }, &counter);
+			}
+			func(size_t(0), chunkSize);
+			this->Wait(counter);
+		}
+
+		/*!
+		invokes functor for each index in range [0, count) in parallel. Blocks until all indicies are processed
+		\param count number of elements in range
+		\param grainSize minimal number of elements processed by one job
+		\param func functor with signature `void(size_t index)`
+		*/
+		template<typename F>
+		void ParallelFor(size_t count, size_t grainSize, F&& func)
+		{
+			this->ParallelForRange(count, grainSize, [&func](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+					func(i);
+			});
+		}
+	};
+}
@@ -36,6 +36,11 @@
 #include <cmath>
 #include <array>
 #include <algorithm>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace MxEngine
 {
@@ -159,6 +164,14 @@ namespace MxEngine
 		return glm::yawPitchRoll(angles.y, angles.x, angles.z);
 	}
 
+	inline Quaternion MakeRotationQuaternion(const Vector3& angles)
+	{
+		// same order as MakeRotationMatrix: yaw * pitch * roll
+		return glm::angleAxis(angles.y, Vector3(0.0f, 1.0f, 0.0f)) *
+			glm::angleAxis(angles.x, Vector3(1.0f, 0.0f, 0.0f)) *
+			glm::angleAxis(angles.z, Vector3(0.0f, 0.0f, 1.0f));
+	}
+
 	template<typename T>
 	inline T Normalize(const T& value)
 	{
@@ -214,7 +227,10 @@ namespace MxEngine
 
 	inline Vector3 MakeEulerAngles(const Quaternion& q)
 	{
-		return glm::eulerAngles(q);
+		// inverse of MakeRotationQuaternion and MakeRotationMatrix, so angles must be extracted in the same yaw * pitch * roll order
+		Vector3 angles;
+		glm::extractEulerAngleYXZ(ToMatrix(q), angles.y, angles.x, angles.z);
+		return angles;
 	}
 
 	inline Quaternion Lerp(const Quaternion& q1, const Quaternion& q2, float a)
@@ -729,4 +745,36 @@ namespace MxEngine
 		}
 		return ret;
 	}
+
+	/*!
+	counts number of zero bits before first set bit, starting from the least significant one
+	\param value 64-bit integer value (must not be zero)
+	\returns index of least significant set bit
+	*/
+	inline size_t CountTrailingZeros(uint64_t value)
+	{
+		#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanForward64(&index, value);
+		return (size_t)index;
+		#else
+		return (size_t)__builtin_ctzll(value);
+		#endif
+	}
+
+	/*!
+	counts number of zero bits before first set bit, starting from the most significant one
+	\param value 64-bit integer value (must not be zero)
+	\returns 63 minus index of most significant set bit
+	*/
+	inline size_t CountLeadingZeros(uint64_t value)
+	{
+		#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanReverse64(&index, value);
+		return 63 - (size_t)index;
+		#else
+		return (size_t)__builtin_clzll(value);
+		#endif
+	}
 }
\ No newline at end of file
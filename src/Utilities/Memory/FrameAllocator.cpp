@@ -0,0 +1,144 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "FrameAllocator.h"
+#include "Utilities/Math/Math.h"
+
+namespace MxEngine
+{
+    FrameArena::FrameArena(size_t bytesPerFrame)
+    {
+        for (auto& buffer : this->buffers)
+        {
+            this->ResetBuffer(buffer, bytesPerFrame);
+        }
+    }
+
+    void FrameArena::ResetBuffer(Buffer& buffer, size_t requiredBytes)
+    {
+        if (buffer.Memory.size() < requiredBytes)
+        {
+            // buffer is not used now, so it can be safely reallocated
+            buffer.Memory = MxVector<uint8_t>(requiredBytes + requiredBytes / 2);
+        }
+        buffer.Overflow.clear();
+        buffer.OverflowBytes = 0;
+        buffer.Allocator.Init(buffer.Memory.data(), buffer.Memory.size());
+    }
+
+    void* FrameArena::Allocate(size_t bytes, size_t align)
+    {
+        auto& buffer = this->buffers[this->current];
+        align = align == 0 ? 1 : align;
+
+        if (buffer.Allocator.CanAllocate(bytes, align))
+            return buffer.Allocator.RawAlloc(bytes, align);
+
+        // buffer is full, take memory from heap until the end of frame
+        auto& overflow = buffer.Overflow.emplace_back(bytes + align);
+        buffer.OverflowBytes += bytes;
+        uintptr_t address = reinterpret_cast<uintptr_t>(overflow.data());
+        address = (address + align - 1) & ~(uintptr_t)(align - 1);
+        return reinterpret_cast<void*>(address);
+    }
+
+    void FrameArena::NextFrame()
+    {
+        size_t usedBytes = this->GetUsedBytes();
+        this->peakBytes = Max(this->peakBytes, usedBytes);
+
+        this->current = (this->current + 1) % this->buffers.size();
+        this->ResetBuffer(this->buffers[this->current], usedBytes);
+    }
+
+    size_t FrameArena::GetUsedBytes() const
+    {
+        const auto& buffer = this->buffers[this->current];
+        return buffer.Allocator.GetUsedBytes() + buffer.OverflowBytes;
+    }
+
+    size_t FrameArena::GetPeakBytes() const
+    {
+        return Max(this->peakBytes, this->GetUsedBytes());
+    }
+
+    size_t FrameArena::GetOverflowBytes() const
+    {
+        return this->buffers[this->current].OverflowBytes;
+    }
+
+    size_t FrameArena::GetCapacity() const
+    {
+        return this->buffers[this->current].Allocator.GetCapacity();
+    }
+
+    FrameAllocator::FrameAllocator(const char* name)
+        : name(name) { }
+
+    FrameAllocator::FrameAllocator(FrameArena* arena, const char* name)
+        : arena(arena), name(name) { }
+
+    FrameAllocator::FrameAllocator(const FrameAllocator& other, const char* name)
+        : arena(other.arena), name(name) { }
+
+    void* FrameAllocator::allocate(size_t n, int flags)
+    {
+        if (this->arena == nullptr)
+            return EASTLAllocatorType{ this->name }.allocate(n, flags);
+        return this->arena->Allocate(n);
+    }
+
+    void* FrameAllocator::allocate(size_t n, size_t alignment, size_t offset, int flags)
+    {
+        if (this->arena == nullptr || offset != 0)
+            return EASTLAllocatorType{ this->name }.allocate(n, alignment, offset, flags);
+        return this->arena->Allocate(n, alignment);
+    }
+
+    void FrameAllocator::deallocate(void* p, size_t n)
+    {
+        // memory from arena is freed all at once when arena switches frame
+        if (this->arena == nullptr)
+            EASTLAllocatorType{ this->name }.deallocate(p, n);
+    }
+
+    const char* FrameAllocator::get_name() const
+    {
+        return this->name;
+    }
+
+    void FrameAllocator::set_name(const char* name)
+    {
+        this->name = name;
+    }
+
+    FrameArena* FrameAllocator::GetArena() const
+    {
+        return this->arena;
+    }
+}
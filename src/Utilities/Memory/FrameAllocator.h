@@ -0,0 +1,149 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "Utilities/Memory/Memory.h"
+#include "Utilities/Memory/LinearAllocator.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+    /*!
+    frame arena is a double-buffered linear allocator for data which lives no longer than one frame. Allocation is a pointer bump,
+    deallocation is a no-op. When NextFrame() is called, arena switches to other buffer and resets it, so data allocated
+    during previous frame is still valid until next switch. If buffer has not enough space, memory is taken from heap and
+    buffer is enlarged on its next reset, so after few frames all allocations fit into buffers
+    */
+    class FrameArena
+    {
+        struct Buffer
+        {
+            MxVector<uint8_t> Memory;
+            MxVector<MxVector<uint8_t>> Overflow;
+            LinearAllocator Allocator;
+            size_t OverflowBytes = 0;
+        };
+
+        std::array<Buffer, 2> buffers;
+        size_t current = 0;
+        size_t peakBytes = 0;
+
+        void ResetBuffer(Buffer& buffer, size_t requiredBytes);
+    public:
+        /*!
+        creates frame arena
+        \param bytesPerFrame initial size of each of two buffers
+        */
+        explicit FrameArena(size_t bytesPerFrame = 1 * MB);
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        /*!
+        allocates raw memory which is valid until second NextFrame() call
+        \param bytes size of memory block
+        \param align alignment of memory block (must be power of 2)
+        \returns pointer to memory block
+        */
+        [[nodiscard]] void* Allocate(size_t bytes, size_t align = alignof(std::max_align_t));
+        /*!
+        switches arena to next frame, freeing all memory allocated two frames ago
+        */
+        void NextFrame();
+        /*!
+        getter for memory used by current frame
+        \returns number of bytes allocated since last NextFrame() call
+        */
+        size_t GetUsedBytes() const;
+        /*!
+        getter for maximal memory usage
+        \returns maximal number of bytes allocated during one frame
+        */
+        size_t GetPeakBytes() const;
+        /*!
+        getter for memory which did not fit into buffer during current frame
+        \returns number of bytes allocated from heap since last NextFrame() call
+        */
+        size_t GetOverflowBytes() const;
+        /*!
+        getter for size of current buffer
+        \returns number of bytes which can be allocated without heap fallback
+        */
+        size_t GetCapacity() const;
+    };
+
+    /*!
+    EASTL-compatible allocator which takes memory from frame arena. If no arena is set, default EASTL allocator is used.
+    Containers with this allocator must drop their storage (clear() and reset_lose_memory()) before arena buffer is reset
+    */
+    class FrameAllocator
+    {
+        FrameArena* arena = nullptr;
+        const char* name = "FrameAllocator";
+    public:
+        FrameAllocator(const char* name = "FrameAllocator");
+        FrameAllocator(FrameArena* arena, const char* name = "FrameAllocator");
+        FrameAllocator(const FrameAllocator& other) = default;
+        FrameAllocator(const FrameAllocator& other, const char* name);
+        FrameAllocator& operator=(const FrameAllocator& other) = default;
+
+        void* allocate(size_t n, int flags = 0);
+        void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0);
+        void deallocate(void* p, size_t n);
+
+        const char* get_name() const;
+        void set_name(const char* name);
+
+        FrameArena* GetArena() const;
+
+        friend bool operator==(const FrameAllocator& a, const FrameAllocator& b) { return a.arena == b.arena; }
+        friend bool operator!=(const FrameAllocator& a, const FrameAllocator& b) { return a.arena != b.arena; }
+    };
+
+    template<typename T>
+    using FrameVector = MxVector<T, FrameAllocator>;
+
+    /*!
+    drops storage of container and makes it allocate from frame arena
+    \param container container to reset (all elements are destroyed)
+    \param arena arena to allocate from
+    */
+    template<typename Container>
+    void ResetFrameContainer(Container& container, FrameArena& arena)
+    {
+        container.clear();
+        if (container.get_allocator().GetArena() != nullptr)
+            container.reset_lose_memory(); // memory is owned by arena
+        else
+            container.shrink_to_fit();
+        container.set_allocator(FrameAllocator{ &arena, container.get_allocator().get_name() });
+    }
+}
@@ -123,6 +123,45 @@ namespace MxEngine
             return this->base;
         }
 
+        /*!
+        gets number of bytes used by allocations (including alignment padding)
+        \returns bytes between begin of memory chunk and its top
+        */
+        size_t GetUsedBytes() const
+        {
+            return static_cast<size_t>(this->top - this->base);
+        }
+
+        /*!
+        gets size of memory chunk
+        \returns total size in bytes of memory chunk
+        */
+        size_t GetCapacity() const
+        {
+            return this->size;
+        }
+
+        /*!
+        checks if memory chunk has enough space for allocation
+        \param bytes requested block size
+        \param align alignment of block
+        \returns true if RawAlloc() with same parameters succeeds, false otherwise
+        */
+        bool CanAllocate(size_t bytes, size_t align = 1)
+        {
+            if (this->base == nullptr) return false;
+            DataPointer aligned = AlignPointer(this->top, align);
+            return aligned + bytes <= this->base + this->size;
+        }
+
+        /*!
+        frees all allocated memory at once. Destructors of allocated objects are not called
+        */
+        void Reset()
+        {
+            this->top = this->base;
+        }
+
         /*!
         returns pointer to raw allocated memory
         \param bytes minimal requested block size
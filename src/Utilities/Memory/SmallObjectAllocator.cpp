@@ -0,0 +1,451 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "SmallObjectAllocator.h"
+#include "Utilities/Memory/Memory.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace MxEngine
+{
+    namespace
+    {
+        constexpr std::array<size_t, 14> SizeClasses = { 16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048 };
+        constexpr size_t LargeSizeClass = SizeClasses.size();
+        constexpr size_t MaxSmallBlock = SizeClasses.back();
+        constexpr size_t Granularity = 16;
+        constexpr size_t HeaderSize = 16;
+        constexpr size_t SlabSize = 64 * KB;
+        constexpr size_t TagCount = (size_t)MemoryTag::COUNT;
+
+        constexpr auto MakeSizeClassTable()
+        {
+            std::array<uint8_t, MaxSmallBlock / Granularity + 1> table{ };
+            size_t sizeClass = 0;
+            for (size_t i = 0; i < table.size(); i++)
+            {
+                while (SizeClasses[sizeClass] < i * Granularity) sizeClass++;
+                table[i] = (uint8_t)sizeClass;
+            }
+            return table;
+        }
+
+        /*!
+        maps block size rounded up to granularity to the smallest size class which fits it
+        */
+        constexpr auto SizeClassTable = MakeSizeClassTable();
+
+        /*!
+        header is placed right before each returned pointer. For small blocks it points to thread cache which owns block,
+        for large blocks it points to memory returned by malloc
+        */
+        struct BlockHeader
+        {
+            void* Owner;
+            uint32_t SizeClass;
+            uint32_t Tag;
+        };
+        static_assert(sizeof(BlockHeader) <= HeaderSize, "block header must fit into reserved space");
+
+        struct FreeBlock
+        {
+            FreeBlock* Next;
+        };
+
+        struct TagCounters
+        {
+            std::atomic<int64_t> LiveBytes{ 0 };
+            std::atomic<int64_t> LiveAllocations{ 0 };
+            std::atomic<uint64_t> TotalAllocations{ 0 };
+        };
+
+        struct ThreadCache
+        {
+            struct Bin
+            {
+                FreeBlock* LocalFree = nullptr;
+                std::atomic<FreeBlock*> RemoteFree{ nullptr };
+                uint8_t* SlabCursor = nullptr;
+                uint8_t* SlabEnd = nullptr;
+            };
+
+            std::array<Bin, SizeClasses.size()> Bins;
+            std::array<TagCounters, TagCount> Counters;
+            ThreadCache* NextCache = nullptr;
+            ThreadCache* NextOrphan = nullptr;
+        };
+
+        // all state is constant-initialized, as allocator can be used during static initialization of other translation units
+        std::atomic<ThreadCache*> AllCaches{ nullptr };
+        std::atomic<size_t> ReservedBytes{ 0 };
+        std::atomic_flag OrphanLock = ATOMIC_FLAG_INIT;
+        ThreadCache* Orphans = nullptr;
+        std::array<TagCounters, TagCount> DetachedCounters;
+
+        thread_local ThreadCache* CurrentCache = nullptr;
+        thread_local bool IsCacheReleased = false;
+        thread_local MemoryTag CurrentTag = MemoryTag::GENERAL;
+
+        void LockOrphans()
+        {
+            while (OrphanLock.test_and_set(std::memory_order_acquire)) { }
+        }
+
+        void UnlockOrphans()
+        {
+            OrphanLock.clear(std::memory_order_release);
+        }
+
+        /*!
+        caches are never freed, as their blocks may still be used by other threads. When thread exits,
+        its cache is orphaned and later adopted by the next thread which allocates memory
+        */
+        struct ThreadCacheOwner
+        {
+            ~ThreadCacheOwner()
+            {
+                if (CurrentCache != nullptr)
+                {
+                    LockOrphans();
+                    CurrentCache->NextOrphan = Orphans;
+                    Orphans = CurrentCache;
+                    UnlockOrphans();
+                }
+                CurrentCache = nullptr;
+                IsCacheReleased = true;
+            }
+        };
+
+        ThreadCache* AcquireCache()
+        {
+            if (CurrentCache != nullptr) return CurrentCache;
+            if (IsCacheReleased) return nullptr; // thread is exiting, its cache is already given away
+
+            thread_local ThreadCacheOwner owner;
+            (void)owner;
+
+            LockOrphans();
+            ThreadCache* cache = Orphans;
+            if (cache != nullptr) Orphans = cache->NextOrphan;
+            UnlockOrphans();
+
+            if (cache == nullptr)
+            {
+                void* memory = std::malloc(sizeof(ThreadCache));
+                if (memory == nullptr) return nullptr;
+                cache = new(memory) ThreadCache();
+
+                ThreadCache* head = AllCaches.load(std::memory_order_relaxed);
+                do { cache->NextCache = head; }
+                while (!AllCaches.compare_exchange_weak(head, cache, std::memory_order_release, std::memory_order_relaxed));
+            }
+            CurrentCache = cache;
+            return cache;
+        }
+
+        TagCounters& GetCounters(ThreadCache* cache, size_t tag)
+        {
+            return cache != nullptr ? cache->Counters[tag] : DetachedCounters[tag];
+        }
+
+        void* AllocateSmallBlock(ThreadCache& cache, size_t sizeClass)
+        {
+            auto& bin = cache.Bins[sizeClass];
+            if (bin.LocalFree == nullptr)
+                bin.LocalFree = bin.RemoteFree.exchange(nullptr, std::memory_order_acquire);
+
+            if (bin.LocalFree != nullptr)
+            {
+                FreeBlock* block = bin.LocalFree;
+                bin.LocalFree = block->Next;
+                return block;
+            }
+
+            size_t blockSize = SizeClasses[sizeClass];
+            if ((size_t)(bin.SlabEnd - bin.SlabCursor) < blockSize)
+            {
+                // tail of previous slab is lost, but it is always smaller than one block
+                auto slab = static_cast<uint8_t*>(std::malloc(SlabSize));
+                if (slab == nullptr) return nullptr;
+                ReservedBytes.fetch_add(SlabSize, std::memory_order_relaxed);
+                bin.SlabCursor = slab;
+                bin.SlabEnd = slab + SlabSize;
+            }
+            void* block = bin.SlabCursor;
+            bin.SlabCursor += blockSize;
+            return block;
+        }
+    }
+
+    const char* GetMemoryTagName(MemoryTag tag)
+    {
+        switch (tag)
+        {
+        case MemoryTag::GENERAL:
+            return "general";
+        case MemoryTag::RENDER:
+            return "render";
+        case MemoryTag::PHYSICS:
+            return "physics";
+        case MemoryTag::ASSETS:
+            return "assets";
+        case MemoryTag::EDITOR:
+            return "editor";
+        default:
+            return "unknown";
+        }
+    }
+
+    void* SmallObjectAllocator::Allocate(size_t bytes, size_t alignment, size_t offset)
+    {
+        ThreadCache* cache = AcquireCache();
+        size_t tag = (size_t)CurrentTag;
+        alignment = alignment == 0 ? 1 : alignment;
+        size_t blockSize = bytes + HeaderSize;
+
+        BlockHeader header;
+        header.Tag = (uint32_t)tag;
+        uint8_t* result = nullptr;
+
+        // small blocks are 16-byte aligned, more strict alignment is handled by large allocation path
+        bool isSmall = cache != nullptr && blockSize <= MaxSmallBlock && alignment <= Granularity && offset % alignment == 0;
+        if (isSmall)
+        {
+            header.SizeClass = SizeClassTable[(blockSize + Granularity - 1) / Granularity];
+            header.Owner = cache;
+            auto block = static_cast<uint8_t*>(AllocateSmallBlock(*cache, header.SizeClass));
+            if (block == nullptr) return nullptr;
+            result = block + HeaderSize;
+        }
+        else
+        {
+            alignment = alignment < Granularity ? Granularity : alignment;
+            auto base = static_cast<uint8_t*>(std::malloc(bytes + HeaderSize + offset + alignment));
+            if (base == nullptr) return nullptr;
+
+            uintptr_t address = reinterpret_cast<uintptr_t>(base) + HeaderSize + offset;
+            address = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            header.SizeClass = (uint32_t)LargeSizeClass;
+            header.Owner = base;
+            result = reinterpret_cast<uint8_t*>(address - offset);
+        }
+        // header may be unaligned if user requested odd offset
+        std::memcpy(result - HeaderSize, &header, sizeof(header));
+
+        auto& counters = GetCounters(cache, tag);
+        counters.LiveBytes.fetch_add((int64_t)bytes, std::memory_order_relaxed);
+        counters.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+        return result;
+    }
+
+    void SmallObjectAllocator::Deallocate(void* ptr, size_t bytes)
+    {
+        if (ptr == nullptr) return;
+
+        auto data = static_cast<uint8_t*>(ptr);
+        BlockHeader header;
+        std::memcpy(&header, data - HeaderSize, sizeof(header));
+
+        ThreadCache* cache = AcquireCache();
+        auto& counters = GetCounters(cache, header.Tag);
+        counters.LiveBytes.fetch_sub((int64_t)bytes, std::memory_order_relaxed);
+        counters.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+
+        if (header.SizeClass == LargeSizeClass)
+        {
+            std::free(header.Owner);
+            return;
+        }
+
+        auto owner = static_cast<ThreadCache*>(header.Owner);
+        auto& bin = owner->Bins[header.SizeClass];
+        auto block = reinterpret_cast<FreeBlock*>(data - HeaderSize);
+        if (owner == cache)
+        {
+            block->Next = bin.LocalFree;
+            bin.LocalFree = block;
+        }
+        else
+        {
+            // block belongs to other thread, return it through lock-free stack
+            FreeBlock* head = bin.RemoteFree.load(std::memory_order_relaxed);
+            do { block->Next = head; }
+            while (!bin.RemoteFree.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+        }
+    }
+
+    MemoryTagStatistics SmallObjectAllocator::GetStatistics(MemoryTag tag)
+    {
+        size_t index = (size_t)tag;
+        int64_t liveBytes = 0, liveAllocations = 0;
+        uint64_t totalAllocations = 0;
+
+        auto accumulate = [&](const TagCounters& counters)
+        {
+            liveBytes += counters.LiveBytes.load(std::memory_order_relaxed);
+            liveAllocations += counters.LiveAllocations.load(std::memory_order_relaxed);
+            totalAllocations += counters.TotalAllocations.load(std::memory_order_relaxed);
+        };
+
+        // counters of one cache can be negative if its blocks were freed by other threads, but their sum is not
+        for (ThreadCache* cache = AllCaches.load(std::memory_order_acquire); cache != nullptr; cache = cache->NextCache)
+            accumulate(cache->Counters[index]);
+        accumulate(DetachedCounters[index]);
+
+        MemoryTagStatistics statistics;
+        statistics.LiveBytes = liveBytes > 0 ? (size_t)liveBytes : 0;
+        statistics.LiveAllocations = liveAllocations > 0 ? (size_t)liveAllocations : 0;
+        statistics.TotalAllocations = (size_t)totalAllocations;
+        return statistics;
+    }
+
+    size_t SmallObjectAllocator::GetReservedBytes()
+    {
+        return ReservedBytes.load(std::memory_order_relaxed);
+    }
+
+    MemoryTag SmallObjectAllocator::GetCurrentTag()
+    {
+        return CurrentTag;
+    }
+
+    MemoryTag SmallObjectAllocator::SetCurrentTag(MemoryTag tag)
+    {
+        MemoryTag previous = CurrentTag;
+        CurrentTag = tag;
+        return previous;
+    }
+
+    MemoryTagScope::MemoryTagScope(MemoryTag tag)
+        : previous(SmallObjectAllocator::SetCurrentTag(tag)) { }
+
+    MemoryTagScope::~MemoryTagScope()
+    {
+        SmallObjectAllocator::SetCurrentTag(this->previous);
+    }
+}
+
+#if defined(MXENGINE_USE_SMALL_OBJECT_ALLOCATOR)
+#include <EASTL/allocator.h>
+
+// default EASTL allocator implementation is disabled by EASTL_USER_DEFINED_ALLOCATOR, so engine provides its own
+namespace eastl
+{
+    allocator::allocator(const char* EASTL_NAME(pName))
+    {
+        #if EASTL_NAME_ENABLED
+        this->mpName = pName ? pName : EASTL_ALLOCATOR_DEFAULT_NAME;
+        #endif
+    }
+
+    allocator::allocator(const allocator& EASTL_NAME(other))
+    {
+        #if EASTL_NAME_ENABLED
+        this->mpName = other.mpName;
+        #endif
+    }
+
+    allocator::allocator(const allocator&, const char* EASTL_NAME(pName))
+    {
+        #if EASTL_NAME_ENABLED
+        this->mpName = pName ? pName : EASTL_ALLOCATOR_DEFAULT_NAME;
+        #endif
+    }
+
+    allocator& allocator::operator=(const allocator& EASTL_NAME(other))
+    {
+        #if EASTL_NAME_ENABLED
+        this->mpName = other.mpName;
+        #endif
+        return *this;
+    }
+
+    const char* allocator::get_name() const
+    {
+        #if EASTL_NAME_ENABLED
+        return this->mpName;
+        #else
+        return EASTL_ALLOCATOR_DEFAULT_NAME;
+        #endif
+    }
+
+    void allocator::set_name(const char* EASTL_NAME(pName))
+    {
+        #if EASTL_NAME_ENABLED
+        this->mpName = pName;
+        #endif
+    }
+
+    void* allocator::allocate(size_t n, int)
+    {
+        return MxEngine::SmallObjectAllocator::Allocate(n);
+    }
+
+    void* allocator::allocate(size_t n, size_t alignment, size_t offset, int)
+    {
+        return MxEngine::SmallObjectAllocator::Allocate(n, alignment, offset);
+    }
+
+    void allocator::deallocate(void* p, size_t n)
+    {
+        MxEngine::SmallObjectAllocator::Deallocate(p, n);
+    }
+
+    bool operator==(const allocator&, const allocator&)
+    {
+        return true; // all allocators share the same thread caches
+    }
+
+    #if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+    bool operator!=(const allocator&, const allocator&)
+    {
+        return false;
+    }
+    #endif
+
+    allocator gDefaultAllocator;
+    allocator* gpDefaultAllocator = &gDefaultAllocator;
+
+    allocator* GetDefaultAllocator()
+    {
+        return gpDefaultAllocator;
+    }
+
+    allocator* SetDefaultAllocator(allocator* pAllocator)
+    {
+        allocator* previous = gpDefaultAllocator;
+        gpDefaultAllocator = pAllocator;
+        return previous;
+    }
+}
+#endif
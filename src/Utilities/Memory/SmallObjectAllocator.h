@@ -0,0 +1,123 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MxEngine
+{
+    /*!
+    memory tags are used to attribute heap allocations of engine containers to engine subsystems.
+    Each thread has its current tag, which is changed by MemoryTagScope
+    */
+    enum class MemoryTag : uint8_t
+    {
+        GENERAL,
+        RENDER,
+        PHYSICS,
+        ASSETS,
+        EDITOR,
+        COUNT,
+    };
+
+    /*!
+    getter for human-readable name of memory tag
+    \param tag memory tag
+    \returns null-terminated tag name
+    */
+    const char* GetMemoryTagName(MemoryTag tag);
+
+    struct MemoryTagStatistics
+    {
+        size_t LiveBytes = 0;
+        size_t LiveAllocations = 0;
+        size_t TotalAllocations = 0;
+    };
+
+    /*!
+    small object allocator is a size-class based allocator with thread-local caches. Each thread owns slabs for every size class
+    and allocates from them without locks. Block freed by other thread is pushed to lock-free remote free list of its owner and
+    is reused by owner when its local free list is empty. Allocations which do not fit into largest size class go directly to malloc.
+    When MXENGINE_USE_SMALL_OBJECT_ALLOCATOR is defined, this allocator is used by default EASTL allocator (all MxVector, MxString, etc.)
+    */
+    class SmallObjectAllocator
+    {
+    public:
+        /*!
+        allocates memory block and attributes it to current thread memory tag
+        \param bytes size of memory block
+        \param alignment alignment of memory block (must be power of 2)
+        \param offset offset in bytes from returned pointer which should be aligned
+        \returns pointer to memory block or nullptr if system is out of memory
+        */
+        static void* Allocate(size_t bytes, size_t alignment = 16, size_t offset = 0);
+        /*!
+        frees memory block. Can be called from any thread, not only from one which allocated block
+        \param ptr pointer returned by Allocate() or nullptr
+        \param bytes size which was passed to Allocate()
+        */
+        static void Deallocate(void* ptr, size_t bytes);
+        /*!
+        getter for allocation statistics of memory tag, summed over all threads
+        \param tag memory tag
+        \returns live bytes, live allocations and total allocations made with tag
+        */
+        static MemoryTagStatistics GetStatistics(MemoryTag tag);
+        /*!
+        getter for memory taken from system for slabs of small blocks
+        \returns number of bytes in all slabs of all threads
+        */
+        static size_t GetReservedBytes();
+        /*!
+        getter for current memory tag of calling thread
+        \returns tag which new allocations are attributed to
+        */
+        static MemoryTag GetCurrentTag();
+        /*!
+        sets current memory tag of calling thread
+        \param tag tag which new allocations will be attributed to
+        \returns previous memory tag
+        */
+        static MemoryTag SetCurrentTag(MemoryTag tag);
+    };
+
+    /*!
+    RAII guard which attributes all allocations of calling thread to memory tag until the end of scope
+    */
+    class MemoryTagScope
+    {
+        MemoryTag previous;
+    public:
+        explicit MemoryTagScope(MemoryTag tag);
+        MemoryTagScope(const MemoryTagScope&) = delete;
+        MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+        ~MemoryTagScope();
+    };
+}
@@ -0,0 +1,188 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "AssetCooker.h"
+#include "ObjectSaver.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Json/Json.h"
+#include "Core/Resources/Mesh.h"
+#include "Core/Components/Rendering/MeshRenderer.h"
+
+#include <cstring>
+
+namespace MxEngine
+{
+	FilePath AssetCooker::GetManifestPath(const FilePath& source)
+	{
+		return source.native() + FilePath(".mx_cooked").native();
+	}
+
+	bool AssetCooker::LoadManifest(const FilePath& source, CookedAssetManifest& manifest)
+	{
+		auto manifestPath = AssetCooker::GetManifestPath(source);
+		if (!File::Exists(manifestPath)) return false;
+
+		File file(manifestPath);
+		if (!file.IsOpen()) return false;
+
+		auto json = LoadJson(file);
+		if (!json.is_object()) return false;
+
+		manifest.Version         = json.value("Version",         uint32_t(0));
+		manifest.SourceHash      = json.value("SourceHash",      uint64_t(0));
+		manifest.SourceSize      = json.value("SourceSize",      uint64_t(0));
+		manifest.SourceWriteTime = json.value("SourceWriteTime", int64_t(0));
+
+		manifest.Outputs.clear();
+		for (const auto& output : json["Outputs"])
+			manifest.Outputs.push_back(output.get<FilePath>());
+		return true;
+	}
+
+	void AssetCooker::SaveManifest(const FilePath& source, const CookedAssetManifest& manifest)
+	{
+		JsonFile json;
+		json["Version"]         = manifest.Version;
+		json["SourceHash"]      = manifest.SourceHash;
+		json["SourceSize"]      = manifest.SourceSize;
+		json["SourceWriteTime"] = manifest.SourceWriteTime;
+		json["Outputs"]         = JsonFile::array();
+		for (const auto& output : manifest.Outputs)
+			json["Outputs"].push_back(output);
+
+		File file(AssetCooker::GetManifestPath(source), File::WRITE);
+		SaveJson(file, json);
+	}
+
+	bool AssetCooker::IsUpToDate(const FilePath& source, CookedAssetManifest& manifest)
+	{
+		if (manifest.Version != CookedAssetManifest::CurrentVersion)
+			return false;
+
+		for (const auto& output : manifest.Outputs)
+		{
+			if (!File::Exists(output)) return false;
+		}
+
+		uint64_t size = 0;
+		int64_t writeTime = 0;
+		if (!AssetCooker::GetSourceStamp(source, size, writeTime) || size != manifest.SourceSize)
+			return false;
+
+		// write time may change without content change, for example after checkout from version control
+		if (writeTime == manifest.SourceWriteTime) return true;
+		if (AssetCooker::HashFileContents(source) != manifest.SourceHash) return false;
+
+		manifest.SourceWriteTime = writeTime;
+		return true;
+	}
+
+	bool AssetCooker::CookMesh(const FilePath& source, MeshImportData& result)
+	{
+		MAKE_SCOPE_PROFILER("AssetCooker::CookMesh");
+		MAKE_SCOPE_TIMER("MxEngine::AssetCooker", "AssetCooker::CookMesh");
+
+		CookedAssetManifest manifest;
+		if (!AssetCooker::GetSourceStamp(source, manifest.SourceSize, manifest.SourceWriteTime))
+		{
+			MXLOG_ERROR("MxEngine::AssetCooker", "file does not exist: " + ToMxString(source));
+			return false;
+		}
+		MXLOG_INFO("MxEngine::AssetCooker", "cooking object: " + ToMxString(source));
+
+		bool allowFileWrites = true;
+		ObjectInfo object = ObjectLoader::Load(source, allowFileWrites);
+		if (object.meshes.empty()) return false;
+
+		ObjectLoader::MergeMeshes(object, result);
+		manifest.SourceHash = AssetCooker::HashFileContents(source);
+
+		FilePath materialLibPath = source.native() + MeshRenderer::GetMaterialFileExtenstion().native();
+		FilePath cachePath = source.native() + Mesh::GetCacheFileExtension().native();
+		ObjectLoader::DumpMaterials(object.materials, materialLibPath);
+		ObjectSaver::SaveMeshCache(cachePath, manifest.SourceHash, result.SubMeshes, result.Vertecies, result.Indicies);
+
+		manifest.Outputs.push_back(materialLibPath);
+		manifest.Outputs.push_back(cachePath);
+		for (const auto& material : object.materials)
+		{
+			// extracted textures are outputs too, if any is deleted object is cooked again. Missing external textures are not
+			// recorded, as cooking does not create them and object would be cooked again on every load
+			for (const FilePath* texture : { &material.AlbedoMap, &material.EmissiveMap, &material.HeightMap, &material.NormalMap,
+				&material.AmbientOcclusionMap, &material.MetallicMap, &material.RoughnessMap })
+			{
+				if (!texture->empty() && File::Exists(*texture)) manifest.Outputs.push_back(*texture);
+			}
+		}
+
+		AssetCooker::SaveManifest(source, manifest);
+		return true;
+	}
+
+	uint64_t AssetCooker::HashFileContents(const FilePath& path)
+	{
+		MAKE_SCOPE_PROFILER("AssetCooker::HashFileContents");
+
+		MappedFile file(path);
+		if (!file.IsOpen()) return 0;
+
+		// FNV-1a over 8-byte words, which is fast enough to hash large models at disk read speed
+		constexpr uint64_t Prime = 0x100000001B3;
+		uint64_t hash = 0xCBF29CE484222325;
+		const uint8_t* data = file.GetData();
+		size_t size = file.GetSize();
+
+		size_t offset = 0;
+		for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t))
+		{
+			uint64_t word = 0;
+			std::memcpy(&word, data + offset, sizeof(word));
+			hash = (hash ^ word) * Prime;
+			hash ^= hash >> 29;
+		}
+		for (; offset < size; offset++)
+		{
+			hash = (hash ^ data[offset]) * Prime;
+		}
+		return (hash ^ (uint64_t)size) * Prime;
+	}
+
+	bool AssetCooker::GetSourceStamp(const FilePath& path, uint64_t& size, int64_t& writeTime)
+	{
+		std::error_code error;
+		auto fileSize = std::filesystem::file_size(path, error);
+		if (error) return false;
+		auto fileTime = std::filesystem::last_write_time(path, error);
+		if (error) return false;
+
+		size = (uint64_t)fileSize;
+		writeTime = (int64_t)fileTime.time_since_epoch().count();
+		return true;
+	}
+}
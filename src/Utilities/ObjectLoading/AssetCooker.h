@@ -0,0 +1,118 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/ObjectLoading/ObjectLoader.h"
+
+namespace MxEngine
+{
+	/*!
+	cooking manifest is stored near source asset and describes files derived from it. Derived files are reused
+	until content hash of source file changes, so they are produced once per asset version instead of once per load
+	*/
+	struct CookedAssetManifest
+	{
+		static constexpr uint32_t CurrentVersion = 2;
+
+		/*!
+		version of cooking pipeline. Manifests with other version are considered outdated
+		*/
+		uint32_t Version = CurrentVersion;
+		/*!
+		content hash of source file at the moment of cooking
+		*/
+		uint64_t SourceHash = 0;
+		/*!
+		size and last write time of source file. If both match, source is not hashed again
+		*/
+		uint64_t SourceSize = 0;
+		int64_t SourceWriteTime = 0;
+		/*!
+		files produced by cooking. Asset is recooked if any of them is missing
+		*/
+		MxVector<FilePath> Outputs;
+	};
+
+	/*!
+	asset cooker produces derived files (material library, extracted textures, mesh cache) from source assets.
+	Checking manifest never writes to disk, so cooked assets can be loaded from read-only locations
+	*/
+	class AssetCooker
+	{
+	public:
+		/*!
+		gets path of cooking manifest for source asset
+		\param source path to source asset
+		\returns path to manifest file
+		*/
+		static FilePath GetManifestPath(const FilePath& source);
+		/*!
+		reads cooking manifest of source asset
+		\param source path to source asset
+		\param manifest manifest to fill
+		\returns true if manifest exists and was parsed, false either
+		*/
+		static bool LoadManifest(const FilePath& source, CookedAssetManifest& manifest);
+		/*!
+		writes cooking manifest of source asset
+		\param source path to source asset
+		\param manifest manifest to write
+		*/
+		static void SaveManifest(const FilePath& source, const CookedAssetManifest& manifest);
+		/*!
+		checks if cooked outputs can be used for source asset. Source is hashed only if its size or write time changed
+		\param source path to source asset
+		\param manifest manifest of source asset. If source was touched without content change, its write time is set to current one,
+		so manifest can be saved to skip hashing on next check
+		\returns true if all outputs exist and were produced from current source contents
+		*/
+		static bool IsUpToDate(const FilePath& source, CookedAssetManifest& manifest);
+		/*!
+		imports object file and writes its material library, extracted textures, mesh cache and cooking manifest
+		\param source path to object file
+		\param result merged mesh data of imported object, can be uploaded without reading mesh cache back
+		\returns true if object was imported and cooked, false either
+		*/
+		static bool CookMesh(const FilePath& source, MeshImportData& result);
+		/*!
+		computes 64-bit hash of file contents
+		\param path path to a file
+		\returns hash of file bytes or zero if file cannot be read
+		*/
+		static uint64_t HashFileContents(const FilePath& path);
+		/*!
+		reads size and last write time of file
+		\param path path to a file
+		\param size size of file in bytes
+		\param writeTime last write time of file in platform-dependent units
+		\returns true if file exists and its attributes were retrieved, false either
+		*/
+		static bool GetSourceStamp(const FilePath& path, uint64_t& size, int64_t& writeTime);
+	};
+}
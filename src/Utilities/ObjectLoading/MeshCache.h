@@ -0,0 +1,109 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/Resources/Vertex.h"
+#include "Utilities/STL/MxVector.h"
+
+#include <cstdint>
+
+namespace MxEngine
+{
+	/*!
+	mesh cache is a binary container which stores mesh in exactly the same layout as it is uploaded to GPU. Layout of file is:
+	[ header | submesh table | vertex blob | index blob ], each section begins at offset aligned by MeshCacheHeader::Alignment.
+	Indicies are already offset to index merged vertex blob, so blobs can be passed to VBO/IBO directly from mapped memory
+	*/
+	struct MeshCacheHeader
+	{
+		static constexpr uint32_t MagicValue = 0x4853454D; // 'MESH' in little-endian
+		static constexpr uint32_t CurrentVersion = 2;
+		static constexpr size_t Alignment = 64;
+
+		uint32_t Magic = MagicValue;
+		uint32_t Version = CurrentVersion;
+		/*!
+		size of single vertex and index in bytes. Used to reject caches created with different Vertex layout
+		*/
+		uint32_t VertexSize = sizeof(Vertex);
+		uint32_t IndexSize = sizeof(uint32_t);
+		/*!
+		content hash of source file. Cache is considered outdated if it differs from hash stored in cooking manifest
+		*/
+		uint64_t SourceHash = 0;
+		uint64_t Reserved = 0;
+
+		uint64_t SubMeshCount = 0;
+		uint64_t VertexCount = 0;
+		uint64_t IndexCount = 0;
+		uint64_t SubMeshTableOffset = 0;
+		uint64_t VertexDataOffset = 0;
+		uint64_t IndexDataOffset = 0;
+	};
+
+	/*!
+	submesh table entry. Offsets and counts are in vertecies/indicies, not bytes
+	*/
+	struct MeshCacheSubMesh
+	{
+		uint64_t VertexOffset = 0;
+		uint64_t VertexCount = 0;
+		uint64_t IndexOffset = 0;
+		uint64_t IndexCount = 0;
+		uint64_t MaterialId = 0;
+		Vector3 AABBMin{ 0.0f };
+		Vector3 AABBMax{ 0.0f };
+		Vector3 SphereCenter{ 0.0f };
+		float SphereRadius = 0.0f;
+	};
+
+	static_assert(sizeof(MeshCacheHeader) == 80, "mesh cache header layout must not depend on platform");
+	static_assert(sizeof(MeshCacheSubMesh) == 80, "mesh cache submesh layout must not depend on platform");
+
+	/*!
+	non-owning view of mesh cache contents. Pointers are valid while underlying file mapping is alive
+	*/
+	struct MeshCacheView
+	{
+		const MeshCacheHeader* Header = nullptr;
+		const MeshCacheSubMesh* SubMeshes = nullptr;
+		const Vertex* Vertecies = nullptr;
+		const uint32_t* Indicies = nullptr;
+	};
+
+	/*!
+	rounds offset up to the mesh cache section alignment
+	\param offset offset in bytes
+	\returns aligned offset
+	*/
+	constexpr uint64_t AlignMeshCacheOffset(uint64_t offset)
+	{
+		return (offset + MeshCacheHeader::Alignment - 1) / MeshCacheHeader::Alignment * MeshCacheHeader::Alignment;
+	}
+}
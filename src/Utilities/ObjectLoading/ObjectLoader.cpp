@@ -29,6 +29,7 @@
 #include "ObjectLoader.h"
 #include "Utilities/Logging/Logger.h"
 #include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Memory/SmallObjectAllocator.h"
 #include "Core/Macro/Macro.h"
 #include "Utilities/FileSystem/File.h"
 #include "Utilities/Format/Format.h"
@@ -36,6 +37,9 @@
 #include "Utilities/Json/Json.h"
 #include "Utilities/Image/ImageLoader.h"
 #include "Utilities/Image/ImageManager.h"
+#include "Core/Resources/MeshOptimizer.h"
+
+#include <cstring>
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
@@ -58,39 +62,38 @@ namespace MxEngine
 	{
 		if (File::Exists(roughnessPath) || File::Exists(metallicPath))
 			return; // avoid rewriting existing textures
-
-		auto roughnessData = (uint8_t*)std::malloc(image.GetTotalByteSize());
-		auto metallicData = (uint8_t*)std::malloc(image.GetTotalByteSize());
+		if (image.GetRawData() == nullptr)
+			return;
+
+		size_t pixelCount = image.GetWidth() * image.GetHeight();
+		size_t channels = image.GetChannelCount();
+		size_t channelSize = image.GetChannelSize();
+		auto roughnessData = (uint8_t*)std::malloc(pixelCount * channelSize);
+		auto metallicData = (uint8_t*)std::malloc(pixelCount * channelSize);
 		Image roughness(roughnessData, image.GetWidth(), image.GetHeight(), 1, image.IsFloatingPoint());
 		Image metallic(metallicData, image.GetWidth(), image.GetHeight(), 1, image.IsFloatingPoint());
 
-		for (size_t x = 0; x < image.GetWidth(); x++)
+		// roughness is stored in G channel and metallic in B channel. Channels are copied directly from raw data,
+		// as they have same size in source and destination images. Missing channels are filled with zeros
+		auto ExtractChannel = [&image, pixelCount, channels, channelSize](uint8_t* destination, size_t channel)
 		{
-			for (size_t y = 0; y < image.GetHeight(); y++)
+			const uint8_t* source = image.GetRawData();
+			if (channel >= channels)
 			{
-				if (image.IsFloatingPoint())
-				{
-					auto pixel = image.GetPixelFloat(x, y);
-					// G channel
-					roughness.SetPixelFloat(x, y, pixel[1], 0.0f, 0.0f, 0.0f);
-					// B channel
-					metallic.SetPixelFloat(x, y, pixel[2], 0.0f, 0.0f, 0.0f);
-				}
-				else
-				{
-					auto pixel = image.GetPixelByte(x, y);
-					// G channel
-					roughness.SetPixelByte(x, y, pixel[1], 0, 0, 0);
-					// B channel
-					metallic.SetPixelByte(x, y, pixel[2], 0, 0, 0);
-				}
+				std::memset(destination, 0, pixelCount * channelSize);
+				return;
 			}
-		}
+			for (size_t i = 0; i < pixelCount; i++)
+				std::memcpy(destination + i * channelSize, source + (i * channels + channel) * channelSize, channelSize);
+		};
+		ExtractChannel(roughnessData, 1);
+		ExtractChannel(metallicData, 2);
+
 		ImageManager::SaveImage(roughnessPath, roughness, PreferredFormat);
 		ImageManager::SaveImage(metallicPath, metallic, PreferredFormat);
 	}
 
-	FilePath GetActualTexturePath(const FilePath& lookupDirectory, const MxString& name, const aiScene* scene, const aiMaterial* material, aiTextureType type)
+	FilePath GetActualTexturePath(const FilePath& lookupDirectory, const MxString& name, const aiScene* scene, const aiMaterial* material, aiTextureType type, bool allowFileWrites)
 	{
 		auto path = lookupDirectory / ToFilePath(name + PreferredExtension);
 		if (File::Exists(path)) return path; // check if texture already on disk
@@ -106,6 +109,7 @@ namespace MxEngine
 				// if no - just return path to a texture
 				const aiTexture* data = scene->GetEmbeddedTexture(filepath);
 				if (data == nullptr) return lookupDirectory / filepath;
+				if (!allowFileWrites) return FilePath();
 
 				// if texture data is embedded, we need to create a file from it
 				Image image;
@@ -157,8 +161,9 @@ namespace MxEngine
 		}
 	}
 
-	ObjectInfo ObjectLoader::Load(const FilePath& filepath)
+	ObjectInfo ObjectLoader::Load(const FilePath& filepath, bool allowFileWrites)
 	{
+		MemoryTagScope memoryTag(MemoryTag::ASSETS);
 		auto directory = filepath.parent_path();
 		ObjectInfo object;
 
@@ -172,10 +177,10 @@ namespace MxEngine
 		MAKE_SCOPE_TIMER("MxEngine::ObjectLoader", "ObjectLoader::LoadObject");
 		MXLOG_INFO("Assimp::Importer", "loading object from file: " + ToMxString(filepath));
 
-		static Assimp::Importer importer; // TODO: not thread safe
+		Assimp::Importer importer; // importer is created per call, so objects can be loaded from several threads at once
 		const aiScene* scene = importer.ReadFile(filepath.string().c_str(), 
 			aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices |
-			aiProcess_OptimizeMeshes | aiProcess_ImproveCacheLocality | aiProcess_GenUVCoords | aiProcess_CalcTangentSpace);
+			aiProcess_OptimizeMeshes | aiProcess_GenUVCoords | aiProcess_CalcTangentSpace);
 		if (scene == nullptr)
 		{
 			MXLOG_ERROR("Assimp::Importer", importer.GetErrorString());
@@ -224,18 +229,18 @@ namespace MxEngine
 			}
 
 			// process first to make sure metallic / roughness will present when checking for existing textures in GetActualTexturePath
-			SplitRoughnessMetallicTexture(directory, MxFormat("{}_{}", RoughnessTexName, i), MxFormat("{}_{}", MetallicTexName, i), scene, material, aiTextureType_UNKNOWN);
+			if (allowFileWrites) SplitRoughnessMetallicTexture(directory, MxFormat("{}_{}", RoughnessTexName, i), MxFormat("{}_{}", MetallicTexName, i), scene, material, aiTextureType_UNKNOWN);
 
-			materialInfo.AlbedoMap           = GetActualTexturePath(directory, MxFormat("{}_{}", AlbedoTexName,    i), scene, material, aiTextureType_DIFFUSE);
-			materialInfo.EmissiveMap         = GetActualTexturePath(directory, MxFormat("{}_{}", EmissiveTexName,  i), scene, material, aiTextureType_EMISSIVE);
-			materialInfo.HeightMap           = GetActualTexturePath(directory, MxFormat("{}_{}", HeightTexName,    i), scene, material, aiTextureType_HEIGHT);
-			materialInfo.NormalMap           = GetActualTexturePath(directory, MxFormat("{}_{}", NormalTexName,    i), scene, material, aiTextureType_NORMALS);
-			materialInfo.AmbientOcclusionMap = GetActualTexturePath(directory, MxFormat("{}_{}", AOTexName,        i), scene, material, aiTextureType_AMBIENT_OCCLUSION);
-			materialInfo.RoughnessMap        = GetActualTexturePath(directory, MxFormat("{}_{}", RoughnessTexName, i), scene, material, aiTextureType_DIFFUSE_ROUGHNESS);
-			materialInfo.MetallicMap         = GetActualTexturePath(directory, MxFormat("{}_{}", MetallicTexName,  i), scene, material, aiTextureType_METALNESS);
+			materialInfo.AlbedoMap           = GetActualTexturePath(directory, MxFormat("{}_{}", AlbedoTexName,    i), scene, material, aiTextureType_DIFFUSE, allowFileWrites);
+			materialInfo.EmissiveMap         = GetActualTexturePath(directory, MxFormat("{}_{}", EmissiveTexName,  i), scene, material, aiTextureType_EMISSIVE, allowFileWrites);
+			materialInfo.HeightMap           = GetActualTexturePath(directory, MxFormat("{}_{}", HeightTexName,    i), scene, material, aiTextureType_HEIGHT, allowFileWrites);
+			materialInfo.NormalMap           = GetActualTexturePath(directory, MxFormat("{}_{}", NormalTexName,    i), scene, material, aiTextureType_NORMALS, allowFileWrites);
+			materialInfo.AmbientOcclusionMap = GetActualTexturePath(directory, MxFormat("{}_{}", AOTexName,        i), scene, material, aiTextureType_AMBIENT_OCCLUSION, allowFileWrites);
+			materialInfo.RoughnessMap        = GetActualTexturePath(directory, MxFormat("{}_{}", RoughnessTexName, i), scene, material, aiTextureType_DIFFUSE_ROUGHNESS, allowFileWrites);
+			materialInfo.MetallicMap         = GetActualTexturePath(directory, MxFormat("{}_{}", MetallicTexName,  i), scene, material, aiTextureType_METALNESS, allowFileWrites);
 
 			// if aiTextureType_AMBIENT_OCCLUSION failed to load, try aiTextureType_LIGHTMAP as alternative, as it also can store ambient occlusion
-			if(materialInfo.AmbientOcclusionMap.empty()) materialInfo.AmbientOcclusionMap = GetActualTexturePath(directory, MxFormat("{}_{}", AOTexName, i), scene, material, aiTextureType_LIGHTMAP);
+			if(materialInfo.AmbientOcclusionMap.empty()) materialInfo.AmbientOcclusionMap = GetActualTexturePath(directory, MxFormat("{}_{}", AOTexName, i), scene, material, aiTextureType_LIGHTMAP, allowFileWrites);
 
 			// if emmision texture provided, set emmision to some non-zero value
 			if (!materialInfo.EmissiveMap.empty() && materialInfo.Emission == 0.0f) materialInfo.Emission = 1.0f;
@@ -314,6 +319,69 @@ namespace MxEngine
 		return object;
 	}
 
+	void ObjectLoader::MergeMeshes(const ObjectInfo& object, MeshImportData& result)
+	{
+		MAKE_SCOPE_PROFILER("ObjectLoader::MergeMeshes");
+
+		// precompute size of merged vertex and index arrays
+		size_t totalVerticies = 0;
+		size_t totalIndicies = 0;
+		for (const auto& meshInfo : object.meshes)
+		{
+			totalVerticies += meshInfo.vertecies.size();
+			totalIndicies += meshInfo.indicies.size();
+		}
+		result.Vertecies.reserve(totalVerticies);
+		result.Indicies.reserve(totalIndicies);
+		result.SubMeshes.reserve(object.meshes.size());
+
+		size_t shadedBefore = 0, shadedAfter = 0, triangleCount = 0;
+
+		// insert all verticies and indicies into single array, so they can be uploaded to single VBO/IBO
+		for (const auto& meshInfo : object.meshes)
+		{
+			// each submesh is drawn separately, so it is optimized for vertex cache on its own
+			MeshData::VertexData vertecies = meshInfo.vertecies;
+			MeshData::IndexData indicies = meshInfo.indicies;
+			VertexCacheStatistics before, after;
+			MeshOptimizer::Optimize(vertecies, indicies, before, after);
+			shadedBefore += before.VertexShaded;
+			shadedAfter += after.VertexShaded;
+			triangleCount += indicies.size() / 3;
+
+			auto& submesh = result.SubMeshes.emplace_back();
+			submesh.VertexOffset = result.Vertecies.size();
+			submesh.VertexCount = vertecies.size();
+			submesh.IndexOffset = result.Indicies.size();
+			submesh.IndexCount = indicies.size();
+			submesh.MaterialId = std::numeric_limits<uint64_t>::max();
+			if (meshInfo.useTexture && meshInfo.material != nullptr)
+				submesh.MaterialId = uint64_t(meshInfo.material - object.materials.data());
+
+			AABB boundingBox;
+			BoundingSphere boundingSphere;
+			MeshData::ComputeBoundingGeometry(vertecies, boundingBox, boundingSphere);
+			submesh.AABBMin = boundingBox.Min;
+			submesh.AABBMax = boundingBox.Max;
+			submesh.SphereCenter = boundingSphere.Center;
+			submesh.SphereRadius = boundingSphere.Radius;
+
+			// apply vertex offset to each index
+			for (const auto& index : indicies)
+				result.Indicies.push_back(index + (uint32_t)result.Vertecies.size());
+			// no additional operations for verticies
+			result.Vertecies.insert(result.Vertecies.end(), vertecies.begin(), vertecies.end());
+		}
+
+		// optimizer may drop unreferenced vertecies, so ATVR before optimization is computed over original vertex count
+		if (triangleCount > 0 && totalVerticies > 0 && !result.Vertecies.empty())
+		{
+			MXLOG_INFO("MxEngine::ObjectLoader", MxFormat("optimized meshes: ACMR {0:.3f} -> {1:.3f}, ATVR {2:.3f} -> {3:.3f}",
+				float(shadedBefore) / float(triangleCount), float(shadedAfter) / float(triangleCount),
+				float(shadedBefore) / float(totalVerticies), float(shadedAfter) / float(result.Vertecies.size())));
+		}
+	}
+
     MaterialLibrary ObjectLoader::LoadMaterials(const FilePath& path)
     {
 		MaterialLibrary materials;
@@ -389,4 +457,60 @@ namespace MxEngine
 
 		SaveJson(file, json);
 	}
-}
\ No newline at end of file
+
+	bool ObjectLoader::LoadMeshCache(const MappedFile& cacheFile, uint64_t sourceHash, MeshCacheView& view)
+	{
+		MAKE_SCOPE_PROFILER("ObjectLoader::LoadMeshCache");
+
+		if (!cacheFile.IsOpen() || cacheFile.GetSize() < sizeof(MeshCacheHeader))
+			return false;
+
+		const uint8_t* data = cacheFile.GetData();
+		uint64_t fileSize = cacheFile.GetSize();
+		const auto* header = reinterpret_cast<const MeshCacheHeader*>(data);
+
+		if (header->Magic != MeshCacheHeader::MagicValue || header->Version != MeshCacheHeader::CurrentVersion ||
+			header->VertexSize != sizeof(Vertex) || header->IndexSize != sizeof(uint32_t))
+		{
+			MXLOG_WARNING("MxEngine::ObjectLoader", "mesh cache has incompatible format and cannot be used");
+			return false;
+		}
+
+		if (header->SourceHash != sourceHash)
+		{
+			MXLOG_INFO("MxEngine::ObjectLoader", "mesh cache is outdated and cannot be used");
+			return false;
+		}
+
+		// check that each section fits into file, so truncated caches are rejected instead of read out of bounds
+		auto IsSectionValid = [fileSize](uint64_t offset, uint64_t count, uint64_t elementSize)
+		{
+			return offset % MeshCacheHeader::Alignment == 0 && offset <= fileSize && count <= (fileSize - offset) / elementSize;
+		};
+		if (!IsSectionValid(header->SubMeshTableOffset, header->SubMeshCount, sizeof(MeshCacheSubMesh)) ||
+			!IsSectionValid(header->VertexDataOffset, header->VertexCount, sizeof(Vertex)) ||
+			!IsSectionValid(header->IndexDataOffset, header->IndexCount, sizeof(uint32_t)))
+		{
+			MXLOG_WARNING("MxEngine::ObjectLoader", "mesh cache is corrupted and cannot be used");
+			return false;
+		}
+
+		view.Header = header;
+		view.SubMeshes = reinterpret_cast<const MeshCacheSubMesh*>(data + header->SubMeshTableOffset);
+		view.Vertecies = reinterpret_cast<const Vertex*>(data + header->VertexDataOffset);
+		view.Indicies = reinterpret_cast<const uint32_t*>(data + header->IndexDataOffset);
+
+		for (size_t i = 0; i < header->SubMeshCount; i++)
+		{
+			const auto& submesh = view.SubMeshes[i];
+			if (submesh.VertexOffset + submesh.VertexCount > header->VertexCount ||
+				submesh.IndexOffset + submesh.IndexCount > header->IndexCount)
+			{
+				MXLOG_WARNING("MxEngine::ObjectLoader", "mesh cache is corrupted and cannot be used");
+				view = MeshCacheView{ };
+				return false;
+			}
+		}
+		return true;
+	}
+}
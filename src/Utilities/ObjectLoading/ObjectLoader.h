@@ -37,6 +37,8 @@
 #include "Utilities/STL/MxVector.h"
 #include "Core/Resources/MeshData.h"
 #include "Utilities/FileSystem/File.h"
+#include "Utilities/FileSystem/MappedFile.h"
+#include "Utilities/ObjectLoading/MeshCache.h"
 
 namespace MxEngine
 {
@@ -158,6 +160,29 @@ namespace MxEngine
 		MxVector<MeshInfo> meshes;
 	};
 
+	/*!
+	mesh import data contains merged vertex and index arrays of object, ready to be uploaded to GPU. Data is either mapped
+	from mesh cache (if Cache.Header is not null) or owned by vectors after import by Assimp. It is produced by Mesh::Import()
+	without any graphic API calls, so it can be created on any thread and later uploaded by Mesh::Upload() on main thread
+	*/
+	struct MeshImportData
+	{
+		/*!
+		mapped mesh cache, kept alive until data is uploaded
+		*/
+		MappedFile CacheFile;
+		/*!
+		view of mapped cache sections. Header is null if data was imported by Assimp
+		*/
+		MeshCacheView Cache;
+		/*!
+		merged data of all submeshes, used only if cache was not available
+		*/
+		MxVector<Vertex> Vertecies;
+		MxVector<uint32_t> Indicies;
+		MxVector<MeshCacheSubMesh> SubMeshes;
+	};
+
 	/*!
 	object loader is a special class which loads any type of file with object data into MxEngine compatible format (i.e. ObjectInfo)
 	it supports same file types as Assimp library does, as it is base on it. For more info check documentation: https://github.com/assimp/assimp
@@ -168,11 +193,26 @@ namespace MxEngine
 		/*
 		loads object from disk by its file path
 		\param path absoulute or relative to executable folder path to a file to load
+		\param allowFileWrites if true, embedded and packed roughness/metallic textures are extracted to files near object. Otherwise only existing files are referenced
 		\returns ObjectInfo instance
-		\warning this function is not thread safe
 		*/
-		static ObjectInfo Load(const FilePath& path);
+		static ObjectInfo Load(const FilePath& path, bool allowFileWrites = true);
+		/*!
+		merges all meshes of object into single vertex and index arrays, computing submesh table with bounding geometry.
+		Each mesh is optimized for vertex cache, overdraw and vertex fetch before merging
+		\param object object to merge
+		\param result import data to fill. Only its owned arrays are modified
+		*/
+		static void MergeMeshes(const ObjectInfo& object, MeshImportData& result);
 		static MaterialLibrary LoadMaterials(const FilePath& path);
 		static void DumpMaterials(const MaterialLibrary& materials, const FilePath& path);
+		/*!
+		validates mapped mesh cache and retrieves pointers to its sections
+		\param cacheFile mapped cache file, created by ObjectSaver::SaveMeshCache()
+		\param sourceHash expected content hash of file from which cache was created. Cache is rejected if it differs
+		\param view view to fill with pointers into mapped memory
+		\returns true if cache is valid and up to date, false either
+		*/
+		static bool LoadMeshCache(const MappedFile& cacheFile, uint64_t sourceHash, MeshCacheView& view);
 	};
 }
\ No newline at end of file
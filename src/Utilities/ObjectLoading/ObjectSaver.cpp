@@ -99,4 +99,41 @@ namespace MxEngine
         auto indicies = meshData.GetIndiciesFromGPU();
         return ObjectSaver::SaveVerteciesIndicies(filepath, format, vertecies, indicies);
     }
-}
\ No newline at end of file
+
+    void ObjectSaver::SaveMeshCache(const FilePath& cachePath, uint64_t sourceHash, const MxVector<MeshCacheSubMesh>& submeshes, const MeshData::VertexData& vertecies, const MeshData::IndexData& indicies)
+    {
+        MAKE_SCOPE_PROFILER("ObjectSaver::SaveMeshCache()");
+        MAKE_SCOPE_TIMER("MxEngine::ObjectSaver", "ObjectSaver::SaveMeshCache()");
+
+        MeshCacheHeader header;
+        header.SourceHash = sourceHash;
+        header.SubMeshCount = submeshes.size();
+        header.VertexCount = vertecies.size();
+        header.IndexCount = indicies.size();
+        header.SubMeshTableOffset = AlignMeshCacheOffset(sizeof(MeshCacheHeader));
+        header.VertexDataOffset = AlignMeshCacheOffset(header.SubMeshTableOffset + submeshes.size() * sizeof(MeshCacheSubMesh));
+        header.IndexDataOffset = AlignMeshCacheOffset(header.VertexDataOffset + vertecies.size() * sizeof(Vertex));
+
+        File file(cachePath, File::WRITE | File::BINARY);
+        if (!file.IsOpen())
+        {
+            MXLOG_ERROR("MxEngine::ObjectSaver", "cannot open file: " + ToMxString(cachePath));
+            return;
+        }
+        MXLOG_INFO("MxEngine::ObjectSaver", "saving mesh cache to file: " + ToMxString(cachePath));
+
+        uint64_t writtenBytes = 0;
+        auto WriteSection = [&file, &writtenBytes](uint64_t offset, const void* data, size_t size)
+        {
+            constexpr uint8_t Padding[MeshCacheHeader::Alignment] = { };
+            file.WriteBytes(Padding, size_t(offset - writtenBytes));
+            file.WriteBytes((const uint8_t*)data, size);
+            writtenBytes = offset + size;
+        };
+
+        WriteSection(0, &header, sizeof(header));
+        WriteSection(header.SubMeshTableOffset, submeshes.data(), submeshes.size() * sizeof(MeshCacheSubMesh));
+        WriteSection(header.VertexDataOffset, vertecies.data(), vertecies.size() * sizeof(Vertex));
+        WriteSection(header.IndexDataOffset, indicies.data(), indicies.size() * sizeof(uint32_t));
+    }
+}
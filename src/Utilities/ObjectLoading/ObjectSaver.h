@@ -30,6 +30,7 @@
 
 #include "Core/Resources/Mesh.h"
 #include "Utilities/FileSystem/File.h"
+#include "Utilities/ObjectLoading/MeshCache.h"
 
 namespace MxEngine
 {
@@ -43,5 +44,14 @@ namespace MxEngine
     public:
         static void SaveVerteciesIndicies(const FilePath& filepath, SupportedSaveFormats format, const MeshData::VertexData& vertecies, const MeshData::IndexData& indicies);
         static void SaveMeshData(const FilePath& filepath, SupportedSaveFormats format, const MeshData& meshData);
+        /*!
+        writes binary mesh cache which can be later loaded by ObjectLoader::LoadMeshCache()
+        \param cachePath path to a cache file to write
+        \param sourceHash content hash of file from which mesh was imported. Used to detect outdated caches
+        \param submeshes submesh table. Offsets are relative to merged vertex and index arrays
+        \param vertecies merged vertex data of all submeshes
+        \param indicies merged index data of all submeshes, already offset by submesh vertex offset
+        */
+        static void SaveMeshCache(const FilePath& cachePath, uint64_t sourceHash, const MxVector<MeshCacheSubMesh>& submeshes, const MeshData::VertexData& vertecies, const MeshData::IndexData& indicies);
     };
 }
\ No newline at end of file
@@ -29,6 +29,8 @@
 #include "Profiler.h"
 #include "Utilities/STL/MxString.h"
 
+#include <atomic>
+
 namespace MxEngine
 {
 	void ProfileSession::WriteJsonHeader()
@@ -62,8 +64,17 @@ namespace MxEngine
 		this->WriteJsonHeader();
 	}
 
+	static size_t GetProfilerThreadId()
+	{
+		static std::atomic<size_t> threadCounter{ 0 };
+		thread_local size_t threadId = threadCounter.fetch_add(1);
+		return threadId;
+	}
+
 	void ProfileSession::WriteJsonEntry(const char* function, TimeStep begin, TimeStep delta)
 	{
+		size_t threadId = GetProfilerThreadId();
+		std::lock_guard<std::mutex> lock(this->writeMutex);
 		if (!this->IsValid()) return;
 
 		if (this->GetEntryCount() > 0)
@@ -74,7 +85,7 @@ namespace MxEngine
 
 		output << "	{";
 		output << "\"pid\": 0, ";
-		output << "\"tid\": 0, ";
+		output << "\"tid\": " << std::to_string(threadId) << ", ";
 		output << "\"ts\": " << std::to_string(uint64_t((double)begin * 1000000)) << ", ";
 		output << "\"dur\": " << std::to_string(uint64_t((double)delta * 1000000)) << ", ";
 		output << "\"ph\": \"X\", ";
@@ -84,6 +95,7 @@ namespace MxEngine
 
 	void ProfileSession::EndSession()
 	{
+		std::lock_guard<std::mutex> lock(this->writeMutex);
 		if (!this->IsValid()) return;
 		this->WriteJsonFooter();
 		output.Close();
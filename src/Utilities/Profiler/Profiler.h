@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "Core/Macro/Macro.h"
 #include "Utilities/Time/Time.h"
 #include "Utilities/Logging/Logger.h"
@@ -49,6 +51,10 @@ namespace MxEngine
 		count of json log entries (is used internally to create json file)
 		*/
 		size_t entriesCount = 0;
+		/*!
+		guards json file, as profiled scopes can be executed by worker threads of job system
+		*/
+		std::mutex writeMutex;
 
 		/*!
 		writes header of json file, i.e "{ traceEvents: [ ..."
@@ -75,7 +81,7 @@ namespace MxEngine
 		*/
 		void StartSession(const MxString& filename);
 		/*!
-		writes json entry, consisting of process id, start/end time, function name
+		writes json entry, consisting of process id, thread id, start/end time, function name. Can be called from any thread
 		\param function called function name 
 		\param begin start timepoint of function execution
 		\param delta duration of function execution
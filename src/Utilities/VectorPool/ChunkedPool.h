@@ -0,0 +1,442 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/STL/MxVector.h"
+#include "Utilities/Memory/Memory.h"
+#include "Utilities/Math/Math.h"
+
+#include <limits>
+#include <type_traits>
+
+namespace MxEngine
+{
+    /*!
+    ChunkedPool is an object pool with the same interface as VectorPool, but its storage is split into fixed-size pages.
+    When pool is full, new page is added to page table, so growth never copies existing objects and references to them stay valid
+    until object is deallocated. Element index is encoded as page index * PageSize + offset inside page
+    */
+    template<typename T, size_t PageSize = 256>
+    class ChunkedPool
+    {
+        static_assert(PageSize % 64 == 0, "page size must be multiple of 64");
+    public:
+        /*!
+        iterator for ChunkedPool class. supports increment, compare and decrement.
+        Ignores not allocated objects, allowing user to iterate over all objects in pool without check for IsAllocated(index)
+        */
+        class PoolIterator
+        {
+            /*!
+            current index of object in pool
+            */
+            size_t index = 0;
+            /*!
+            reference to pool. This means that pool must not be moved/deleted until iterator exists
+            */
+            mutable ChunkedPool<T, PageSize>* poolRef;
+        public:
+            size_t GetBase() const
+            {
+                return index;
+            }
+
+            /*!
+            constructs new iterator of pool
+            \param index to the element of pool (0 for begin(), Capacity() for end() methods)
+            \param poolRef reference to pool
+            */
+            PoolIterator(size_t index, ChunkedPool<T, PageSize>& ref)
+                : index(index), poolRef(&ref)
+            {
+                this->index = poolRef->NextAllocated(this->index);
+            }
+
+            PoolIterator operator++(int)
+            {
+                PoolIterator copy = *this;
+                ++(*this);
+                return copy;
+            }
+
+            PoolIterator operator++()
+            {
+                index = poolRef->NextAllocated(index + 1);
+                return *this;
+            }
+
+            PoolIterator operator--(int)
+            {
+                PoolIterator copy = *this;
+                --(*this);
+                return copy;
+            }
+
+            PoolIterator operator--()
+            {
+                index = poolRef->PrevAllocated(index - 1);
+                return *this;
+            }
+
+            T* operator->() const
+            {
+                return std::addressof((*poolRef)[index]);
+            }
+
+            T& operator*() const
+            {
+                return (*poolRef)[index];
+            }
+
+            bool operator==(const PoolIterator& it) const
+            {
+                return (index == it.index) && (poolRef == it.poolRef);
+            }
+
+            bool operator!=(const PoolIterator& it) const
+            {
+                return !(*this == it);
+            }
+        };
+
+        using value_type = T;
+        using iterator = PoolIterator;
+
+        static constexpr size_t InvalidIndex = std::numeric_limits<size_t>::max();
+    private:
+        static constexpr size_t BitsPerMask = 8 * sizeof(uint64_t);
+
+        struct Block
+        {
+            /*!
+            object data itself. Must be first member of block, so object address is equal to block address
+            */
+            std::aligned_storage_t<sizeof(T), alignof(T)> data;
+            /*!
+            index of block inside pool. Used to retrieve index by object reference without searching through page table
+            */
+            size_t index;
+            /*!
+            index of next free block if this block is free
+            */
+            size_t next;
+            /*!
+            number of times object in this block was destroyed. Used by handles to detect that block was reused
+            */
+            uint32_t generation;
+        };
+
+        using Page = UniqueRef<Block[]>;
+
+        /*!
+        page table. Pages are never reallocated or moved while pool exists
+        */
+        MxVector<Page> pages;
+        /*!
+        allocation bitmap. Bit is set if corresponding block contains constructed object
+        */
+        MxVector<uint64_t> allocationMask;
+        /*!
+        first free block in free list
+        */
+        size_t free = InvalidIndex;
+        /*!
+        number of constructed objects
+        */
+        size_t allocated = 0;
+        /*!
+        generations of blocks of pages freed by Clear(). New pages continue them, so handles to destroyed elements stay invalid
+        */
+        MxVector<uint32_t> generations;
+
+        Block& GetBlockByIndex(size_t index)
+        {
+            MX_ASSERT(index < this->Capacity());
+            return this->pages[index / PageSize][index % PageSize];
+        }
+
+        const Block& GetBlockByIndex(size_t index) const
+        {
+            MX_ASSERT(index < this->Capacity());
+            return this->pages[index / PageSize][index % PageSize];
+        }
+
+        void AddPage()
+        {
+            size_t first = this->Capacity();
+            Page page(new Block[PageSize]);
+            for (size_t i = 0; i < PageSize; i++)
+            {
+                page[i].index = first + i;
+                page[i].next = first + i + 1;
+                page[i].generation = first + i < this->generations.size() ? this->generations[first + i] : 0;
+            }
+            page[PageSize - 1].next = this->free; // chain new blocks before old free ones
+            this->free = first;
+
+            this->pages.push_back(std::move(page));
+            this->allocationMask.resize(this->pages.size() * PageSize / BitsPerMask, 0);
+        }
+    public:
+        /*!
+        constructs empty pool (no pages allocated)
+        */
+        ChunkedPool() = default;
+
+        /*!
+        constructs pool with at least count elements as capacity
+        \param count number of preallocated elements (not constructed)
+        */
+        ChunkedPool(size_t count)
+        {
+            this->Resize(count);
+        }
+
+        ChunkedPool(const ChunkedPool&) = delete;
+        ChunkedPool& operator=(const ChunkedPool&) = delete;
+        ChunkedPool(ChunkedPool&&) = default;
+        ChunkedPool& operator=(ChunkedPool&&) = default;
+
+        ~ChunkedPool()
+        {
+            this->Clear();
+        }
+
+        /*!
+        increases pool capacity by adding new pages. If new count is less or equal than current, request is ignored
+        \param count new number of preallocated elements in pool (not constructed)
+        */
+        void Resize(size_t count)
+        {
+            while (this->Capacity() < count)
+                this->AddPage();
+        }
+
+        /*!
+        gets how many elements are in use (constructed)
+        \returns count of currently allocated elements
+        */
+        size_t Allocated() const
+        {
+            return this->allocated;
+        }
+
+        /*!
+        gets total number of elements in all pages of pool
+        \returns how many elements can potentially be stored in pool without adding new page
+        */
+        size_t Capacity() const
+        {
+            return this->pages.size() * PageSize;
+        }
+
+        /*!
+        gets total number in bytes allocated for pool pages
+        \returns how many bytes are allocated for pool
+        */
+        size_t CapacityInBytes() const
+        {
+            return this->pages.size() * PageSize * sizeof(Block);
+        }
+
+        T& operator[] (size_t index)
+        {
+            return *std::launder(reinterpret_cast<T*>(&this->GetBlockByIndex(index).data));
+        }
+
+        const T& operator[] (size_t index) const
+        {
+            return *std::launder(reinterpret_cast<const T*>(&this->GetBlockByIndex(index).data));
+        }
+
+        /*!
+        clears pool. All constructed elements are destroyed and all pages are freed. Generations of blocks are kept,
+        so handles to destroyed elements do not become valid again when pages are added
+        */
+        void Clear()
+        {
+            if (this->generations.size() < this->Capacity())
+                this->generations.resize(this->Capacity(), 0);
+
+            for (size_t index = 0; index < this->Capacity(); index++)
+            {
+                this->generations[index] = this->GetBlockByIndex(index).generation;
+            }
+            for (size_t index = this->NextAllocated(0); index < this->Capacity(); index = this->NextAllocated(index + 1))
+            {
+                (*this)[index].~T();
+                this->generations[index]++;
+            }
+            this->pages.clear();
+            this->allocationMask.clear();
+            this->free = InvalidIndex;
+            this->allocated = 0;
+        }
+
+        /*!
+        checks if element is constructed
+        \param index index of element in pool
+        \returns true if element is constructed, false either
+        */
+        bool IsAllocated(size_t index) const
+        {
+            return index < this->Capacity() && (this->allocationMask[index / BitsPerMask] >> (index % BitsPerMask)) & 1;
+        }
+
+        /*!
+        gets generation of block. Generation is increased each time element in the block is destroyed
+        \param index index of element in pool
+        \returns generation counter of block
+        */
+        uint32_t GetGeneration(size_t index) const
+        {
+            return this->GetBlockByIndex(index).generation;
+        }
+
+        /*!
+        searches for first constructed element starting from index provided
+        \param index index of element to start search from (inclusive)
+        \returns index of constructed element or Capacity() if no elements found
+        */
+        size_t NextAllocated(size_t index) const
+        {
+            size_t capacity = this->Capacity();
+            if (index >= capacity) return capacity;
+
+            size_t word = index / BitsPerMask;
+            uint64_t mask = this->allocationMask[word] & (~(uint64_t)0 << (index % BitsPerMask));
+            while (mask == 0)
+            {
+                word++;
+                if (word == this->allocationMask.size()) return capacity;
+                mask = this->allocationMask[word];
+            }
+            return word * BitsPerMask + CountTrailingZeros(mask);
+        }
+
+        /*!
+        searches for last constructed element before index provided
+        \param index index of element to start search from (inclusive)
+        \returns index of constructed element or InvalidIndex if no elements found
+        */
+        size_t PrevAllocated(size_t index) const
+        {
+            size_t capacity = this->Capacity();
+            if (capacity == 0 || index == InvalidIndex) return InvalidIndex;
+            if (index >= capacity) index = capacity - 1;
+
+            size_t word = index / BitsPerMask;
+            size_t shift = BitsPerMask - 1 - index % BitsPerMask;
+            uint64_t mask = this->allocationMask[word] & (~(uint64_t)0 >> shift);
+            while (mask == 0)
+            {
+                if (word == 0) return InvalidIndex;
+                word--;
+                mask = this->allocationMask[word];
+            }
+            return word * BitsPerMask + (BitsPerMask - 1 - CountLeadingZeros(mask));
+        }
+
+        /*!
+        destroys element in pool
+        \param index index of element to destroy
+        */
+        void Deallocate(size_t index)
+        {
+            if (this->IsAllocated(index))
+            {
+                (*this)[index].~T();
+                Block& block = this->GetBlockByIndex(index);
+                block.next = this->free;
+                block.generation++;
+                this->free = index;
+                this->allocationMask[index / BitsPerMask] &= ~((uint64_t)1 << (index % BitsPerMask));
+                this->allocated--;
+            }
+        }
+
+        void Deallocate(const PoolIterator& it)
+        {
+            this->Deallocate(it.GetBase());
+        }
+
+        /*!
+        constructs element in pool. If it has not enough space - new page is added
+        \param args arguments for element constructor
+        \returns index of element in pool
+        */
+        template<typename... Args>
+        size_t Allocate(Args&&... args)
+        {
+            if (this->free == InvalidIndex)
+                this->AddPage();
+
+            size_t index = this->free;
+            Block& block = this->GetBlockByIndex(index);
+            this->free = block.next;
+            new (&block.data) T(std::forward<Args>(args)...);
+
+            this->allocationMask[index / BitsPerMask] |= (uint64_t)1 << (index % BitsPerMask);
+            this->allocated++;
+            return index;
+        }
+
+        /*!
+        retrieves index of element in pool by reference
+        \param obj element of pool
+        \returns index of element in pool
+        */
+        size_t IndexOf(const T& obj) const
+        {
+            auto& block = *reinterpret_cast<const Block*>(std::addressof(obj));
+            MX_ASSERT(&this->GetBlockByIndex(block.index) == &block);
+            return block.index;
+        }
+
+        auto begin()
+        {
+            return PoolIterator{ 0, *this };
+        }
+
+        auto end()
+        {
+            return PoolIterator{ this->Capacity(), *this };
+        }
+
+        bool empty() const
+        {
+            return this->Allocated() == 0;
+        }
+
+        size_t size() const
+        {
+            return this->Allocated();
+        }
+    };
+}
@@ -30,6 +30,9 @@
 
 #include "Utilities/STL/MxVector.h"
 #include "Utilities/Memory/PoolAllocator.h"
+#include "Utilities/Math/Math.h"
+
+#include <limits>
 
 namespace MxEngine
 {
@@ -37,6 +40,7 @@ namespace MxEngine
     VectorPool is an object Pool class which is used for fast allocations/deallocations of objects of type T
     objects are accessed by index in array and references should not be stored (as any allocation can potentially invalidate them)
     to check if object is allocated before access, use IsAllocated(index). To allocate use Allocate(args), to deallocate - Deallocate(index)
+    pool also keeps allocation bitmap, so iteration over sparse pool skips 64 free slots at once without touching their memory
     */
     template<typename T, template<typename, typename...> typename Container = MxVector>
     class VectorPool
@@ -75,10 +79,7 @@ namespace MxEngine
             PoolIterator(size_t index, VectorPool<T, Container>& ref)
                 : index(index), poolRef(&ref)
             {
-                while (this->index < this->poolRef->Capacity() && !poolRef->IsAllocated(this->index))
-                {
-                    this->index++; // 0 element may not exists, so we should skip it until find any allocated
-                }
+                this->index = poolRef->NextAllocated(this->index); // 0 element may not exists, so we should skip it until find any allocated
             }
 
             /*!
@@ -98,7 +99,7 @@ namespace MxEngine
             */
             PoolIterator operator++()
             {
-                do { index++; } while (index < poolRef->Capacity() && !poolRef->IsAllocated(index));
+                index = poolRef->NextAllocated(index + 1);
                 return *this;
             }
 
@@ -119,7 +120,7 @@ namespace MxEngine
             */
             PoolIterator operator--()
             {
-                do { index--; } while (index < poolRef->Capacity() && !poolRef->IsAllocated(index));
+                index = poolRef->PrevAllocated(index - 1);
                 return *this;
             }
 
@@ -165,7 +166,11 @@ namespace MxEngine
 
         using value_type = T;
         using iterator = PoolIterator;
+
+        static constexpr size_t InvalidIndex = std::numeric_limits<size_t>::max();
     private:
+        static constexpr size_t BitsPerMask = 8 * sizeof(uint64_t);
+
         /*!
         storage for allocator memory. Unluckly, not debuggable
         */
@@ -178,6 +183,24 @@ namespace MxEngine
         number of constructed objects
         */
         size_t allocated = 0;
+        /*!
+        allocation bitmap. Bit is set if corresponding block contains constructed object
+        */
+        Container<uint64_t> allocationMask;
+        /*!
+        generation counter for each block, increased each time element in the block is destroyed
+        */
+        Container<uint32_t> generations;
+
+        void SetAllocationBit(size_t index)
+        {
+            this->allocationMask[index / BitsPerMask] |= (uint64_t)1 << (index % BitsPerMask);
+        }
+
+        void ResetAllocationBit(size_t index)
+        {
+            this->allocationMask[index / BitsPerMask] &= ~((uint64_t)1 << (index % BitsPerMask));
+        }
 
         Block* GetBlockByIndex(size_t index)
         {
@@ -218,6 +241,8 @@ namespace MxEngine
             Container<uint8_t> newMemory(count * sizeof(Block));
             allocator.Transfer(newMemory.data(), newMemory.size());
             memoryStorage = std::move(newMemory);
+            allocationMask.resize((count + BitsPerMask - 1) / BitsPerMask, 0);
+            if (generations.size() < count) generations.resize(count, 0); // generations may be kept from storage freed by Clear()
         }
 
         /*!
@@ -266,12 +291,18 @@ namespace MxEngine
         }
 
         /*!
-        clears container. All constructed elements are destroyed
+        clears container. All constructed elements are destroyed. Generations of blocks are kept, so handles to destroyed elements
+        do not become valid again when pool grows
         */
         void Clear()
         {
+            for (size_t index = this->NextAllocated(0); index < this->Capacity(); index = this->NextAllocated(index + 1))
+            {
+                this->generations[index]++;
+            }
             this->allocator.~PoolAllocator();
             this->memoryStorage.clear();
+            this->allocationMask.clear();
             this->allocated = 0;
         }
 
@@ -282,7 +313,63 @@ namespace MxEngine
         */
         bool IsAllocated(size_t index) const
         {
-            return index < this->Capacity() && !GetBlockByIndex(index)->IsFree();
+            return index < this->Capacity() && (this->allocationMask[index / BitsPerMask] >> (index % BitsPerMask)) & 1;
+        }
+
+        /*!
+        gets generation of block. Generation is increased each time element in the block is destroyed
+        \param index index of element in vector Pool
+        \returns generation counter of block
+        */
+        uint32_t GetGeneration(size_t index) const
+        {
+            MX_ASSERT(index < this->generations.size());
+            return this->generations[index];
+        }
+
+        /*!
+        searches for first constructed element starting from index provided
+        \param index index of element to start search from (inclusive)
+        \returns index of constructed element or Capacity() if no elements found
+        */
+        size_t NextAllocated(size_t index) const
+        {
+            size_t capacity = this->Capacity();
+            if (index >= capacity) return capacity;
+
+            size_t word = index / BitsPerMask;
+            uint64_t mask = this->allocationMask[word] & (~(uint64_t)0 << (index % BitsPerMask));
+            while (mask == 0)
+            {
+                word++;
+                if (word == this->allocationMask.size()) return capacity;
+                mask = this->allocationMask[word];
+            }
+            size_t result = word * BitsPerMask + CountTrailingZeros(mask);
+            return result < capacity ? result : capacity;
+        }
+
+        /*!
+        searches for last constructed element before index provided
+        \param index index of element to start search from (inclusive)
+        \returns index of constructed element or InvalidIndex if no elements found
+        */
+        size_t PrevAllocated(size_t index) const
+        {
+            size_t capacity = this->Capacity();
+            if (capacity == 0 || index == InvalidIndex) return InvalidIndex;
+            if (index >= capacity) index = capacity - 1;
+
+            size_t word = index / BitsPerMask;
+            size_t shift = BitsPerMask - 1 - index % BitsPerMask;
+            uint64_t mask = this->allocationMask[word] & (~(uint64_t)0 >> shift);
+            while (mask == 0)
+            {
+                if (word == 0) return InvalidIndex;
+                word--;
+                mask = this->allocationMask[word];
+            }
+            return word * BitsPerMask + (BitsPerMask - 1 - CountLeadingZeros(mask));
         }
 
         /*!
@@ -295,6 +382,8 @@ namespace MxEngine
             {
                 T& ptr = GetBlockByIndex(index)->data;
                 allocator.Free(&ptr);
+                this->ResetAllocationBit(index);
+                this->generations[index]++;
                 this->allocated--;
             }
         }
@@ -319,8 +408,10 @@ namespace MxEngine
             }
 
             T* obj = allocator.Alloc(std::forward<Args>(args)...);
+            size_t index = this->IndexOf(*obj);
+            this->SetAllocationBit(index);
             this->allocated++;
-            return this->IndexOf(*obj);
+            return index;
         }
 
         /*!